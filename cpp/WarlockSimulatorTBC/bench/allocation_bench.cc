@@ -0,0 +1,79 @@
+// Counts the heap allocations that simulation iterations make once the player has been set up and a few iterations
+// have warmed up the containers that only grow, like the dps histogram. Casting, damage, procs and the scheduler
+// aren't meant to allocate at all, so any allocation here is reported and makes the program exit with 1.
+//
+// Usage: allocation_bench [--warmup N] [--iterations N] [profile...]
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench_fixture.h"
+
+namespace {
+std::atomic<long long> allocations = 0;
+}
+
+void* operator new(const std::size_t kSize) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void* memory = std::malloc(kSize == 0 ? 1 : kSize)) {
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+int main(const int argc, char* argv[]) {
+  try {
+    std::vector<std::string> profile_paths;
+    int warmup_iterations = 100;
+    int iterations = 1000;
+
+    for (int i = 1; i < argc; i++) {
+      if (const std::string kArgument = argv[i]; kArgument == "--warmup" && i + 1 < argc) {
+        warmup_iterations = std::stoi(argv[++i]);
+      } else if (kArgument == "--iterations" && i + 1 < argc) {
+        iterations = std::stoi(argv[++i]);
+      } else {
+        profile_paths.push_back(kArgument);
+      }
+    }
+
+    if (profile_paths.empty()) {
+      for (const auto& kProfileName :
+           {"destruction_fire", "destruction_shadow", "affliction_ua_sl", "demonology_felguard", "aoe_seed"}) {
+        profile_paths.push_back(std::string("cpp/WarlockSimulatorTBC/test/profiles/") + kProfileName + ".txt");
+      }
+    }
+
+    auto failed = false;
+
+    for (const auto& kProfilePath : profile_paths) {
+      const auto kBench = BenchSimulation(kProfilePath, warmup_iterations + iterations);
+      Simulation& simulation = *kBench.simulation;
+      simulation.RunIterations(0, warmup_iterations);
+
+      const long long kAllocationsBefore = allocations;
+      simulation.RunIterations(warmup_iterations, warmup_iterations + iterations);
+      const long long kAllocations = allocations - kAllocationsBefore;
+
+      std::cout << kProfilePath << ": " << kAllocations << " allocations in " << iterations << " iterations ("
+                << static_cast<double>(kAllocations) / iterations << " per iteration)" << std::endl;
+      failed = failed || kAllocations > 0;
+    }
+
+    return failed ? 1 : 0;
+  } catch (const std::exception& kException) {
+    std::cerr << "allocation_bench: " << kException.what() << std::endl;
+    return 2;
+  }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "../include/player.h"
+#include "../include/profile.h"
+#include "../include/simulation.h"
+#include "../include/stat.h"
+#include "../include/trinket.h"
+
+// A player and simulation set up from a profile the way the benchmarks run them: without the combat log, on one thread,
+// for all of kIterations iterations and with a fixed seed so that every run does the same work
+struct BenchSimulation {
+  Profile profile;
+  std::unique_ptr<Player> player;
+  std::unique_ptr<Simulation> simulation;
+
+  explicit BenchSimulation(const std::string& kProfilePath, const int kIterations = 1) {
+    auto file = std::ifstream(kProfilePath);
+
+    if (!file) {
+      throw std::runtime_error("couldn't open " + kProfilePath);
+    }
+
+    profile.Read(file);
+    profile.player_settings.equipped_item_simulation = false;
+    profile.simulation_settings.iterations = kIterations;
+    profile.simulation_settings.threads = 1;
+    profile.simulation_settings.target_standard_error = 0;
+    profile.Set("simulation", "seed", "1");
+
+    player = std::make_unique<Player>(profile.player_settings);
+    simulation = std::make_unique<Simulation>(*player, profile.simulation_settings);
+    player->Initialize(simulation.get());
+    simulation->ClearResults();
+  }
+
+  // Starts the first iteration's fight and casts kDecisions spells the way the main loop would, stopping where the
+  // player is free to cast
+  void StartFight(const int kFightLength, const int kDecisions) const {
+    player->rng.Seed(IterationSeed(profile.simulation_settings.seed, 0), profile.simulation_settings.rng_engine);
+    simulation->IterationReset(kFightLength);
+    const int kFightEnd = kFightLength * kTicksPerSecond;
+
+    for (int i = 0; i < kDecisions; i++) {
+      simulation->CastGcdSpells(TicksToSeconds(kFightEnd - simulation->current_tick));
+
+      while (simulation->current_tick < kFightEnd &&
+             (player->cast_timer.Remaining() > 0 || player->gcd_timer.Remaining() > 0)) {
+        simulation->PassTime(kFightEnd);
+      }
+    }
+  }
+};
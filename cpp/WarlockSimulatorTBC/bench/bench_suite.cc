@@ -0,0 +1,355 @@
+// Benchmarks the simulation's hot paths and whole simulations of the canonical profiles and compares the results to the
+// numbers in bench/baseline.txt, so that a commit that makes something slower shows up as a ratio below 1.
+//
+// Every result is also turned into a cost: how many operations of a reference workload that's measured in the same run
+// and doesn't use any of the simulator's code take as long as one of the result's. The costs are what the baseline
+// stores and what's compared, which leaves out most of how fast the machine is and how busy it is at the moment, but
+// not all of it, so the comparison is only a report: results that are more than the tolerance (0.15 by default) below
+// their baseline are marked as slower, but the program only exits with something other than 0 if it couldn't run.
+//
+// Micro benchmarks, on the player of the destruction_fire profile:
+//   spellCast      Spell::Cast() of the player's filler, with its damage, procs and auras, from a snapshot of a fight
+//                  in progress where the player is free to cast and has the mana for it, without the time that
+//                  restoring the snapshot takes
+//   dotTick        DamageOverTime::Tick() of the player's first dot, reapplied whenever it fades
+//   nextEventTime  Scheduler::NextEventTime() with the timers of a fight in progress (what the player's and pet's
+//                  FindTimeUntilNextAction() used to work out before the scheduler replaced it)
+//   castGcdSpells  Simulation::CastGcdSpells() from a snapshot of a fight in progress where the player is free to cast,
+//                  without the time that restoring the snapshot takes
+//   rngRoll        Rng::Roll() with the profile's rng engine
+// Macro benchmarks run the iterations of each canonical profile in test/profiles on one thread and report the
+// iterations and timer events per second. The events are counted in a pass over the same iterations before the timed
+// ones, so the timings don't include counting them.
+//
+// Every benchmark is run --repetitions times (3 by default) and the best result is kept.
+//
+// Usage: bench_suite [--micro | --macro] [--iterations N] [--operations N] [--repetitions N] [--baseline FILE]
+//                    [--update-baseline] [--tolerance X]
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../include/damage_over_time.h"
+#include "../include/simulation_snapshot.h"
+#include "../include/spell.h"
+#include "bench_fixture.h"
+
+namespace {
+const std::string kProfileDirectory = "cpp/WarlockSimulatorTBC/test/profiles/";
+const std::vector<std::string> kCanonicalProfiles = {"destruction_fire", "destruction_shadow", "affliction_ua_sl",
+                                                     "demonology_felguard", "aoe_seed"};
+constexpr int kFightLength = 180;
+
+// Keeps the benchmarked calls' results alive so that the compiler can't drop them
+volatile double result_sink = 0;
+
+struct BenchResult {
+  std::string name;
+  double value;
+  std::string unit;
+};
+
+// The canonical profile's benchmark fixture
+BenchSimulation CanonicalBenchSimulation(const std::string& kProfileName, const int kIterations) {
+  return BenchSimulation(kProfileDirectory + kProfileName + ".txt", kIterations);
+}
+
+// Every benchmark is measured this many times and the best result is kept, since anything else running on the
+// machine only ever makes it slower
+int repetitions = 3;
+
+template <typename TFunction>
+double Best(TFunction measure) {
+  double best = 0;
+
+  for (int i = 0; i < repetitions; i++) {
+    best = std::max(best, measure());
+  }
+
+  return best;
+}
+
+// Calls operation() kOperations times and returns how many calls it made per second, the best of the repetitions
+template <typename TFunction>
+double OperationsPerSecond(const int kOperations, TFunction operation) {
+  return Best([&] {
+    double sum = 0;
+    const auto kStart = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < kOperations; i++) {
+      sum += operation();
+    }
+
+    const auto kEnd = std::chrono::high_resolution_clock::now();
+    result_sink = result_sink + sum;
+    return kOperations / std::chrono::duration<double>(kEnd - kStart).count();
+  });
+}
+
+// How often per second operation() can run from the fight in kSnapshot, which is restored before every call, without
+// the time that restoring it takes. The rng carries on from call to call so that the rolls still differ between them.
+template <typename TFunction>
+double OperationsFromSnapshotPerSecond(const int kOperations, const BenchSimulation& kBench,
+                                       const SimulationSnapshot& kSnapshot, TFunction operation) {
+  Rng& player_rng = kBench.player->rng;
+  Rng rng = player_rng;
+
+  const double kRestoresPerSecond = OperationsPerSecond(kOperations, [&] {
+    kBench.simulation->RestoreSnapshot(kSnapshot);
+    player_rng = rng;
+    rng = player_rng;
+    return 0.0;
+  });
+  const double kRestoresAndOperationsPerSecond = OperationsPerSecond(kOperations, [&] {
+    kBench.simulation->RestoreSnapshot(kSnapshot);
+    player_rng = rng;
+    operation();
+    rng = player_rng;
+    return 0.0;
+  });
+
+  return 1 / (1 / kRestoresAndOperationsPerSecond - 1 / kRestoresPerSecond);
+}
+
+// A fixed mix of integer and floating point arithmetic with a dependency chain like the simulation's, in operations per
+// second
+double MeasureReferenceWorkload(const int kOperations) {
+  uint64_t state = 1;
+
+  return OperationsPerSecond(kOperations, [&] {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<double>(state >> 11) * 0x1.0p-53 * 1.0001 + static_cast<double>(state % 7);
+  });
+}
+
+std::vector<BenchResult> RunMicroBenchmarks(const int kOperations) {
+  std::vector<BenchResult> results;
+
+  {
+    const auto kBench = CanonicalBenchSimulation(kCanonicalProfiles[0], 1);
+    kBench.StartFight(kFightLength, 20);
+    Spell& filler = *kBench.player->filler;
+
+    if (!filler.HasEnoughMana()) {
+      throw std::runtime_error(kCanonicalProfiles[0] + " is out of mana for its filler");
+    }
+
+    auto snapshot = SimulationSnapshot();
+    kBench.simulation->SaveSnapshot(snapshot);
+    results.push_back({"spellCast", OperationsFromSnapshotPerSecond(kOperations / 10, kBench, snapshot, [&] {
+                         filler.Cast();
+                       }), "casts/s"});
+  }
+
+  {
+    const auto kBench = CanonicalBenchSimulation(kCanonicalProfiles[0], 1);
+    kBench.StartFight(kFightLength, 0);
+
+    if (kBench.player->dot_list.empty()) {
+      throw std::runtime_error(kCanonicalProfiles[0] + " has no dots");
+    }
+
+    DamageOverTime& dot = *kBench.player->dot_list.front();
+    results.push_back({"dotTick", OperationsPerSecond(kOperations, [&] {
+                         if (!dot.active) {
+                           dot.Apply();
+                         }
+
+                         dot.Tick();
+                         return 0.0;
+                       }), "ticks/s"});
+  }
+
+  {
+    const auto kBench = CanonicalBenchSimulation(kCanonicalProfiles[0], 1);
+    kBench.StartFight(kFightLength, 20);
+    const Scheduler& kScheduler = kBench.simulation->scheduler;
+    results.push_back({"nextEventTime", OperationsPerSecond(kOperations, [&] {
+                         return static_cast<double>(kScheduler.NextEventTime());
+                       }), "lookups/s"});
+  }
+
+  {
+    const auto kBench = CanonicalBenchSimulation(kCanonicalProfiles[0], 1);
+    kBench.StartFight(kFightLength, 20);
+    auto snapshot = SimulationSnapshot();
+    kBench.simulation->SaveSnapshot(snapshot);
+    const double kFightTimeRemaining = kFightLength - kBench.simulation->GetCurrentFightTime();
+    results.push_back({"castGcdSpells", OperationsFromSnapshotPerSecond(kOperations / 10, kBench, snapshot, [&] {
+                         kBench.simulation->CastGcdSpells(kFightTimeRemaining);
+                       }), "decisions/s"});
+  }
+
+  {
+    const auto kBench = CanonicalBenchSimulation(kCanonicalProfiles[0], 1);
+    Rng& rng = kBench.player->rng;
+    rng.Seed(1, kBench.profile.simulation_settings.rng_engine);
+    const uint64_t kThreshold = Rng::ChanceToThreshold(25);
+    results.push_back({"rngRoll", OperationsPerSecond(kOperations, [&] {
+                         return rng.Roll(kThreshold) ? 1.0 : 0.0;
+                       }), "rolls/s"});
+  }
+
+  return results;
+}
+
+std::vector<BenchResult> RunMacroBenchmarks(const int kIterations) {
+  std::vector<BenchResult> results;
+  // Fills the caches and the containers that only grow before the measured iterations
+  constexpr int kWarmupIterations = 50;
+
+  for (const auto& kProfileName : kCanonicalProfiles) {
+    const auto kBench = CanonicalBenchSimulation(kProfileName, kWarmupIterations + kIterations);
+    Simulation& simulation = *kBench.simulation;
+    simulation.RunIterations(0, kWarmupIterations);
+
+    // An iteration's outcome only depends on its index, so this pass handles the same events as the timed ones
+    long long events = 0;
+
+    for (int i = kWarmupIterations; i < kWarmupIterations + kIterations; i++) {
+      const int kFightLength = simulation.StartIteration(i);
+      const int kFightEnd = kFightLength * kTicksPerSecond;
+      simulation.RunFight(kFightEnd, kFightEnd, [] {}, [&](const Timer&) { events++; });
+      simulation.IterationEnd(kFightLength, kBench.player->iteration_damage / kFightLength);
+    }
+
+    const double kIterationsPerSecond = Best([&] {
+      const auto kStart = std::chrono::high_resolution_clock::now();
+      simulation.RunIterations(kWarmupIterations, kWarmupIterations + kIterations);
+      const auto kEnd = std::chrono::high_resolution_clock::now();
+      return kIterations / std::chrono::duration<double>(kEnd - kStart).count();
+    });
+
+    results.push_back({kProfileName + ".iterations", kIterationsPerSecond, "iterations/s"});
+    results.push_back(
+        {kProfileName + ".events", kIterationsPerSecond * static_cast<double>(events) / kIterations, "events/s"});
+  }
+
+  return results;
+}
+
+// "name = value" lines like a profile's, '#' starts a comment
+std::map<std::string, double> ReadBaseline(const std::string& kPath) {
+  std::map<std::string, double> baseline;
+  auto file = std::ifstream(kPath);
+  std::string line;
+
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    if (const auto kSeparator = line.find(" = "); kSeparator != std::string::npos) {
+      baseline[line.substr(0, kSeparator)] = std::stod(line.substr(kSeparator + 3));
+    }
+  }
+
+  return baseline;
+}
+
+void WriteBaseline(const std::string& kPath, const std::vector<BenchResult>& kResults,
+                   const double kReferencePerSecond) {
+  auto file = std::ofstream(kPath);
+
+  if (!file) {
+    throw std::runtime_error("couldn't write " + kPath);
+  }
+
+  file << "# Costs of bench_suite's (make bench) results in operations of its reference workload, written with"
+       << std::endl << "# bench_suite --update-baseline" << std::endl;
+
+  for (const auto& kResult : kResults) {
+    file << kResult.name << " = " << std::setprecision(6) << kReferencePerSecond / kResult.value << std::endl;
+  }
+}
+}
+
+int main(const int argc, char* argv[]) {
+  try {
+    std::string baseline_path = "cpp/WarlockSimulatorTBC/bench/baseline.txt";
+    int iterations = 1000;
+    int operations = 1000000;
+    double tolerance = 0.15;
+    bool micro = true;
+    bool macro = true;
+    bool update_baseline = false;
+
+    for (int i = 1; i < argc; i++) {
+      if (const std::string kArgument = argv[i]; kArgument == "--micro") {
+        macro = false;
+      } else if (kArgument == "--macro") {
+        micro = false;
+      } else if (kArgument == "--update-baseline") {
+        update_baseline = true;
+      } else if (kArgument == "--iterations" && i + 1 < argc) {
+        iterations = std::stoi(argv[++i]);
+      } else if (kArgument == "--operations" && i + 1 < argc) {
+        operations = std::stoi(argv[++i]);
+      } else if (kArgument == "--baseline" && i + 1 < argc) {
+        baseline_path = argv[++i];
+      } else if (kArgument == "--repetitions" && i + 1 < argc) {
+        repetitions = std::max(1, std::stoi(argv[++i]));
+      } else if (kArgument == "--tolerance" && i + 1 < argc) {
+        tolerance = std::stod(argv[++i]);
+      } else {
+        throw std::invalid_argument("unknown argument " + kArgument);
+      }
+    }
+
+    const double kReferencePerSecond = MeasureReferenceWorkload(operations * 10);
+    std::cout << std::left << std::setw(32) << "reference" << std::right << std::setw(14)
+        << static_cast<long long>(kReferencePerSecond) << " operations/s" << std::endl;
+
+    std::vector<BenchResult> results;
+
+    if (micro) {
+      results = RunMicroBenchmarks(operations);
+    }
+
+    if (macro) {
+      const auto kMacroResults = RunMacroBenchmarks(iterations);
+      results.insert(results.end(), kMacroResults.begin(), kMacroResults.end());
+    }
+
+    const auto kBaseline = ReadBaseline(baseline_path);
+
+    for (const auto& kResult : results) {
+      const double kCost = kReferencePerSecond / kResult.value;
+      std::cout << std::left << std::setw(32) << kResult.name << std::right << std::setw(14)
+          << static_cast<long long>(kResult.value) << " " << std::left << std::setw(14) << kResult.unit
+          << "cost " << std::right << std::setw(10) << std::setprecision(4) << kCost;
+
+      if (const auto kIt = kBaseline.find(kResult.name); kIt != kBaseline.end() && kIt->second > 0) {
+        // Above 1 is faster, like the results themselves
+        const double kRatio = kIt->second / kCost;
+        std::cout << "  baseline " << std::setw(10) << kIt->second << "  " << std::fixed << std::setprecision(2)
+            << kRatio << "x" << std::defaultfloat;
+
+        if (kRatio < 1 - tolerance) {
+          std::cout << "  slower";
+        }
+      }
+
+      std::cout << std::endl;
+    }
+
+    if (update_baseline) {
+      WriteBaseline(baseline_path, results, kReferencePerSecond);
+      std::cout << "wrote " << baseline_path << std::endl;
+    }
+
+    return 0;
+  } catch (const std::exception& kError) {
+    std::cerr << "bench_suite: " << kError.what() << std::endl;
+    return 2;
+  }
+}
@@ -0,0 +1,122 @@
+// Measures how many GCD decisions per second the spell candidate scoring in Simulation::CastGcdSpells() can make, once
+// with a std::map<Spell*, double> like the one that it used to build on every decision and once with the
+// SpellCandidates array that replaced it. Both score the same spells with the same predicted damage so only the
+// container differs. The spells' PredictDamage() isn't part of the measurement since both versions call it equally.
+//
+// Usage: gcd_decision_bench [--decisions N] [profile]
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../include/spell.h"
+#include "bench_fixture.h"
+
+namespace {
+template <typename TFunction>
+double DecisionsPerSecond(const int kDecisions, TFunction decide) {
+  const auto kStart = std::chrono::high_resolution_clock::now();
+
+  for (int i = 0; i < kDecisions; i++) {
+    decide(i);
+  }
+
+  const auto kEnd = std::chrono::high_resolution_clock::now();
+  return kDecisions / std::chrono::duration<double>(kEnd - kStart).count();
+}
+}
+
+int main(const int argc, char* argv[]) {
+  try {
+    std::string profile_path = "cpp/WarlockSimulatorTBC/test/profiles/destruction_fire.txt";
+    int decisions = 5000000;
+
+    for (int i = 1; i < argc; i++) {
+      if (const std::string kArgument = argv[i]; kArgument == "--decisions" && i + 1 < argc) {
+        decisions = std::stoi(argv[++i]);
+      } else {
+        profile_path = kArgument;
+      }
+    }
+
+    const auto kBench = BenchSimulation(profile_path);
+    Player& player = *kBench.player;
+    player.Reset();
+
+    // Every spell that CastGcdSpells() can score that this profile has
+    std::vector<Spell*> spells;
+    for (const auto& kSpell : {player.spells.shadow_bolt, player.spells.incinerate, player.spells.searing_pain,
+                               player.spells.conflagrate, player.spells.shadowburn, player.spells.death_coil,
+                               player.spells.curse_of_doom, player.spells.curse_of_agony, player.spells.corruption,
+                               player.spells.unstable_affliction, player.spells.siphon_life, player.spells.immolate,
+                               player.spells.shadowfury}) {
+      if (kSpell != nullptr) {
+        spells.push_back(kSpell);
+      }
+    }
+
+    std::vector<double> predicted_damage;
+    for (const auto& kSpell : spells) {
+      predicted_damage.push_back(kSpell->PredictDamage());
+    }
+
+    const auto kSpellAmount = static_cast<int>(spells.size());
+    Spell* chosen_spell = nullptr;
+    auto chosen_spells = 0ULL;
+
+    const double kMapDecisions = DecisionsPerSecond(decisions, [&](const int kDecision) {
+      std::map<Spell*, double> predicted_damage_of_spells;
+
+      for (int i = 0; i < kSpellAmount; i++) {
+        // Vary the damage a bit so the best spell changes between decisions
+        predicted_damage_of_spells.insert({spells[i], predicted_damage[i] + (kDecision + i) % kSpellAmount});
+      }
+
+      auto max_damage_spell_value = 0.0;
+      for (const auto& [kSpell, kDamage] : predicted_damage_of_spells) {
+        if (kDamage > max_damage_spell_value) {
+          chosen_spell = kSpell;
+          max_damage_spell_value = kDamage;
+        }
+      }
+
+      chosen_spells += reinterpret_cast<uintptr_t>(chosen_spell) >> 4;
+    });
+
+    const double kArrayDecisions = DecisionsPerSecond(decisions, [&](const int kDecision) {
+      SpellCandidates candidates;
+
+      for (int i = 0; i < kSpellAmount; i++) {
+        if (!candidates.Contains(spells[i])) {
+          candidates.Add(spells[i], predicted_damage[i] + (kDecision + i) % kSpellAmount);
+        }
+      }
+
+      auto max_damage_spell_value = 0.0;
+      for (int i = 0; i < candidates.size; i++) {
+        if (candidates.predicted_damage[i] > max_damage_spell_value) {
+          chosen_spell = candidates.spells[i];
+          max_damage_spell_value = candidates.predicted_damage[i];
+        }
+      }
+
+      chosen_spells += reinterpret_cast<uintptr_t>(chosen_spell) >> 4;
+    });
+
+    std::cout << "candidates: " << kSpellAmount << ", decisions: " << decisions << " (checksum " << chosen_spells
+        << ")" << std::endl;
+    std::cout << "std::map<Spell*, double>: " << static_cast<long long>(kMapDecisions)
+        << " decisions/s" << std::endl;
+    std::cout << "SpellCandidates: " << static_cast<long long>(kArrayDecisions) << " decisions/s ("
+        << kArrayDecisions / kMapDecisions << "x)" << std::endl;
+  } catch (const std::exception& kError) {
+    std::cerr << "gcd_decision_bench: " << kError.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
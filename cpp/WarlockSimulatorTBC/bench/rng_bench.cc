@@ -0,0 +1,65 @@
+// Measures how many rolls per second each RngEngine can make through Rng::Roll(), the integer-threshold compare that
+// Player::RollRng() uses for every hit, crit and proc roll, next to the std::mt19937 + std::uniform_real_distribution
+// + floor() roll that RollRng() used to make.
+//
+// Usage: rng_bench [--rolls N]
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "../include/rng.h"
+
+namespace {
+template <typename TFunction>
+double RollsPerSecond(const int kRolls, TFunction roll) {
+  auto hits = 0LL;
+  const auto kStart = std::chrono::high_resolution_clock::now();
+
+  for (int i = 0; i < kRolls; i++) {
+    hits += roll();
+  }
+
+  const auto kEnd = std::chrono::high_resolution_clock::now();
+  // Printing the hit rate keeps the rolls from being optimized away and shows that every engine rolls the same chance
+  std::cout << " (hit rate " << static_cast<double>(hits) / kRolls << ")";
+  return kRolls / std::chrono::duration<double>(kEnd - kStart).count();
+}
+}
+
+int main(const int argc, char* argv[]) {
+  int rolls = 100000000;
+  constexpr double kChance = 83.5;
+
+  for (int i = 1; i < argc; i++) {
+    if (const std::string kArgument = argv[i]; kArgument == "--rolls" && i + 1 < argc) {
+      rolls = std::stoi(argv[++i]);
+    }
+  }
+
+  std::cout << "rolls: " << rolls << ", chance: " << kChance << "%" << std::endl;
+
+  auto mersenne_twister = std::mt19937(1234);
+  auto uniform_distribution = std::uniform_real_distribution<double>(0, 1);
+  std::cout << "std::mt19937 + uniform_real_distribution";
+  const double kOldRolls = RollsPerSecond(rolls, [&] {
+    return static_cast<int>(floor(uniform_distribution(mersenne_twister) * 100001)) <= kChance * 1000;
+  });
+  std::cout << ": " << static_cast<long long>(kOldRolls) << " rolls/s" << std::endl;
+
+  for (const auto& [kName, kEngine] : {std::pair{"xoshiro256PlusPlus", RngEngine::kXoshiro256PlusPlus},
+                                       std::pair{"mersenneTwister", RngEngine::kMersenneTwister},
+                                       std::pair{"pcg32", RngEngine::kPcg32},
+                                       std::pair{"philox", RngEngine::kPhilox}}) {
+    auto rng = Rng();
+    rng.Seed(1234, kEngine);
+    std::cout << kName;
+    const double kRolls = RollsPerSecond(rolls, [&] { return rng.Roll(Rng::ChanceToThreshold(kChance)); });
+    std::cout << ": " << static_cast<long long>(kRolls) << " rolls/s (" << kRolls / kOldRolls << "x)" << std::endl;
+  }
+
+  return 0;
+}
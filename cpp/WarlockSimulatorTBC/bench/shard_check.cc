@@ -0,0 +1,104 @@
+// Checks that an iteration's outcome only depends on the simulation's seed and the iteration's index, so that the
+// iterations can be split between threads or processes without changing the results. Every profile is run serially
+// for all of its iterations once, then a few ranges of them are run on their own by simulations set up from the same
+// profile, one of them split between threads. Each iteration's dps has to be identical to the serial run's, any
+// iteration where it isn't is reported and makes the program exit with 1.
+//
+// Usage: shard_check [--iterations N] [profile...]
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench_fixture.h"
+
+namespace {
+struct Shard {
+  int first_iteration;
+  int last_iteration;
+  int threads;
+};
+}  // namespace
+
+// Runs the iterations from kFirstIteration up to kLastIteration on a simulation of their own and returns their dps
+std::vector<double> RunShard(const std::string& kProfilePath, const int kIterations, const Shard& kShard) {
+  const auto kBench = BenchSimulation(kProfilePath, kIterations);
+  kBench.simulation->keep_dps_values = true;
+
+  if (kShard.threads > 1) {
+    kBench.simulation->RunIterationsInParallel(kShard.first_iteration, kShard.last_iteration, kShard.threads);
+  } else {
+    kBench.simulation->RunIterations(kShard.first_iteration, kShard.last_iteration);
+  }
+
+  return kBench.simulation->dps_values;
+}
+
+int main(const int argc, char* argv[]) {
+  try {
+    std::vector<std::string> profile_paths;
+    int iterations = 300;
+
+    for (int i = 1; i < argc; i++) {
+      if (const std::string kArgument = argv[i]; kArgument == "--iterations" && i + 1 < argc) {
+        iterations = std::stoi(argv[++i]);
+      } else {
+        profile_paths.push_back(kArgument);
+      }
+    }
+
+    if (iterations < 3) {
+      throw std::invalid_argument("--iterations has to be at least 3");
+    }
+
+    if (profile_paths.empty()) {
+      for (const auto& kProfileName :
+           {"destruction_fire", "destruction_shadow", "affliction_ua_sl", "demonology_felguard", "aoe_seed"}) {
+        profile_paths.push_back(std::string("cpp/WarlockSimulatorTBC/test/profiles/") + kProfileName + ".txt");
+      }
+    }
+
+    // A range in the middle, the last iterations, a single iteration and a range that's split between threads
+    const std::vector<Shard> kShards = {{iterations / 3, iterations * 2 / 3, 1},
+                                        {std::max(0, iterations - 7), iterations, 1},
+                                        {iterations / 2, iterations / 2 + 1, 1},
+                                        {1, iterations - 1, 3}};
+    auto failed = false;
+
+    for (const auto& kProfilePath : profile_paths) {
+      const std::vector<double> kSerialDps = RunShard(kProfilePath, iterations, {0, iterations, 1});
+      int mismatches = 0;
+
+      for (const auto& kShard : kShards) {
+        const std::vector<double> kShardDps = RunShard(kProfilePath, iterations, kShard);
+
+        if (static_cast<int>(kShardDps.size()) != kShard.last_iteration - kShard.first_iteration) {
+          std::cout << kProfilePath << ": iterations " << kShard.first_iteration << " to " << kShard.last_iteration
+                    << " returned " << kShardDps.size() << " dps values" << std::endl;
+          mismatches++;
+          continue;
+        }
+
+        for (int i = 0; i < static_cast<int>(kShardDps.size()); i++) {
+          if (const int kIteration = kShard.first_iteration + i; kShardDps[i] != kSerialDps[kIteration]) {
+            std::cout << kProfilePath << ": iteration " << kIteration << " did " << kShardDps[i] << " dps in iterations "
+                      << kShard.first_iteration << " to " << kShard.last_iteration << " on " << kShard.threads
+                      << " thread(s) and " << kSerialDps[kIteration] << " in the serial run" << std::endl;
+            mismatches++;
+          }
+        }
+      }
+
+      std::cout << kProfilePath << ": " << mismatches << " mismatches in " << kShards.size() << " ranges of "
+                << iterations << " iterations" << std::endl;
+      failed = failed || mismatches > 0;
+    }
+
+    return failed ? 1 : 0;
+  } catch (const std::exception& kException) {
+    std::cerr << "shard_check: " << kException.what() << std::endl;
+    return 2;
+  }
+}
@@ -0,0 +1,87 @@
+// Checks that a simulation snapshot captures everything the rest of a fight depends on. Every iteration saves a
+// snapshot part of the way into its fight and finishes the fight, then restores the snapshot into the same simulation
+// and into a second one that was set up from the same profile and finishes the fight again in both. The damage done
+// after the snapshot has to be identical all three times, any iteration where it isn't is reported and makes the
+// program exit with 1.
+//
+// Usage: snapshot_check [--iterations N] [profile...]
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../include/simulation_snapshot.h"
+#include "bench_fixture.h"
+
+// Finishes the fight from wherever the simulation is and returns the damage done from kStartDamage onwards
+double FinishFight(const BenchSimulation& kBench, const int kFightEnd, const double kStartDamage) {
+  kBench.simulation->RunFight(kFightEnd, kFightEnd);
+  return kBench.player->iteration_damage - kStartDamage;
+}
+
+int main(const int argc, char* argv[]) {
+  try {
+    std::vector<std::string> profile_paths;
+    int iterations = 200;
+
+    for (int i = 1; i < argc; i++) {
+      if (const std::string kArgument = argv[i]; kArgument == "--iterations" && i + 1 < argc) {
+        iterations = std::stoi(argv[++i]);
+      } else {
+        profile_paths.push_back(kArgument);
+      }
+    }
+
+    if (profile_paths.empty()) {
+      for (const auto& kProfileName :
+           {"destruction_fire", "destruction_shadow", "affliction_ua_sl", "demonology_felguard", "aoe_seed"}) {
+        profile_paths.push_back(std::string("cpp/WarlockSimulatorTBC/test/profiles/") + kProfileName + ".txt");
+      }
+    }
+
+    auto failed = false;
+    auto snapshot = SimulationSnapshot();
+
+    for (const auto& kProfilePath : profile_paths) {
+      const auto kBench = BenchSimulation(kProfilePath, iterations);
+      const auto kRestoredBench = BenchSimulation(kProfilePath, iterations);
+      int mismatches = 0;
+
+      for (int iteration = 0; iteration < iterations; iteration++) {
+        const int kFightLength = kBench.simulation->StartIteration(iteration);
+        const int kFightEnd = kFightLength * kTicksPerSecond;
+        kRestoredBench.simulation->StartIteration(iteration);
+
+        // Spread the snapshots over the fight, from its first ninth to its end
+        kBench.simulation->RunFight(kFightEnd, kFightEnd * (iteration % 9 + 1) / 9);
+        kBench.simulation->SaveSnapshot(snapshot);
+        const double kSnapshotDamage = kBench.player->iteration_damage;
+
+        const double kDamage = FinishFight(kBench, kFightEnd, kSnapshotDamage);
+        kBench.simulation->RestoreSnapshot(snapshot);
+        const double kRestoredDamage = FinishFight(kBench, kFightEnd, kSnapshotDamage);
+        kRestoredBench.simulation->RestoreSnapshot(snapshot);
+        const double kOtherRestoredDamage = FinishFight(kRestoredBench, kFightEnd, kSnapshotDamage);
+
+        if (kRestoredDamage != kDamage || kOtherRestoredDamage != kDamage) {
+          std::cout << kProfilePath << ": iteration " << iteration << " did " << kDamage
+                    << " damage after the snapshot, " << kRestoredDamage << " after restoring it and "
+                    << kOtherRestoredDamage << " after restoring it into another simulation" << std::endl;
+          mismatches++;
+        }
+
+        kBench.simulation->IterationEnd(kFightLength, kBench.player->iteration_damage / kFightLength);
+        kRestoredBench.simulation->IterationEnd(kFightLength, kRestoredBench.player->iteration_damage / kFightLength);
+      }
+
+      std::cout << kProfilePath << ": " << mismatches << " mismatches in " << iterations << " iterations" << std::endl;
+      failed = failed || mismatches > 0;
+    }
+
+    return failed ? 1 : 0;
+  } catch (const std::exception& kException) {
+    std::cerr << "snapshot_check: " << kException.what() << std::endl;
+    return 2;
+  }
+}
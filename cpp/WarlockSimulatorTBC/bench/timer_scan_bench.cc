@@ -0,0 +1,247 @@
+// Measures how many timer events per second the Scheduler can hand out, once with a copy of the binary heap of events
+// that it used to be and once with the Scheduler's wake_times array. The timer operations are recorded from whole
+// iterations of a profile's simulation, by comparing the scheduler's wake_times before and after every step of the main
+// loop and every event, and then replayed into both. A restarted or stopped timer shows up as a changed slot, so the
+// stream is a lower bound of what the heap had to push in the simulation itself (a timer that was stopped and started
+// again at the same end isn't in it). A checksum of the popped slots and times shows that both hand out the events in
+// the same order.
+//
+// Usage: timer_scan_bench [--iterations N] [--repetitions N] [profile]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench_fixture.h"
+
+
+namespace {
+// The scheduler before it was turned into arrays: every Schedule() pushes an event and restarting or stopping a timer
+// leaves its old event in the heap with an outdated version until it reaches the top
+struct HeapScheduler {
+  struct Event {
+    int time;
+    int order;
+    int slot;
+    uint32_t version;
+  };
+
+  std::vector<Event> events;
+  std::vector<uint32_t> versions; // By slot
+
+  static bool IsLater(const Event& kFirst, const Event& kSecond) {
+    if (kFirst.time != kSecond.time) {
+      return kFirst.time > kSecond.time;
+    }
+
+    return kFirst.order != kSecond.order ? kFirst.order > kSecond.order : kFirst.slot > kSecond.slot;
+  }
+
+  void Schedule(const int kSlot, const int kTime, const int kOrder) {
+    events.push_back({kTime, kOrder, kSlot, ++versions[kSlot]});
+    std::push_heap(events.begin(), events.end(), IsLater);
+  }
+
+  void Cancel(const int kSlot) { versions[kSlot]++; }
+
+  int NextEventTime() {
+    DiscardStaleEvents();
+    return events.empty() ? std::numeric_limits<int>::max() : events.front().time;
+  }
+
+  int PopEvent() {
+    DiscardStaleEvents();
+    std::pop_heap(events.begin(), events.end(), IsLater);
+    const int kSlot = events.back().slot;
+    events.pop_back();
+    return kSlot;
+  }
+
+  void DiscardStaleEvents() {
+    while (!events.empty() && events.front().version != versions[events.front().slot]) {
+      std::pop_heap(events.begin(), events.end(), IsLater);
+      events.pop_back();
+    }
+  }
+};
+
+struct Operation {
+  enum Type : uint8_t { kSchedule, kCancel, kPop, kPassEnd } type;
+  int slot; // kSchedule and kCancel
+  int time; // kSchedule and kPop
+  int order; // kSchedule
+};
+
+// Appends the slots whose wake time changed since kPrevious as kSchedule and kCancel operations and updates kPrevious
+void RecordChanges(const Scheduler& kScheduler, std::vector<int>& previous, std::vector<Operation>& operations) {
+  for (int slot = 0; slot < static_cast<int>(previous.size()); slot++) {
+    if (const int kWakeTime = kScheduler.wake_times[slot]; kWakeTime != previous[slot]) {
+      if (kWakeTime == Scheduler::kNotWaiting) {
+        operations.push_back({Operation::kCancel, slot, 0, 0});
+      } else {
+        operations.push_back({Operation::kSchedule, slot, kWakeTime, kScheduler.orders[slot]});
+      }
+
+      previous[slot] = kWakeTime;
+    }
+  }
+}
+
+// Runs kIterations iterations with the simulation's main loop and records every step's changes, every event and what
+// handling it changed. The casts don't move the fight on, so a step's pass ends at the tick the next step starts at.
+std::vector<Operation> RecordOperations(Simulation& simulation, const int kIterations) {
+  std::vector<Operation> operations;
+  std::vector<int> previous = simulation.scheduler.wake_times;
+
+  for (int iteration = 0; iteration < kIterations; iteration++) {
+    const int kFightEnd = simulation.StartIteration(iteration) * kTicksPerSecond;
+    RecordChanges(simulation.scheduler, previous, operations);
+    bool passed = false;
+
+    simulation.RunFight(
+        kFightEnd, kFightEnd,
+        [&] {
+          if (passed) {
+            operations.push_back({Operation::kPassEnd, 0, simulation.current_tick, 0});
+          }
+
+          RecordChanges(simulation.scheduler, previous, operations);
+          passed = true;
+        },
+        [&](const Timer& kTimer) {
+          operations.push_back({Operation::kPop, kTimer.slot, simulation.current_tick, 0});
+          previous[kTimer.slot] = Scheduler::kNotWaiting;
+          RecordChanges(simulation.scheduler, previous, operations);
+        });
+
+    operations.push_back({Operation::kPassEnd, 0, simulation.current_tick, 0});
+  }
+
+  return operations;
+}
+
+struct Result {
+  double events_per_second;
+  uint64_t checksum;
+};
+
+// Replays the operations kRepetitions times. schedule(slot, time, order) starts a timer, cancel(slot) stops one,
+// next_event_time() returns when the next one runs out and pop(time) returns the slot of the next one that runs out at
+// or before time, or -1 if there's none. Like Simulation::PassTime() every pass asks for the next event time once and
+// then pops until there's nothing left.
+template <typename TSchedule, typename TCancel, typename TNextEventTime, typename TPop>
+Result Replay(const std::vector<Operation>& kOperations, const int kRepetitions, TSchedule schedule, TCancel cancel,
+              TNextEventTime next_event_time, TPop pop) {
+  uint64_t checksum = 0;
+  uint64_t events = 0;
+  const auto kStart = std::chrono::high_resolution_clock::now();
+
+  for (int repetition = 0; repetition < kRepetitions; repetition++) {
+    bool passing = false;
+
+    for (const auto& kOperation : kOperations) {
+      switch (kOperation.type) {
+        case Operation::kSchedule:
+          schedule(kOperation.slot, kOperation.time, kOperation.order);
+          break;
+        case Operation::kCancel:
+          cancel(kOperation.slot);
+          break;
+        case Operation::kPop:
+          if (!passing) {
+            checksum += static_cast<uint64_t>(next_event_time());
+            passing = true;
+          }
+
+          checksum = checksum * 31 + static_cast<uint64_t>(pop(kOperation.time)) * 100003 + kOperation.time;
+          events++;
+          break;
+        case Operation::kPassEnd:
+          if (!passing) {
+            checksum += static_cast<uint64_t>(next_event_time());
+          }
+
+          checksum = checksum * 31 + static_cast<uint64_t>(pop(kOperation.time) + 1);
+          passing = false;
+          break;
+      }
+    }
+  }
+
+  const auto kEnd = std::chrono::high_resolution_clock::now();
+  return {static_cast<double>(events) / std::chrono::duration<double>(kEnd - kStart).count(), checksum};
+}
+}
+
+int main(const int argc, char* argv[]) {
+  try {
+    std::string profile_path = "cpp/WarlockSimulatorTBC/test/profiles/destruction_fire.txt";
+    int iterations = 200;
+    int repetitions = 20;
+
+    for (int i = 1; i < argc; i++) {
+      if (const std::string kArgument = argv[i]; kArgument == "--iterations" && i + 1 < argc) {
+        iterations = std::stoi(argv[++i]);
+      } else if (kArgument == "--repetitions" && i + 1 < argc) {
+        repetitions = std::stoi(argv[++i]);
+      } else {
+        profile_path = kArgument;
+      }
+    }
+
+    const auto kBench = BenchSimulation(profile_path, iterations);
+    Simulation& simulation = *kBench.simulation;
+
+    auto& scheduler = simulation.scheduler;
+    const auto kTimers = static_cast<int>(scheduler.timers.size());
+    const std::vector<Operation> kOperations = RecordOperations(simulation, iterations);
+
+    auto heap = HeapScheduler();
+    heap.versions.resize(kTimers);
+
+    const Result kHeapResult = Replay(
+        kOperations, repetitions,
+        [&](const int kSlot, const int kTime, const int kOrder) { heap.Schedule(kSlot, kTime, kOrder); },
+        [&](const int kSlot) { heap.Cancel(kSlot); },
+        [&] { return heap.NextEventTime(); },
+        [&](const int kTime) { return heap.NextEventTime() <= kTime ? heap.PopEvent() : -1; });
+
+    scheduler.Clear();
+
+    const Result kArrayResult = Replay(
+        kOperations, repetitions,
+        [&](const int kSlot, const int kTime, const int kOrder) {
+          scheduler.wake_times[kSlot] = kTime;
+          scheduler.orders[kSlot] = kOrder;
+        },
+        [&](const int kSlot) { scheduler.Cancel(*scheduler.timers[kSlot]); },
+        [&] { return scheduler.NextEventTime(); },
+        [&](const int kTime) {
+          const Timer* kTimer = scheduler.PopEvent(kTime);
+          return kTimer != nullptr ? kTimer->slot : -1;
+        });
+
+    std::cout << "timers: " << kTimers << " (" << scheduler.wake_times.size() << " slots), operations: "
+        << kOperations.size() << " from " << iterations << " iterations" << std::endl;
+    std::cout << "binary heap: " << static_cast<long long>(kHeapResult.events_per_second) << " events/s (checksum "
+        << kHeapResult.checksum << ")" << std::endl;
+    std::cout << "wake_times array: " << static_cast<long long>(kArrayResult.events_per_second)
+        << " events/s (checksum " << kArrayResult.checksum << ", "
+        << kArrayResult.events_per_second / kHeapResult.events_per_second << "x)" << std::endl;
+
+    if (kHeapResult.checksum != kArrayResult.checksum) {
+      std::cerr << "timer_scan_bench: the schedulers handed out different events" << std::endl;
+      return 1;
+    }
+  } catch (const std::exception& kError) {
+    std::cerr << "timer_scan_bench: " << kError.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
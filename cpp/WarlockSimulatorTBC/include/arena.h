@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Owns the spells, auras, dots and procs that a player and its pet create when they're initialized. They're placed
+// one after another in large blocks instead of being allocated one at a time, so they're close together in memory,
+// the pointers between them don't need any reference counting and they're all destroyed together with the arena.
+struct Arena {
+  Arena() = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  ~Arena();
+
+  template <typename T, typename... TArgs>
+  T* Create(TArgs&&... args) {
+    auto* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      destructors.push_back({object, [](void* object_ptr) { static_cast<T*>(object_ptr)->~T(); }});
+    }
+
+    return object;
+  }
+
+private:
+  static constexpr size_t kBlockSize = 32 * 1024;
+
+  struct Destructor {
+    void* object;
+    void (*destroy)(void*);
+  };
+
+  std::vector<std::unique_ptr<std::byte[]>> blocks;
+  std::vector<Destructor> destructors; // In the order that the objects were created in
+  std::byte* free_space = nullptr;
+  size_t free_space_size = 0;
+
+  void* Allocate(size_t kSize, size_t kAlignment);
+};
@@ -1,37 +1,42 @@
 #pragma once
 #include <string>
 
+#include "scheduler.h"
+
 struct Stat;
 struct Entity;
+enum class SpellId;
 #include <vector>
 
 struct Aura {
   virtual ~Aura() = default;
+  // Hot: the state that changes during a fight and what's read whenever the aura is applied, ticks or fades
   Entity& entity;
-  std::vector<Stat> stats;
-  std::vector<Stat> stats_per_stack;
-  std::string name;
+  Timer duration_timer;
+  Timer tick_timer; // dots
   int duration = 0;
-  double duration_remaining = 0;
-  bool active = false;
-  bool has_duration = true;
-  bool group_wide = false; // true if it's an aura that applies to everyone in the group
-  // (will apply to pets as well then)
-  // dots
   int tick_timer_total = 0;
-  double tick_timer_remaining = 0;
   int ticks_remaining = 0;
   int ticks_total = 0;
   int stacks = 0;
   int max_stacks = 0;
+  bool active = false;
+  bool has_duration = true;
+  bool group_wide = false; // true if it's an aura that applies to everyone in the group
+  // (will apply to pets as well then)
+  SpellId id{};
   // ISB
   double modifier = 1;
   // Bloodlust
   double haste_modifier = 0;
+  // Cold
+  std::vector<Stat> stats;
+  std::vector<Stat> stats_per_stack;
+  std::string name;
 
   explicit Aura(Entity& entity_param);
   virtual void Setup();
-  virtual void Tick(double kTime);
+  virtual void Tick();
   virtual void Apply();
   void Fade();
   virtual void DecrementStacks(); // ISB
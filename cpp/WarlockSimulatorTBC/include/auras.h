@@ -1,54 +1,52 @@
 #pragma once
 
-#include <memory>
-
 struct DamageOverTime;
 struct Aura;
 
 struct Auras {
-  std::shared_ptr<DamageOverTime> corruption;
-  std::shared_ptr<DamageOverTime> unstable_affliction;
-  std::shared_ptr<DamageOverTime> siphon_life;
-  std::shared_ptr<DamageOverTime> immolate;
-  std::shared_ptr<DamageOverTime> curse_of_agony;
-  std::shared_ptr<DamageOverTime> curse_of_doom;
-  std::shared_ptr<Aura> improved_shadow_bolt;
-  std::shared_ptr<Aura> curse_of_the_elements;
-  std::shared_ptr<Aura> curse_of_recklessness;
-  std::shared_ptr<Aura> shadow_trance;
-  std::shared_ptr<Aura> amplify_curse;
-  std::shared_ptr<Aura> power_infusion;
-  std::shared_ptr<Aura> innervate;
-  std::shared_ptr<Aura> blood_fury;
-  std::shared_ptr<Aura> destruction_potion;
-  std::shared_ptr<Aura> flame_cap;
-  std::shared_ptr<Aura> bloodlust;
-  std::shared_ptr<Aura> drums_of_battle;
-  std::shared_ptr<Aura> drums_of_war;
-  std::shared_ptr<Aura> drums_of_restoration;
-  std::shared_ptr<Aura> band_of_the_eternal_sage;
-  std::shared_ptr<Aura> wrath_of_cenarius;
-  std::shared_ptr<Aura> blade_of_wizardry;
-  std::shared_ptr<Aura> shattered_sun_pendant_of_acumen_aldor;
-  std::shared_ptr<Aura> robe_of_the_elder_scribes;
-  std::shared_ptr<Aura> mystical_skyfire_diamond;
-  std::shared_ptr<Aura> eye_of_magtheridon;
-  std::shared_ptr<Aura> sextant_of_unstable_currents;
-  std::shared_ptr<Aura> quagmirrans_eye;
-  std::shared_ptr<Aura> shiffars_nexus_horn;
-  std::shared_ptr<Aura> ashtongue_talisman_of_shadows;
-  std::shared_ptr<Aura> darkmoon_card_crusade;
-  std::shared_ptr<Aura> the_lightning_capacitor;
-  std::shared_ptr<Aura> flameshadow;
-  std::shared_ptr<Aura> shadowflame;
-  std::shared_ptr<Aura> spellstrike;
-  std::shared_ptr<Aura> mana_etched_4_set;
-  std::shared_ptr<Aura> chipped_power_core;
-  std::shared_ptr<Aura> cracked_power_core;
-  std::shared_ptr<Aura> mana_tide_totem;
-  std::shared_ptr<Aura> airmans_ribbon_of_gallantry;
-  std::shared_ptr<Aura> demonic_frenzy;
-  std::shared_ptr<Aura> black_book;
-  std::shared_ptr<Aura> battle_squawk;
-  std::shared_ptr<Aura> fel_energy;
+  DamageOverTime* corruption = nullptr;
+  DamageOverTime* unstable_affliction = nullptr;
+  DamageOverTime* siphon_life = nullptr;
+  DamageOverTime* immolate = nullptr;
+  DamageOverTime* curse_of_agony = nullptr;
+  DamageOverTime* curse_of_doom = nullptr;
+  Aura* improved_shadow_bolt = nullptr;
+  Aura* curse_of_the_elements = nullptr;
+  Aura* curse_of_recklessness = nullptr;
+  Aura* shadow_trance = nullptr;
+  Aura* amplify_curse = nullptr;
+  Aura* power_infusion = nullptr;
+  Aura* innervate = nullptr;
+  Aura* blood_fury = nullptr;
+  Aura* destruction_potion = nullptr;
+  Aura* flame_cap = nullptr;
+  Aura* bloodlust = nullptr;
+  Aura* drums_of_battle = nullptr;
+  Aura* drums_of_war = nullptr;
+  Aura* drums_of_restoration = nullptr;
+  Aura* band_of_the_eternal_sage = nullptr;
+  Aura* wrath_of_cenarius = nullptr;
+  Aura* blade_of_wizardry = nullptr;
+  Aura* shattered_sun_pendant_of_acumen_aldor = nullptr;
+  Aura* robe_of_the_elder_scribes = nullptr;
+  Aura* mystical_skyfire_diamond = nullptr;
+  Aura* eye_of_magtheridon = nullptr;
+  Aura* sextant_of_unstable_currents = nullptr;
+  Aura* quagmirrans_eye = nullptr;
+  Aura* shiffars_nexus_horn = nullptr;
+  Aura* ashtongue_talisman_of_shadows = nullptr;
+  Aura* darkmoon_card_crusade = nullptr;
+  Aura* the_lightning_capacitor = nullptr;
+  Aura* flameshadow = nullptr;
+  Aura* shadowflame = nullptr;
+  Aura* spellstrike = nullptr;
+  Aura* mana_etched_4_set = nullptr;
+  Aura* chipped_power_core = nullptr;
+  Aura* cracked_power_core = nullptr;
+  Aura* mana_tide_totem = nullptr;
+  Aura* airmans_ribbon_of_gallantry = nullptr;
+  Aura* demonic_frenzy = nullptr;
+  Aura* black_book = nullptr;
+  Aura* battle_squawk = nullptr;
+  Aura* fel_energy = nullptr;
 };
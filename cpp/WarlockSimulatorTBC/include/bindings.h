@@ -20,7 +20,6 @@ Sets AllocSets();
 CharacterStats AllocStats();
 SimulationSettings AllocSimSettings();
 Simulation AllocSim(Player& player, SimulationSettings& simulation_settings);
-std::vector<uint32_t> AllocRandomSeeds(int kAmountOfSeeds, uint32_t kRandSeed = time(nullptr));
 
 void DpsUpdate(double dps);
 void ErrorCallback(const char* error_msg);
@@ -28,6 +27,8 @@ void PostCombatLogBreakdownVector(const char* name, double mana_gain, double dam
 void PostCombatLogBreakdown(const char* name, uint32_t casts, uint32_t crits, uint32_t misses, uint32_t count,
                             double uptime, uint32_t dodges, uint32_t glancing_blows);
 void CombatLogUpdate(const char* combat_log_entry);
+void ChromeTraceUpdate(const char* chrome_trace);
+void SendProfilingCounters(const char* profiling_counters);
 void SimulationUpdate(int iteration, int iteration_amount, double median_dps, int item_id, const char* custom_stat);
 void SendSimulationResults(double median_dps, double min_dps, double max_dps, int item_id, int iteration_amount,
                            int total_fight_duration, const char* custom_stat, long long simulation_duration);
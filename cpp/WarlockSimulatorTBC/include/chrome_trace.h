@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+
+struct CombatLogBuffer;
+
+// The iterations in the combat log as a Chrome Trace Event JSON file, which can be opened in chrome://tracing or
+// https://ui.perfetto.dev. Every iteration is a process whose threads are the tracks of the player and the pet: their
+// casts (and the pet's swings), their global cooldowns and one track per aura, dot and trinket with a slice for every
+// time it was up. Iterations whose start was already overwritten in the combat log's ring buffer are left out.
+std::string FormatChromeTrace(const CombatLogBuffer& kLog);
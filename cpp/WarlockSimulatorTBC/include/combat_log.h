@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+enum class SpellId;
+struct Entity;
+
+// What a CombatLogEvent is about, which decides what its flags and values mean, see FormatCombatLogEvent()
+enum class CombatLogEventType : uint8_t {
+  kFightLength, // The first event of an iteration
+  kFightEnd,
+  kSpellCast, // Starting to cast a spell or casting an instant one
+  kSpellFinishedCasting,
+  kSpellOffCooldown,
+  kSpellDamage,
+  kSpellResist,
+  kSpellDodge,
+  kSpellMiss,
+  kSeedOfCorruptionDamage,
+  kLifeTap,
+  kLifeTapManaWasted,
+  kManaGain,
+  kMp5ManaGain,
+  kManaOverTimeGain,
+  kPetManaRegen,
+  kManaFeed,
+  kAuraApplied,
+  kAuraRefreshed,
+  kAuraStacks,
+  kAuraFaded,
+  kDotApplied,
+  kDotRefreshedEarly,
+  kDotTick,
+  kDotFaded,
+  kStatChanged,
+  kTrinketUsed,
+  kTrinketFaded,
+  kTrinketOffCooldown
+};
+
+// Bits of CombatLogEvent::flags
+namespace CombatLogFlag {
+// kSpellCast
+constexpr uint8_t kStartedCasting = 1 << 0;
+constexpr uint8_t kCast = 1 << 1;
+constexpr uint8_t kGlobalCooldown = 1 << 2;
+constexpr uint8_t kPredictedDamage = 1 << 3;
+// kSpellDamage
+constexpr uint8_t kCrit = 1 << 0;
+constexpr uint8_t kGlancing = 1 << 1;
+constexpr uint8_t kMagical = 1 << 2;
+constexpr uint8_t kPhysical = 1 << 3;
+// kSpellFinishedCasting
+constexpr uint8_t kPlayer = 1 << 0;
+// kDotApplied
+constexpr uint8_t kRefreshed = 1 << 0;
+// kStatChanged
+constexpr uint8_t kRemoving = 1 << 0;
+constexpr uint8_t kMultiplicative = 1 << 1;
+}
+
+// One thing that happened during a fight, recorded as the numbers that its line in the combat log is made from so that
+// logging it doesn't format anything. The names point at the spells', auras' etc. own names, so the events can only be
+// formatted while the entity that logged them still exists.
+struct CombatLogEvent {
+  CombatLogEventType type = CombatLogEventType::kFightLength;
+  uint8_t flags = 0;
+  SpellId id{};
+  const std::string* name = nullptr; // Of the spell, aura etc.
+  std::array<double, 10> values{};   // Depend on the type, see FormatCombatLogEvent()
+  int tick = 0;                      // Set by Entity::CombatLog()
+  const Entity* entity = nullptr;    // Set by Entity::CombatLog()
+};
+
+// The line that the event is written out as, including the fight time that it happened at
+std::string FormatCombatLogEvent(const CombatLogEvent& kEvent);
+
+// The player's combat log: the stats that are written out at the top of it and the events of the iterations that are
+// logged, kept in a ring buffer that's only allocated once something is logged. When more events are logged than fit,
+// the oldest ones are overwritten.
+struct CombatLogBuffer {
+  static constexpr int kCapacity = 1 << 15;
+
+  std::vector<std::string> header;
+
+  void Add(const CombatLogEvent& kEvent);
+  void Merge(const CombatLogBuffer& kOther, const Entity& kOtherPlayer, const Entity& kPlayer);
+  void Clear();
+  [[nodiscard]] int Size() const { return size; }
+  [[nodiscard]] const CombatLogEvent& Event(int kIndex) const; // From the oldest event that's still in the buffer
+  [[nodiscard]] std::vector<std::string> Format() const;        // The header followed by the events
+
+private:
+  std::vector<CombatLogEvent> events;
+  // Of the merged events, interned so that every name is only stored once however often logs are merged. The elements
+  // of an unordered_set don't move when it grows, so the events' pointers stay valid.
+  std::unordered_set<std::string> names;
+  int first = 0;
+  int size = 0;
+};
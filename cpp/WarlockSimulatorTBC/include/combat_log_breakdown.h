@@ -1,8 +1,9 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
 struct CombatLogBreakdown {
-  std::string name;
+  std::string name; // Empty if nothing with the entry's SpellId is recorded
   uint32_t casts = 0;
   uint32_t crits = 0;
   uint32_t misses = 0;
@@ -13,8 +14,4 @@ struct CombatLogBreakdown {
   uint32_t glancing_blows = 0;
   double applied_at = 0;
   double uptime = 0;
-
-  explicit CombatLogBreakdown(std::string name)
-    : name(std::move(name)) {
-  }
 };
@@ -1,7 +1,5 @@
 #pragma once
 
 #include <string>
-#include <vector>
 
-double Median(std::vector<double> vec);
 std::string DoubleToString(double kNum, int kDecimalPlaces = 0);
@@ -0,0 +1,11 @@
+#pragma once
+
+// The non-random part of the damage of a cast or a dot tick (no crits, misses etc.) along with what it was made of for
+// the combat log. Returned by value so that working out the damage doesn't allocate.
+struct DamageBreakdown {
+  double base_damage = 0;
+  double damage = 0; // After the spell power, damage modifier and partial resists are applied
+  double spell_power = 0;
+  double damage_modifier = 0;
+  double partial_resist_multiplier = 0;
+};
@@ -1,41 +1,49 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <vector>
 
+#include "damage_breakdown.h"
+#include "scheduler.h"
+
 enum class SpellSchool;
+enum class SpellId;
 struct Player;
 struct Spell;
+struct OnDotTickProc;
 
 struct DamageOverTime {
   virtual ~DamageOverTime() = default;
+  // Hot: the state that changes during a fight and what's read whenever the dot is applied or ticks
   Player& player;
-  std::shared_ptr<Spell> parent_spell;
-  SpellSchool school;
+  Timer tick_timer;        // Runs out at the next tick
+  int ticks_remaining = 0; // Amount of ticks remaining before the dot expires
+  int ticks_total = 0;
   int duration = 0;          // Total duration of the dot
   int original_duration = 0; // Used for T4 4pc since we're increasing the duration
   // by 3 seconds but need to know what the original
   // duration was
   int tick_timer_total = 3; // Total duration of each tick (default is 3 seconds
   // between ticks)
-  double tick_timer_remaining = 0; // Time until next tick
-  int ticks_remaining = 0;         // Amount of ticks remaining before the dot expires
-  int ticks_total = 0;
-  double spell_power = 0; // Spell Power amount when dot was applied
-  double base_damage = 0;
-  double coefficient = 0;
+  SpellId id{};
+  double spell_power = 0;       // Spell Power amount when dot was applied
   double t5_bonus_modifier = 0; // T5 4pc damage modifier
   bool active = false;
   bool applied_with_amplify_curse = false;
   bool isb_is_active = false; // Siphon Life
+  SpellSchool school;
+  Spell* parent_spell = nullptr;
+  double base_damage = 0;
+  double coefficient = 0;
+  // Cold
   std::string name;
+  std::vector<OnDotTickProc*> on_tick_procs; // The player's procs that this dot can trigger, see Entity::SetupProcs()
 
   explicit DamageOverTime(Player& player_param);
   void Setup();
   virtual void Apply();
   void Fade();
-  void Tick(double kTime);
-  [[nodiscard]] std::vector<double> GetConstantDamage() const;
+  void Tick();
+  [[nodiscard]] DamageBreakdown GetConstantDamage() const;
   [[nodiscard]] double PredictDamage() const;
 };
 
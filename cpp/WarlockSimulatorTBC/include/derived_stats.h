@@ -0,0 +1,14 @@
+#pragma once
+
+// The parts of Player::GetSpellPower(), GetSpellCritChance() and GetHastePercent() that only change when the player's
+// or the pet's stats do. Casting, damage and damage predictions call those getters many times per GCD, so they're
+// cached here and only recomputed once a Stat has changed the stats since (see Entity::stats_version).
+struct DerivedStats {
+  int player_stats_version = -1;
+  int pet_stats_version = -1;
+  double demonic_knowledge_spell_power = 0;
+  double spellfire_spell_power = 0;
+  double spirit_spell_power = 0; // Improved Divine Spirit
+  double spell_crit_chance = 0;  // Before Devastation is removed for non-destruction spells
+  double haste_percent = 0;
+};
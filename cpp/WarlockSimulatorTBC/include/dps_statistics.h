@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <vector>
+
+// Estimates one quantile of a stream of values without storing them (the P² algorithm by Jain and Chlamtac). Reading
+// the estimate is O(1), which is what the progress updates need, but two estimates can't be merged.
+struct P2Quantile {
+  explicit P2Quantile(double kQuantile = 0.5);
+  void Add(double kValue);
+  [[nodiscard]] double Estimate() const;
+
+private:
+  double quantile;
+  int count = 0;
+  std::array<double, 5> heights{};           // Marker heights, the first five values until there are five of them
+  std::array<double, 5> positions{};         // Actual marker positions, 1-based
+  std::array<double, 5> desired_positions{}; // Where the markers should be
+  std::array<double, 5> increments{};        // How much the desired positions move per value
+
+  [[nodiscard]] double Parabolic(int kMarker, double kDirection) const;
+  [[nodiscard]] double Linear(int kMarker, int kDirection) const;
+};
+
+// The mean and variance of a stream of values with Welford's algorithm, without storing the values
+struct RunningMeanVariance {
+  int count = 0;
+  double mean = 0;
+  double sum_of_squares = 0; // Of the differences from the mean
+
+  void Add(double kValue);
+  void Merge(const RunningMeanVariance& kOther);
+  [[nodiscard]] double Variance() const;
+  [[nodiscard]] double StandardDeviation() const;
+  [[nodiscard]] double StandardError() const; // Of the mean
+};
+
+// Summary of the dps of a simulation's iterations that's updated as each iteration finishes, so neither its memory nor
+// the cost of reading it grows with the amount of iterations:
+// - the mean and variance, see RunningMeanVariance
+// - a running P² estimate of the median for the progress updates
+// - a histogram of the dps in kHistogramBinWidth-wide bins starting at 0 dps, which the final median and other
+//   quantiles are interpolated from. Unlike the P² estimate it can be merged and doesn't depend on the order of the
+//   values, so the results don't change when the iterations are split between threads. Dps above kHistogramMaxDps
+//   is counted in the last bin so that an outlier can't make it grow without bounds.
+struct DpsStatistics : RunningMeanVariance {
+  static constexpr double kHistogramBinWidth = 0.5;
+  static constexpr double kHistogramMaxDps = 100000; // Far above any warlock's dps
+
+  double min = 0;
+  double max = 0;
+  std::vector<int> histogram;
+  P2Quantile running_median;
+
+  void Add(double kValue);
+  void Merge(const DpsStatistics& kOther);
+  void Clear();
+  [[nodiscard]] double Quantile(double kQuantile) const;
+  [[nodiscard]] double Median() const;
+};
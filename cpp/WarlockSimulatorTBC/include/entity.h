@@ -1,11 +1,13 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <vector>
 
 #include "auras.h"
 #include "character_stats.h"
+#include "combat_log.h"
+#include "combat_log_breakdown.h"
 #include "enums.h"
+#include "scheduler.h"
 #include "spells.h"
 
 struct DamageOverTime;
@@ -17,19 +19,15 @@ struct OnDamageProc;
 struct OnDotTickProc;
 struct OnCritProc;
 struct OnHitProc;
-struct CombatLogBreakdown;
 enum class EntityType;
 struct PlayerSettings;
 struct Player;
 struct Pet;
 struct Simulation;
-
-#include <map>
+struct EntitySnapshot;
 
 struct Entity {
   virtual ~Entity() = default;
-  const int kFloatNumberMultiplier = 1000; // Multiply doubles such as hit and crit chance with this since we need an
-  // integer when calling player.rng.range()
   const int kLevel = 70;
   const double kGcdValue = 1.5;
   const double kMinimumGcdValue = 1;
@@ -39,11 +37,11 @@ struct Entity {
   PlayerSettings& settings;
   Auras auras = Auras();
   Spells spells = Spells();
-  std::shared_ptr<Pet> pet;
+  Pet* pet = nullptr;
   CharacterStats stats;
   EntityType entity_type;
   std::string name;
-  std::map<std::string, std::shared_ptr<CombatLogBreakdown>> combat_log_breakdown;
+  std::vector<CombatLogBreakdown> combat_log_breakdown; // Indexed by SpellId, empty unless the breakdown is recorded
   std::vector<Aura*> aura_list;
   std::vector<Spell*> spell_list;
   std::vector<DamageOverTime*> dot_list;
@@ -52,26 +50,32 @@ struct Entity {
   std::vector<OnDotTickProc*> on_dot_tick_procs;
   std::vector<OnDamageProc*> on_damage_procs;
   std::vector<OnResistProc*> on_resist_procs;
-  double cast_time_remaining = 0;
-  double gcd_remaining = 0;
-  double five_second_rule_timer_remaining = 5;
-  double mp5_timer_remaining = 5;
+  Timer cast_timer;
+  Timer gcd_timer;
+  Timer five_second_rule_timer;
+  Timer mp5_timer;
   bool recording_combat_log_breakdown;
   bool equipped_item_simulation;
   bool infinite_mana;
   int enemy_shadow_resist; // TODO move these to an Enemy struct
   int enemy_fire_resist;
   int enemy_level_difference_resistance;
+  int stats_version = 0; // Incremented whenever the stats change after the entity was set up, see DerivedStats
+  bool writing_combat_log = false; // Whether the current iteration is logged, see Simulation::IterationReset()
 
   Entity(Player* player, PlayerSettings& player_settings, EntityType entity_type);
   virtual double GetIntellect();
   virtual double GetStamina();
   virtual double GetHastePercent() = 0;
-  virtual double FindTimeUntilNextAction();
-  virtual void Tick(double kTime);
+  void HandleTimer(const Timer& kTimer);
+  void SaveState(EntitySnapshot& snapshot) const;
+  void RestoreState(const EntitySnapshot& kSnapshot);
+  virtual void Mp5Tick() = 0;
   virtual void EndAuras();
   virtual void Reset();
   virtual void Initialize(Simulation* simulation_ptr);
+  void SetupSharedCooldowns() const;
+  void SetupProcs() const;
   virtual double GetSpellPower(bool dealing_damage, SpellSchool spell_school) = 0;
   virtual double GetSpellCritChance(SpellType spell_type = SpellType::kNoSpellType) = 0;
   virtual double GetDamageModifier(Spell& spell, bool is_dot) = 0;
@@ -87,8 +91,12 @@ struct Entity {
   [[nodiscard]] double GetCustomImprovedShadowBoltDamageModifier() const;
   double GetGcdValue();
   [[nodiscard]] double GetBaseSpellHitChance(int kEntityLevel, int kEnemyLevel) const;
-  void SendCombatLogBreakdown() const;
-  void CombatLog(const std::string& kEntry) const;
-  [[nodiscard]] bool ShouldWriteToCombatLog() const;
-  void PostIterationDamageAndMana(const std::string& kSpellName) const;
+  void AddCombatLogBreakdown(SpellId kId, const std::string& kName);
+  CombatLogBreakdown& GetCombatLogBreakdown(SpellId kId) { return combat_log_breakdown[static_cast<int>(kId)]; }
+  void SendCombatLogBreakdown();
+  void MergeCombatLogBreakdown(const Entity& kEntity);
+  void ResetCombatLogBreakdown();
+  void CombatLog(CombatLogEvent event) const;
+  [[nodiscard]] bool ShouldWriteToCombatLog() const { return writing_combat_log; }
+  static void PostIterationDamageAndMana(CombatLogBreakdown& breakdown);
 };
@@ -16,6 +16,8 @@ enum class AttackType { kNoAttackType, kPhysical, kMagical };
 
 enum class SimulationType { kNormal, kAllItems, kStatWeights };
 
+enum class RngEngine { kXoshiro256PlusPlus, kMersenneTwister, kPcg32, kPhilox };
+
 enum class CalculationType { kNoType, kAdditive, kMultiplicative };
 
 enum class EntityType { kNoType, kPlayer, kPet };
@@ -26,6 +28,98 @@ const std::string kSuccubus = "Succubus";
 const std::string kFelguard = "Felguard";
 } // namespace PetNameStr
 
+// Identifies spells, auras, dots and trinkets in the hot paths so that they're compared as integers and can index
+// arrays like Entity::combat_log_breakdown. Each SpellName has the ID with the same name, the names are only used for
+// displaying.
+enum class SpellId {
+  kNoId,
+  kShadowBolt,
+  kLifeTap,
+  kIncinerate,
+  kSearingPain,
+  kCorruption,
+  kImmolate,
+  kUnstableAffliction,
+  kSiphonLife,
+  kCurseOfDoom,
+  kCurseOfAgony,
+  kCurseOfTheElements,
+  kCurseOfRecklessness,
+  kSoulFire,
+  kShadowburn,
+  kDeathCoil,
+  kShadowfury,
+  kSeedOfCorruption,
+  kConflagrate,
+  kDestructionPotion,
+  kFlameCap,
+  kBloodFury,
+  kBloodlust,
+  kDrumsOfBattle,
+  kDrumsOfWar,
+  kDrumsOfRestoration,
+  kTimbalsFocusingCrystal,
+  kMarkOfDefiance,
+  kTheLightningCapacitor,
+  kBladeOfWizardry,
+  kShatteredSunPendantOfAcumenAldor,
+  kShatteredSunPendantOfAcumenScryers,
+  kRobeOfTheElderScribes,
+  kQuagmirransEye,
+  kShiffarsNexusHorn,
+  kSextantOfUnstableCurrents,
+  kBandOfTheEternalSage,
+  kMysticalSkyfireDiamond,
+  kInsightfulEarthstormDiamond,
+  kAmplifyCurse,
+  kPowerInfusion,
+  kInnervate,
+  kChippedPowerCore,
+  kCrackedPowerCore,
+  kNightfall,
+  kManaTideTotem,
+  kJudgementOfWisdom,
+  kFlameshadow,
+  kShadowflame,
+  kSpellstrike,
+  kManaEtched4Set,
+  kAshtongueTalismanOfShadows,
+  kWrathOfCenarius,
+  kDarkmoonCardCrusade,
+  kDarkPact,
+  kSuperManaPotion,
+  kDemonicRune,
+  kFirebolt,
+  kDemonicFrenzy,
+  kLashOfPain,
+  kMelee,
+  kCleave,
+  kBlackBook,
+  kBattleSquawk,
+  kImprovedShadowBolt,
+  kEyeOfMagtheridon,
+  kAirmansRibbonOfGallantry,
+  kFelEnergy,
+  kRestrainedEssenceOfSapphiron,
+  kShiftingNaaruSliver,
+  kSkullOfGuldan,
+  kHexShrunkenHead,
+  kIconOfTheSilverCrescent,
+  kScryersBloodgem,
+  kAncientCrystalTalisman,
+  kArcanistsStone,
+  kTerokkarTabletOfVim,
+  kXirisGift,
+  kVengeanceOfTheIllidari,
+  kFigurineLivingRubySerpent,
+  kEssenceOfTheMartyr,
+  kStarkillersBauble,
+  kDarkIronSmokingPipe,
+  kHazzarahsCharmOfDestruction,
+  kMp5, // The mana gained from mp5 in the combat log breakdown
+  kCount // The amount of IDs, not an ID itself
+};
+
 namespace SpellName {
 const std::string kShadowBolt = "Shadow Bolt";
 const std::string kLifeTap = "Life Tap";
@@ -94,6 +188,22 @@ const std::string kImprovedShadowBolt = "Improved Shadow Bolt";
 const std::string kEyeOfMagtheridon = "Eye of Magtheridon";
 const std::string kAirmansRibbonOfGallantry = "Airman's Ribbon of Gallantry";
 const std::string kFelEnergy = "Fel Energy";
+const std::string kRestrainedEssenceOfSapphiron = "The Restrained Essence of Sapphiron";
+const std::string kShiftingNaaruSliver = "Shifting Naaru Sliver";
+const std::string kSkullOfGuldan = "The Skull of Gul'dan";
+const std::string kHexShrunkenHead = "Hex Shrunken Head";
+const std::string kIconOfTheSilverCrescent = "Icon of the Silver Crescent";
+const std::string kScryersBloodgem = "Scryer's Bloodgem";
+const std::string kAncientCrystalTalisman = "Ancient Crystal Talisman";
+const std::string kArcanistsStone = "Arcanist's Stone";
+const std::string kTerokkarTabletOfVim = "Terokkar Table of Vim";
+const std::string kXirisGift = "Xi'ri's Gift";
+const std::string kVengeanceOfTheIllidari = "Vengeance of the Illidari";
+const std::string kFigurineLivingRubySerpent = "Figurine: Living Ruby Serpent";
+const std::string kEssenceOfTheMartyr = "Essence of the Martyr";
+const std::string kStarkillersBauble = "Starkiller's Bauble";
+const std::string kDarkIronSmokingPipe = "Dark Iron Smoking Pipe";
+const std::string kHazzarahsCharmOfDestruction = "Hazza'rah's Charm of Destruction";
 } // namespace SpellName
 
 namespace StatName {
@@ -113,6 +223,7 @@ const std::string kAttackPowerModifier = "Attack Power Modifier";
 
 namespace StatConstant {
 constexpr double kHitRatingPerPercent = 12.62;
+constexpr double kHitPercentCap = 16;
 constexpr double kCritRatingPerPercent = 22.08;
 constexpr double kHasteRatingPerPercent = 15.77;
 constexpr double kManaPerIntellect = 15;
@@ -19,4 +19,6 @@ struct Items {
   int off_hand;
   int two_hand;
   int wand;
+
+  bool operator==(const Items&) const = default;
 };
\ No newline at end of file
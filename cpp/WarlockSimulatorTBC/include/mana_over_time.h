@@ -4,7 +4,7 @@
 struct ManaOverTime : Aura {
   explicit ManaOverTime(Entity& entity);
   void Apply() override;
-  void Tick(double kTime) override;
+  void Tick() override;
   void Setup() override;
   virtual double GetManaGain() = 0;
 };
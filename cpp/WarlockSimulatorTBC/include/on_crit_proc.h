@@ -4,12 +4,12 @@
 struct Player;
 
 struct OnCritProc : SpellProc {
-  explicit OnCritProc(Player& player, std::shared_ptr<Aura> aura = nullptr);
+  explicit OnCritProc(Player& player, Aura* aura = nullptr);
   void Setup() override;
 };
 
 struct ImprovedShadowBolt final : OnCritProc {
-  ImprovedShadowBolt(Player& player, std::shared_ptr<Aura> aura);
+  ImprovedShadowBolt(Player& player, Aura* aura);
   bool ShouldProc(Spell* spell) override;
 };
 
@@ -19,9 +19,9 @@ struct TheLightningCapacitor final : OnCritProc {
 };
 
 struct ShiffarsNexusHorn final : OnCritProc {
-  ShiffarsNexusHorn(Player& player, std::shared_ptr<Aura> aura);
+  ShiffarsNexusHorn(Player& player, Aura* aura);
 };
 
 struct SextantOfUnstableCurrents final : OnCritProc {
-  SextantOfUnstableCurrents(Player& player, std::shared_ptr<Aura> aura);
+  SextantOfUnstableCurrents(Player& player, Aura* aura);
 };
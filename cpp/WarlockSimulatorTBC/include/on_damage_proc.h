@@ -4,12 +4,12 @@
 struct Player;
 
 struct OnDamageProc : SpellProc {
-  explicit OnDamageProc(Player& player, const std::shared_ptr<Aura>& kAura = nullptr);
+  explicit OnDamageProc(Player& player, Aura* aura = nullptr);
   void Setup() override;
 };
 
 struct ShatteredSunPendantOfAcumenAldor final : OnDamageProc {
-  ShatteredSunPendantOfAcumenAldor(Player& player, std::shared_ptr<Aura> aura);
+  ShatteredSunPendantOfAcumenAldor(Player& player, Aura* aura);
 };
 
 struct ShatteredSunPendantOfAcumenScryers final : OnDamageProc {
@@ -4,13 +4,13 @@
 struct Player;
 
 struct OnDotTickProc : SpellProc {
-  explicit OnDotTickProc(Player& player, const std::shared_ptr<Aura>& kAura = nullptr);
+  explicit OnDotTickProc(Player& player, Aura* aura = nullptr);
   void Setup() override;
   virtual bool ShouldProc(DamageOverTime* spell);
 };
 
 struct AshtongueTalismanOfShadows final : OnDotTickProc {
-  AshtongueTalismanOfShadows(Player& player, const std::shared_ptr<Aura>& kAura);
+  AshtongueTalismanOfShadows(Player& player, Aura* aura);
   bool ShouldProc(DamageOverTime* spell) override;
 };
 
@@ -2,7 +2,7 @@
 #include "spell_proc.h"
 
 struct OnHitProc : SpellProc {
-  explicit OnHitProc(Entity& entity, std::shared_ptr<Aura> aura = nullptr);
+  explicit OnHitProc(Entity& entity, Aura* aura = nullptr);
   void Setup() override;
 };
 
@@ -11,7 +11,7 @@ struct MarkOfDefiance final : OnHitProc {
 };
 
 struct BladeOfWizardry final : OnHitProc {
-  explicit BladeOfWizardry(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit BladeOfWizardry(Entity& entity, Aura* aura);
 };
 
 struct InsightfulEarthstormDiamond final : OnHitProc {
@@ -19,19 +19,19 @@ struct InsightfulEarthstormDiamond final : OnHitProc {
 };
 
 struct RobeOfTheElderScribes final : OnHitProc {
-  explicit RobeOfTheElderScribes(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit RobeOfTheElderScribes(Entity& entity, Aura* aura);
 };
 
 struct QuagmirransEye final : OnHitProc {
-  explicit QuagmirransEye(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit QuagmirransEye(Entity& entity, Aura* aura);
 };
 
 struct BandOfTheEternalSage final : OnHitProc {
-  explicit BandOfTheEternalSage(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit BandOfTheEternalSage(Entity& entity, Aura* aura);
 };
 
 struct MysticalSkyfireDiamond final : OnHitProc {
-  explicit MysticalSkyfireDiamond(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit MysticalSkyfireDiamond(Entity& entity, Aura* aura);
 };
 
 struct JudgementOfWisdom final : OnHitProc {
@@ -39,31 +39,31 @@ struct JudgementOfWisdom final : OnHitProc {
 };
 
 struct Flameshadow final : OnHitProc {
-  explicit Flameshadow(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit Flameshadow(Entity& entity, Aura* aura);
   bool ShouldProc(Spell* spell) override;
 };
 
 struct Shadowflame final : OnHitProc {
-  explicit Shadowflame(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit Shadowflame(Entity& entity, Aura* aura);
   bool ShouldProc(Spell* spell) override;
 };
 
 struct Spellstrike final : OnHitProc {
-  explicit Spellstrike(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit Spellstrike(Entity& entity, Aura* aura);
 };
 
 struct ManaEtched4Set final : OnHitProc {
-  explicit ManaEtched4Set(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit ManaEtched4Set(Entity& entity, Aura* aura);
 };
 
 struct WrathOfCenarius final : OnHitProc {
-  explicit WrathOfCenarius(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit WrathOfCenarius(Entity& entity, Aura* aura);
 };
 
 struct DarkmoonCardCrusade final : OnHitProc {
-  explicit DarkmoonCardCrusade(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit DarkmoonCardCrusade(Entity& entity, Aura* aura);
 };
 
 struct DemonicFrenzy final : OnHitProc {
-  explicit DemonicFrenzy(Entity& entity, std::shared_ptr<Aura> aura);
+  explicit DemonicFrenzy(Entity& entity, Aura* aura);
 };
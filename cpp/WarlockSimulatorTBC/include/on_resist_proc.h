@@ -4,10 +4,10 @@
 struct Player;
 
 struct OnResistProc : SpellProc {
-  explicit OnResistProc(Player& player, std::shared_ptr<Aura> aura = nullptr);
+  explicit OnResistProc(Player& player, Aura* aura = nullptr);
   void Setup() override;
 };
 
 struct EyeOfMagtheridon : OnResistProc {
-  EyeOfMagtheridon(Player& player, const std::shared_ptr<Aura>& kAura);
+  EyeOfMagtheridon(Player& player, Aura* aura);
 };
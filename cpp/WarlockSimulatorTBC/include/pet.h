@@ -4,7 +4,7 @@
 enum class EmbindConstant;
 struct Player;
 
-struct Pet final : Entity, std::enable_shared_from_this<Pet> {
+struct Pet final : Entity {
   const double kBaseMeleeSpeed = 2;
   PetName pet_name = PetName::kNoName;
   PetType pet_type = PetType::kNoPetType;
@@ -17,7 +17,7 @@ struct Pet final : Entity, std::enable_shared_from_this<Pet> {
   void CalculateStatsFromAuras();
   void Setup();
   void Reset() override;
-  void Tick(double kTime) override;
+  void Mp5Tick() override;
   double GetAttackPower() const;
   double GetHastePercent() override;
   double GetSpellCritChance(SpellType spell_type = SpellType::kNoSpellType) override;
@@ -1,8 +1,9 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <vector>
 
+#include "arena.h"
+#include "derived_stats.h"
 #include "entity.h"
 #include "enums.h"
 #include "rng.h"
@@ -24,19 +25,23 @@ struct Player final : Entity {
   Sets& sets;
   Items& items;
   PlayerSettings& settings;
+  Arena arena; // Owns the spells, auras and procs that Initialize() creates, including the pet and its own
   std::vector<Trinket> trinkets;
-  std::shared_ptr<Spell> filler;
-  std::shared_ptr<Spell> curse_spell;
-  std::shared_ptr<Aura> curse_aura;
-  std::vector<std::string> combat_log_entries;
+  Spell* filler = nullptr;
+  Spell* curse_spell = nullptr;
+  Aura* curse_aura = nullptr;
+  CombatLogBuffer combat_log; // Also has the pet's events
   std::string custom_stat;
   Rng rng;
   double total_fight_duration;
   double iteration_damage;
   int power_infusions_ready;
+  int enemy_armor;
+  DerivedStats derived_stats; // Use GetDerivedStats() to read it
 
   explicit Player(PlayerSettings& settings);
   void Initialize(Simulation* simulation_ptr) override;
+  void RefreshStats();
   void Reset() override;
   void EndAuras() override;
   void ThrowError(const std::string& kError) const;
@@ -44,12 +49,12 @@ struct Player final : Entity {
   void UseCooldowns(double kFightTimeRemaining);
   void SendCombatLogEntries() const;
   void SendPlayerInfoToCombatLog();
-  void Tick(double kTime) override;
+  void Mp5Tick() override;
+  const DerivedStats& GetDerivedStats();
   double GetSpellPower(bool kDealingDamage, SpellSchool kSchool = SpellSchool::kNoSchool) override;
   double GetHastePercent() override;
   double GetSpellCritChance(SpellType kSpellType) override;
-  double FindTimeUntilNextAction() override;
   double GetDamageModifier(Spell& spell, bool kIsDot) override;
-  int GetRand();
   bool RollRng(double kChance);
+  bool RollProc(double kProcChance);
 };
@@ -21,7 +21,6 @@ struct PlayerSettings {
   EmbindConstant lash_of_pain_usage = EmbindConstant::kUnused;
   EmbindConstant pet_mode = EmbindConstant::kUnused;
   EmbindConstant rotation_option = EmbindConstant::kUnused;
-  std::vector<uint32_t> random_seeds;
   int item_id = 0;
   int meta_gem_id = 0;
   bool equipped_item_simulation = false;
@@ -0,0 +1,38 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "aura_selection.h"
+#include "character_stats.h"
+#include "enums.h"
+#include "items.h"
+#include "player_settings.h"
+#include "sets.h"
+#include "simulation_batch.h"
+#include "simulation_settings.h"
+#include "talents.h"
+
+// Everything the web worker passes to the simulation, read from a plain-text profile instead so that the native build
+// can be run without a browser. A profile is made of [items], [auras], [talents], [sets], [stats], [player] and
+// [simulation] sections with one "key = value" pair per line, where the keys are the same names that the embind
+// bindings use (e.g. "trinket1 = 32483" or "race = gnome"). Lines starting with '#' are ignored.
+//
+// A [variant <name>] section adds a SimulationVariant that is run after the base profile. Its keys name the base value
+// they replace, e.g. "items.trinket1 = 29370", "stats.spellPower = 1551" or "player.customStat = spellPower".
+struct Profile {
+  AuraSelection auras = AuraSelection();
+  Talents talents = Talents();
+  Sets sets = Sets();
+  Items items = Items();
+  PlayerSettings player_settings;
+  SimulationSettings simulation_settings = SimulationSettings();
+  std::vector<SimulationVariant> variants;
+
+  Profile();
+  Profile(const Profile&) = delete;
+  Profile& operator=(const Profile&) = delete;
+  void Read(std::istream& stream);
+  void Set(const std::string& kSection, const std::string& kKey, const std::string& kValue);
+  [[nodiscard]] SimulationVariant GetBaseVariant() const;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Counters of where a simulation spends its time, only compiled in when WARLOCK_SIM_PROFILING is defined (make native
+// PROFILING=1) since timing the main loop's phases takes longer than some of the phases themselves. Without it the
+// functions below do nothing and every counter stays at 0.
+#ifdef WARLOCK_SIM_PROFILING
+constexpr bool kProfiling = true;
+#else
+constexpr bool kProfiling = false;
+#endif
+
+// The phases of an iteration's main loop, see Simulation::RunIterations()
+enum class ProfilingPhase { kCastNonPlayerCooldowns, kCastNonGcdSpells, kCastGcdSpells, kCastPetSpells, kPassTime };
+constexpr std::array<const char*, 5> kProfilingPhaseNames = {"castNonPlayerCooldowns", "castNonGcdSpells",
+                                                             "castGcdSpells", "castPetSpells", "passTime"};
+
+enum class ProfilingCounter { kEvents, kRngDraws, kProcRolls, kAuraApplications, kPredictDamageCalls };
+constexpr std::array<const char*, 5> kProfilingCounterNames = {"events", "rngDraws", "procRolls", "auraApplications",
+                                                               "predictDamageCalls"};
+
+struct ProfilingCounters {
+  std::array<uint64_t, kProfilingPhaseNames.size()> phase_calls{};
+  std::array<uint64_t, kProfilingPhaseNames.size()> phase_nanoseconds{};
+  std::array<uint64_t, kProfilingCounterNames.size()> counts{};
+
+  void Merge(const ProfilingCounters& kOther) {
+    for (size_t i = 0; i < phase_calls.size(); i++) {
+      phase_calls[i] += kOther.phase_calls[i];
+      phase_nanoseconds[i] += kOther.phase_nanoseconds[i];
+    }
+
+    for (size_t i = 0; i < counts.size(); i++) {
+      counts[i] += kOther.counts[i];
+    }
+  }
+};
+
+// The counters as a JSON object with the totals and the averages per call and per iteration
+std::string FormatProfilingCounters(const ProfilingCounters& kCounters, int kIterations);
+
+// Everything is counted by the thread that runs the iterations and handed to its simulation once they're done, see
+// Simulation::RunIterationRange(), so the counting doesn't need to know which simulation it's for
+#ifdef WARLOCK_SIM_PROFILING
+inline thread_local ProfilingCounters thread_profiling_counters;
+#endif
+
+inline void ResetThreadProfilingCounters() {
+#ifdef WARLOCK_SIM_PROFILING
+  thread_profiling_counters = ProfilingCounters();
+#endif
+}
+
+inline ProfilingCounters GetThreadProfilingCounters() {
+#ifdef WARLOCK_SIM_PROFILING
+  return thread_profiling_counters;
+#else
+  return {};
+#endif
+}
+
+inline void CountProfilingEvent([[maybe_unused]] const ProfilingCounter kCounter) {
+#ifdef WARLOCK_SIM_PROFILING
+  thread_profiling_counters.counts[static_cast<int>(kCounter)]++;
+#endif
+}
+
+// Counts its lifetime as one call of the phase
+struct ProfilingPhaseTimer {
+  explicit ProfilingPhaseTimer([[maybe_unused]] const ProfilingPhase kPhase) {
+#ifdef WARLOCK_SIM_PROFILING
+    phase = static_cast<int>(kPhase);
+    start = std::chrono::steady_clock::now();
+#endif
+  }
+
+  ~ProfilingPhaseTimer() {
+#ifdef WARLOCK_SIM_PROFILING
+    const auto kElapsed = std::chrono::steady_clock::now() - start;
+    thread_profiling_counters.phase_calls[phase]++;
+    thread_profiling_counters.phase_nanoseconds[phase] +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(kElapsed).count();
+#endif
+  }
+
+  ProfilingPhaseTimer(const ProfilingPhaseTimer&) = delete;
+  ProfilingPhaseTimer& operator=(const ProfilingPhaseTimer&) = delete;
+
+#ifdef WARLOCK_SIM_PROFILING
+private:
+  int phase;
+  std::chrono::steady_clock::time_point start;
+#endif
+};
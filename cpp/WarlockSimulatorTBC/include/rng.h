@@ -1,12 +1,48 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <random>
 
+#include "enums.h"
+#include "profiling.h"
+
+// The seed of an iteration's rng, worked out from the simulation's seed and the iteration's index alone so that any
+// range of iterations gets the same seeds no matter which thread or process runs it
+uint64_t IterationSeed(uint32_t kSimulationSeed, int kIteration);
+
+// The engine's raw 32-bit outputs are generated kBufferSize at a time in one loop when the rng is seeded and whenever
+// the buffer runs out, so the hot paths only read the next value from the buffer. Rolls compare that value against an
+// integer threshold (see ChanceToThreshold()) instead of converting it to a floating point number first.
 struct Rng {
-  void Seed(uint32_t kSeed);
-  double Next();
+  void Seed(uint64_t kSeed, RngEngine kEngine = RngEngine::kXoshiro256PlusPlus);
   int Range(int kMin, int kMax);
+  // Converts a chance in percent to the threshold that Roll() compares the next output against
+  static uint64_t ChanceToThreshold(double kChance);
+
+  uint32_t NextUint32() {
+    CountProfilingEvent(ProfilingCounter::kRngDraws);
+
+    if (_position == kBufferSize) {
+      Refill();
+    }
+
+    return _buffer[_position++];
+  }
+
+  bool Roll(const uint64_t kThreshold) { return NextUint32() < kThreshold; }
 
 private:
-  std::mt19937 _random_engine;
-  std::uniform_real_distribution<double> _random{0, 1};
+  static constexpr int kBufferSize = 256;
+
+  RngEngine _engine = RngEngine::kXoshiro256PlusPlus;
+  std::array<uint32_t, kBufferSize> _buffer{};
+  int _position = kBufferSize;
+  std::mt19937 _mersenne_twister;
+  std::array<uint64_t, 4> _xoshiro_state{};
+  uint64_t _pcg_state = 0;
+  uint64_t _pcg_increment = 0;
+  std::array<uint32_t, 2> _philox_key{};
+  uint64_t _philox_counter = 0;
+
+  void Refill();
 };
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+struct Entity;
+
+// The simulation's clock counts whole milliseconds so that timers run out at exactly the time they were started for
+// and can be compared without any floating point error
+constexpr int kTicksPerSecond = 1000;
+
+int SecondsToTicks(double kSeconds);
+double TicksToSeconds(int kTicks);
+
+// What a Timer is waiting for. The entity's HandleTimer() decides what happens when it runs out.
+enum class TimerType {
+  kAuraDuration,
+  kAuraTick,
+  kDotTick,
+  kSpellCooldown,
+  kCastTime,
+  kTrinketCooldown,
+  kTrinketDuration,
+  kMp5,
+  kGcd,
+  kFiveSecondRule
+};
+
+// Everything about a timer apart from the entity that it belongs to, see SimulationSnapshot
+struct TimerState {
+  int index;
+  int end;
+};
+
+// A point in the fight that something is waiting for, e.g. an aura fading or a spell coming off cooldown. Starting it
+// tells the simulation's Scheduler when to wake up so the simulation can skip straight to it instead of checking every
+// spell, aura and dot on every step.
+struct Timer {
+  Entity* entity = nullptr;
+  TimerType type = TimerType::kGcd;
+  int index = 0; // Position of the timer's aura, dot, spell or trinket in the entity's list of them
+  int end = 0;   // Fight time in ticks that the timer runs out at
+  int slot = -1; // In the simulation's Scheduler, assigned once the player has been initialized
+
+  void Register(Entity& entity_param, TimerType kType, int kIndex = 0);
+  void Start(double kDuration, bool kWakeUp = true); // kDuration in seconds, rounded to the nearest tick
+  void Stop();
+  [[nodiscard]] double Remaining() const; // In seconds
+  [[nodiscard]] int Order() const;
+  [[nodiscard]] TimerState GetState() const { return {index, end}; }
+  void SetState(const TimerState& kState);
+};
+
+// The timers of the simulation's player and pet as a struct of arrays, with every timer in the slot that it got when
+// the player was initialized. A timer that will wake the simulation up has the tick that it runs out at in wake_times,
+// every other slot has kNotWaiting, so finding the next event is a min-reduction over one int array that the compiler
+// vectorizes. Stopping or restarting a timer just overwrites its slot.
+struct Scheduler {
+  static constexpr int kNotWaiting = std::numeric_limits<int>::max();
+  static constexpr int kLanes = 8; // wake_times is padded with kNotWaiting to a multiple of this many slots
+
+  std::vector<int> wake_times;
+  std::vector<int> orders; // Handles the timers that run out at the same time in a fixed order, see Timer::Order()
+  std::vector<Timer*> timers;
+
+  void AddTimers(Entity& entity);
+  void Schedule(Timer& timer);
+  void Cancel(const Timer& kTimer) { wake_times[kTimer.slot] = kNotWaiting; }
+  [[nodiscard]] int NextEventTime() const;
+  Timer* PopEvent(int kTime);
+  void Clear();
+
+private:
+  void AddTimer(Timer& timer);
+};
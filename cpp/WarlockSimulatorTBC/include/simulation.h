@@ -1,35 +1,99 @@
 #pragma once
-#include <map>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
+#include "dps_statistics.h"
+#include "entity.h"
+#include "profiling.h"
+#include "scheduler.h"
+
 struct Spell;
 struct SimulationSettings;
 struct Player;
+struct SimulationSnapshot;
+
+// The spells that the sim is choosing between when it decides what to cast during a GCD, with their predicted damage.
+// This is built on every decision so it's a fixed-size array instead of a container that allocates.
+struct SpellCandidates {
+  // More than the amount of different spells that CastGcdSpells() can consider in a single decision
+  static constexpr int kCapacity = 16;
+  std::array<Spell*, kCapacity> spells;
+  std::array<double, kCapacity> predicted_damage;
+  int size = 0;
+
+  [[nodiscard]] bool Contains(const Spell* kSpell) const;
+  [[nodiscard]] bool Empty() const { return size == 0; }
+  void Add(Spell* spell, double kPredictedDamage);
+};
 
 struct Simulation {
+  // With a target standard error the iterations are run in blocks of this many, checking for convergence after each
+  static constexpr int kConvergenceCheckInterval = 500;
   Player& player;
   const SimulationSettings& kSettings;
-  std::vector<double> dps_vector;
+  Scheduler scheduler;
+  DpsStatistics dps_statistics;
+  std::vector<double> dps_values; // One per iteration, only kept if keep_dps_values is set since it grows with them
   int iteration = 0;
-  double current_fight_time = 0;
-  double min_dps = 0;
-  double max_dps = 0;
+  int current_tick = 0; // See kTicksPerSecond
+  bool keep_dps_values = false;
+  bool is_worker = false; // Workers run a range of another simulation's iterations and don't post any updates
+  std::atomic<int>* completed_iterations = nullptr; // Shared between the threads of a multi-threaded simulation
+  ProfilingCounters profiling;                      // Only counted when profiling is compiled in, see profiling.h
 
   Simulation(Player& player, const SimulationSettings& kSimulationSettings);
   void Start();
+  void Run();
+  void ClearResults();
+  void RunIterationRange(int kFirstIteration, int kLastIteration);
+  [[nodiscard]] bool HasConverged() const;
+  void RunIterations(int kFirstIteration, int kLastIteration);
+  void RunIterationsInParallel(int kFirstIteration, int kLastIteration, int kThreadAmount);
+  void MergeWorkerResults(const Simulation& kWorker);
+  int StartIteration(int kIteration);
   void IterationReset(double kFightLength);
+  void SaveSnapshot(SimulationSnapshot& snapshot) const;
+  void RestoreSnapshot(const SimulationSnapshot& kSnapshot);
+  void CastSpells(int kFightEnd) const;
   void CastNonPlayerCooldowns(double kFightTimeRemaining) const;
   void CastNonGcdSpells() const;
   void CastGcdSpells(double kFightTimeRemaining) const;
   void CastPetSpells() const;
   void IterationEnd(double kFightLength, double kDps);
   void SimulationEnd(long long kSimulationDuration) const;
-  double PassTime(double kFightTimeRemaining);
-  void Tick(double kTime);
-  void SelectedSpellHandler(const std::shared_ptr<Spell>& kSpell,
-                            std::map<std::shared_ptr<Spell>, double>& predicted_damage_of_spells,
-                            double kFightTimeRemaining) const;
-  void CastSelectedSpell(const std::shared_ptr<Spell>& kSpell, double kFightTimeRemaining,
-                         double kPredictedDamage = 0) const;
+  [[nodiscard]] bool ShouldPostDpsValues() const;
+  void PassTime(int kFightEnd);
+  void RunFight(int kFightEnd, int kUntilTick);
+  [[nodiscard]] double GetCurrentFightTime() const;
+  void SelectedSpellHandler(Spell& spell, SpellCandidates& candidates, double kFightTimeRemaining) const;
+  void CastSelectedSpell(Spell& spell, double kFightTimeRemaining, double kPredictedDamage = 0) const;
+
+  // Moves the fight on to the next timer event, or to kFightEnd if there's none before it, and handles every event
+  // that's due then. on_event(kTimer) is called after each one is handled.
+  template <typename TOnEvent>
+  void PassTime(const int kFightEnd, TOnEvent on_event) {
+    const auto kProfilingTimer = ProfilingPhaseTimer(ProfilingPhase::kPassTime);
+    current_tick = std::min(scheduler.NextEventTime(), kFightEnd);
+
+    while (const Timer* kTimer = scheduler.PopEvent(current_tick)) {
+      CountProfilingEvent(ProfilingCounter::kEvents);
+      kTimer->entity->HandleTimer(*kTimer);
+      on_event(*kTimer);
+    }
+  }
+
+  // The main loop: runs the fight that's in progress until kUntilTick, which is its end unless the fight is stopped
+  // part of the way through. on_step() is called once the casts of every step are done and before time passes, and
+  // on_event(kTimer) after every timer event.
+  template <typename TOnStep, typename TOnEvent>
+  void RunFight(const int kFightEnd, const int kUntilTick, TOnStep on_step, TOnEvent on_event) {
+    while (current_tick < kUntilTick) {
+      CastSpells(kFightEnd);
+      on_step();
+      PassTime(kUntilTick, on_event);
+    }
+  }
 };
@@ -0,0 +1,63 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "character_stats.h"
+#include "embind_constant.h"
+#include "items.h"
+#include "profiling.h"
+#include "talents.h"
+
+struct PlayerSettings;
+struct SimulationSettings;
+
+// One of the setups run by a SimulationBatch. Its items, talents and stats replace the ones in the batch's player
+// settings while everything else in the settings is shared by all the variants.
+struct SimulationVariant {
+  std::string name;
+  Items items = Items();
+  Talents talents = Talents();
+  CharacterStats stats;
+  EmbindConstant custom_stat = EmbindConstant::kNormal;
+  int item_id = 0;
+};
+
+struct SimulationVariantResult {
+  std::string name;
+  double median_dps;
+  double min_dps;
+  double max_dps;
+  double mean_dps;
+  double dps_standard_deviation;
+  int iterations; // Fewer than SimulationSettings::iterations if the simulation stopped early
+  double total_fight_duration;
+  double simulation_duration;     // In seconds
+  bool rebuilt_player;            // False if the player built for the previous variant was reused
+  std::vector<double> dps_values; // One per iteration in iteration order if the batch keeps them, see keep_dps_values
+  std::string chrome_trace;       // Of the iterations in the combat log if SimulationSettings::chrome_trace is set
+  ProfilingCounters profiling;    // Only counted when profiling is compiled in, see profiling.h
+};
+
+// Runs several variants of one player with the same random seeds. A variant with the same items and talents as the
+// variant before it reuses that variant's player and only re-derives its stats, so variants that differ only in their
+// stats (e.g. stat weights) build the spells, auras and procs once instead of once per variant.
+//
+// With keep_dps_values and a target standard error the variants are paired instead: they're run side by side (each
+// with its own player) until the standard error of every variant's dps difference to the first variant is below the
+// target, which needs all of them to have the same items and talents.
+struct SimulationBatch {
+  PlayerSettings& settings;
+  const SimulationSettings& kSettings;
+  std::vector<SimulationVariant> variants;
+  bool keep_dps_values = false; // Keep every iteration's dps so that the variants can be paired iteration by iteration
+
+  SimulationBatch(PlayerSettings& player_settings, const SimulationSettings& kSimulationSettings);
+  void AddVariant(const SimulationVariant& kVariant);
+  std::vector<SimulationVariantResult> Start();
+
+private:
+  void ApplyVariant(const SimulationVariant& kVariant);
+  std::vector<SimulationVariantResult> RunInOrder();
+  std::vector<SimulationVariantResult> RunPaired();
+};
@@ -1,8 +1,22 @@
 #pragma once
+#include <cstdint>
 
 struct SimulationSettings {
-  int iterations;
+  int iterations; // The most iterations that are run if target_standard_error is set
   int min_time;
   int max_time;
   SimulationType simulation_type;
+  int threads; // Amount of threads to split the iterations across (native builds only, 0 or 1 runs them serially)
+  RngEngine rng_engine;
+  uint32_t seed = 0; // Every iteration's rng is seeded from this and the iteration's index, see IterationSeed()
+  // Stops the simulation early once the standard error of the mean dps is below this (or of the mean dps difference to
+  // the first variant for a SimulationBatch that pairs its variants, e.g. stat weights). 0 runs all the iterations.
+  double target_standard_error;
+  // The iterations whose events are written to the combat log (if it's written at all, i.e. when simulating the equipped
+  // items): combat_log_iterations of them, starting with combat_log_first_iteration and then every
+  // combat_log_iteration_interval iterations
+  int combat_log_first_iteration = 10;
+  int combat_log_iterations = 1;
+  int combat_log_iteration_interval = 1;
+  bool chrome_trace = false; // Also send the logged iterations as a Chrome trace, see chrome_trace.h
 };
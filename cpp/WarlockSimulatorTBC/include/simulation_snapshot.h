@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+
+#include "character_stats.h"
+#include "derived_stats.h"
+#include "rng.h"
+#include "scheduler.h"
+
+struct AuraState {
+  TimerState duration_timer;
+  TimerState tick_timer;
+  int ticks_remaining;
+  int stacks;
+  bool active;
+};
+
+struct DotState {
+  TimerState tick_timer;
+  int ticks_remaining;
+  double spell_power;
+  double t5_bonus_modifier;
+  bool active;
+  bool applied_with_amplify_curse;
+  bool isb_is_active;
+};
+
+struct SpellState {
+  TimerState cooldown_timer;
+  int amount_of_casts_this_fight;
+  bool casting;
+};
+
+struct TrinketState {
+  TimerState duration_timer;
+  TimerState cooldown_timer;
+  bool active;
+};
+
+// The auras, dots and spells are in the order of the entity's lists of them
+struct EntitySnapshot {
+  CharacterStats stats;
+  int stats_version;
+  TimerState cast_timer;
+  TimerState gcd_timer;
+  TimerState five_second_rule_timer;
+  TimerState mp5_timer;
+  std::vector<AuraState> auras;
+  std::vector<DotState> dots;
+  std::vector<SpellState> spells;
+};
+
+// Everything that changes while a fight is being simulated: the player's and the pet's stats, the state of their
+// auras, dots, spells and trinkets, the rng and the fight clock with the events that are waiting on it. Restoring a
+// snapshot continues the fight from where it was taken, either in the same simulation or in another one whose player
+// was initialized with the same settings. The simulation's results and the combat log aren't part of it.
+struct SimulationSnapshot {
+  int current_tick = 0;
+  std::vector<int> wake_times; // The scheduler's, by slot
+  std::vector<int> orders;
+  EntitySnapshot player{};
+  EntitySnapshot pet{};
+  bool has_pet = false;
+  std::vector<TrinketState> trinkets;
+  Rng rng;
+  DerivedStats derived_stats;
+  double iteration_damage = 0;
+  int power_infusions_ready = 0;
+};
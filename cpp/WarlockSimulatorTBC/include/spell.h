@@ -1,56 +1,47 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <vector>
 
+#include "damage_breakdown.h"
+#include "scheduler.h"
 #include "spell_cast_result.h"
 
 enum class SpellType;
 enum class AttackType;
 enum class SpellSchool;
+enum class SpellId;
 struct DamageOverTime;
 struct Aura;
 struct Entity;
+struct OnHitProc;
+struct OnCritProc;
+struct OnDamageProc;
+struct OnResistProc;
 
 struct Spell {
   virtual ~Spell() = default;
+  // Hot: the state that changes during a fight and the settings that deciding whether and what to cast reads, so that
+  // checks like Ready() and PredictDamage() only touch the first few cache lines of the spell
   Entity& entity;
-  std::shared_ptr<Aura> aura_effect;
-  std::shared_ptr<DamageOverTime> dot_effect;
-  std::vector<std::string> shared_cooldown_spells;
-  SpellSchool spell_school;
-  AttackType attack_type;
-  SpellType spell_type;
-  std::string name;
-  int min_dmg = 0;
-  int max_dmg = 0;
-  double base_damage = 0;
+  Timer cooldown_timer;
+  double cast_time = 0;
+  double mana_cost = 0;
+  double cooldown = 0;
+  int amount_of_casts_this_fight = 0;
+  int amount_of_casts_per_fight = 0;
   bool casting = false;
-  bool can_crit = false;
   bool on_gcd = true;
   bool is_proc = false;
-  bool limited_amount_of_casts = false;
   bool is_non_warlock_ability = false;
-  double coefficient = 0;
-  double cooldown_remaining = 0;
-  double cast_time = 0;
-  double cooldown = 0;
-  double mana_cost = 0;
-  int min_mana_gain = 0;
-  int max_mana_gain = 0;
-  double mana_gain = 0;
-  int amount_of_casts_per_fight = 0;
-  int amount_of_casts_this_fight = 0;
-  int proc_chance = 0;
-  int bonus_damage_from_immolate_min = 0;
-  int bonus_damage_from_immolate_max = 0;
-  double bonus_damage_from_immolate = 0;
-  double bonus_crit_chance = 0;
-  bool does_damage = false;
-  bool is_item = false;
+  bool limited_amount_of_casts = false;
+  bool can_crit = false;
   bool can_miss = false;
-  bool is_finisher = false;
-  bool gain_mana_on_cast = false;
+  bool does_damage = false;
+  SpellId id{};
+  SpellSchool spell_school{};
+  AttackType attack_type{};
+  SpellType spell_type{};
+  int proc_chance = 0;
   bool procs_on_hit = false;
   bool on_hit_procs_enabled = true;
   bool procs_on_crit = false;
@@ -61,9 +52,34 @@ struct Spell {
   bool on_damage_procs_enabled = true;
   bool procs_on_resist = false;
   bool on_resist_procs_enabled = true;
+  Aura* aura_effect = nullptr;
+  DamageOverTime* dot_effect = nullptr;
+  double base_damage = 0;
+  double coefficient = 0;
+  double bonus_crit_chance = 0;
+  double bonus_damage_from_immolate = 0;
+  // Cold: only read when the spell is set up, when it's cast or for the combat log
+  std::string name;
+  std::vector<SpellId> shared_cooldown_spells;
+  std::vector<int> shared_cooldown_spell_indices; // Indices into entity.spell_list, see Entity::SetupSharedCooldowns()
+  // The entity's procs that this spell can trigger, in the order of the entity's lists of them, see Entity::SetupProcs()
+  std::vector<OnHitProc*> on_hit_procs;
+  std::vector<OnCritProc*> on_crit_procs;
+  std::vector<OnDamageProc*> on_damage_procs;
+  std::vector<OnResistProc*> on_resist_procs;
+  int min_dmg = 0;
+  int max_dmg = 0;
+  int min_mana_gain = 0;
+  int max_mana_gain = 0;
+  int bonus_damage_from_immolate_min = 0;
+  int bonus_damage_from_immolate_max = 0;
+  double mana_gain = 0;
+  bool is_item = false;
+  bool is_finisher = false;
+  bool gain_mana_on_cast = false;
 
-  explicit Spell(Entity& entity_param, std::shared_ptr<Aura> aura = nullptr,
-                 std::shared_ptr<DamageOverTime> dot = nullptr);
+  explicit Spell(Entity& entity_param, Aura* aura = nullptr,
+                 DamageOverTime* dot = nullptr);
   virtual void Setup();
   virtual void Cast();
   virtual bool CanCast();
@@ -76,7 +92,7 @@ struct Spell {
   void OnResistProcs();
   void OnDamageProcs();
   void OnHitProcs();
-  void Tick(double kTime);
+  void OnCooldownEnd();
   [[nodiscard]] double GetCritMultiplier(double kEntityCritMultiplier) const;
   double PredictDamage();
   [[nodiscard]] bool HasEnoughMana() const;
@@ -85,7 +101,7 @@ private:
   virtual double GetCooldown();
   virtual void Damage(bool kIsCrit = false, bool kIsGlancing = false);
   [[nodiscard]] double GetManaCost() const;
-  std::vector<double> GetConstantDamage();
+  DamageBreakdown GetConstantDamage();
   SpellCastResult MagicSpellCast();
   [[nodiscard]] SpellCastResult PhysicalSpellCast() const;
   void OnSpellHit(const SpellCastResult& kSpellCastResult);
@@ -132,35 +148,35 @@ struct SeedOfCorruption final : Spell {
 };
 
 struct Corruption final : Spell {
-  explicit Corruption(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  explicit Corruption(Entity& entity_param, Aura* aura, DamageOverTime* dot);
 };
 
 struct UnstableAffliction final : Spell {
-  explicit UnstableAffliction(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  explicit UnstableAffliction(Entity& entity_param, Aura* aura, DamageOverTime* dot);
 };
 
 struct SiphonLife final : Spell {
-  explicit SiphonLife(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  explicit SiphonLife(Entity& entity_param, Aura* aura, DamageOverTime* dot);
 };
 
 struct Immolate final : Spell {
-  explicit Immolate(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  explicit Immolate(Entity& entity_param, Aura* aura, DamageOverTime* dot);
 };
 
 struct CurseOfAgony final : Spell {
-  explicit CurseOfAgony(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  explicit CurseOfAgony(Entity& entity_param, Aura* aura, DamageOverTime* dot);
 };
 
 struct CurseOfTheElements final : Spell {
-  explicit CurseOfTheElements(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit CurseOfTheElements(Entity& entity_param, Aura* aura);
 };
 
 struct CurseOfRecklessness final : Spell {
-  explicit CurseOfRecklessness(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit CurseOfRecklessness(Entity& entity_param, Aura* aura);
 };
 
 struct CurseOfDoom final : Spell {
-  explicit CurseOfDoom(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot);
+  explicit CurseOfDoom(Entity& entity_param, Aura* aura, DamageOverTime* dot);
 };
 
 struct Conflagrate final : Spell {
@@ -170,55 +186,55 @@ struct Conflagrate final : Spell {
 };
 
 struct DestructionPotion final : Spell {
-  explicit DestructionPotion(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit DestructionPotion(Entity& entity_param, Aura* aura);
 };
 
 struct FlameCap final : Spell {
-  explicit FlameCap(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit FlameCap(Entity& entity_param, Aura* aura);
 };
 
 struct BloodFury final : Spell {
-  explicit BloodFury(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit BloodFury(Entity& entity_param, Aura* aura);
 };
 
 struct Bloodlust final : Spell {
-  explicit Bloodlust(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit Bloodlust(Entity& entity_param, Aura* aura);
 };
 
 struct DrumsOfBattle final : Spell {
-  explicit DrumsOfBattle(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit DrumsOfBattle(Entity& entity_param, Aura* aura);
 };
 
 struct DrumsOfWar final : Spell {
-  explicit DrumsOfWar(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit DrumsOfWar(Entity& entity_param, Aura* aura);
 };
 
 struct DrumsOfRestoration final : Spell {
-  explicit DrumsOfRestoration(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit DrumsOfRestoration(Entity& entity_param, Aura* aura);
 };
 
 struct AmplifyCurse final : Spell {
-  explicit AmplifyCurse(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit AmplifyCurse(Entity& entity_param, Aura* aura);
 };
 
 struct PowerInfusion final : Spell {
-  explicit PowerInfusion(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit PowerInfusion(Entity& entity_param, Aura* aura);
 };
 
 struct Innervate final : Spell {
-  explicit Innervate(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit Innervate(Entity& entity_param, Aura* aura);
 };
 
 struct ChippedPowerCore final : Spell {
-  explicit ChippedPowerCore(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit ChippedPowerCore(Entity& entity_param, Aura* aura);
 };
 
 struct CrackedPowerCore final : Spell {
-  explicit CrackedPowerCore(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit CrackedPowerCore(Entity& entity_param, Aura* aura);
 };
 
 struct ManaTideTotem final : Spell {
-  explicit ManaTideTotem(Entity& entity_param, std::shared_ptr<Aura> aura);
+  explicit ManaTideTotem(Entity& entity_param, Aura* aura);
 };
 
 struct PetMelee final : Spell {
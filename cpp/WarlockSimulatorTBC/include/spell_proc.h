@@ -2,6 +2,6 @@
 #include "spell.h"
 
 struct SpellProc : Spell {
-  explicit SpellProc(Entity& entity, std::shared_ptr<Aura> aura = nullptr);
+  explicit SpellProc(Entity& entity, Aura* aura = nullptr);
   virtual bool ShouldProc(Spell* spell);
 };
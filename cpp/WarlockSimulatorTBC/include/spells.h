@@ -4,65 +4,65 @@
 struct Spell;
 
 struct Spells {
-  std::shared_ptr<Spell> life_tap;
-  std::shared_ptr<Spell> seed_of_corruption;
-  std::shared_ptr<Spell> shadow_bolt;
-  std::shared_ptr<Spell> incinerate;
-  std::shared_ptr<Spell> searing_pain;
-  std::shared_ptr<Spell> corruption;
-  std::shared_ptr<Spell> unstable_affliction;
-  std::shared_ptr<Spell> siphon_life;
-  std::shared_ptr<Spell> immolate;
-  std::shared_ptr<Spell> curse_of_agony;
-  std::shared_ptr<Spell> curse_of_the_elements;
-  std::shared_ptr<Spell> curse_of_recklessness;
-  std::shared_ptr<Spell> curse_of_doom;
-  std::shared_ptr<Spell> conflagrate;
-  std::shared_ptr<Spell> shadowburn;
-  std::shared_ptr<Spell> death_coil;
-  std::shared_ptr<Spell> shadowfury;
-  std::shared_ptr<Spell> amplify_curse;
-  std::shared_ptr<Spell> dark_pact;
-  std::shared_ptr<Spell> destruction_potion;
-  std::shared_ptr<Spell> super_mana_potion;
-  std::shared_ptr<Spell> demonic_rune;
-  std::shared_ptr<Spell> flame_cap;
-  std::shared_ptr<Spell> blood_fury;
-  std::shared_ptr<Spell> drums_of_battle;
-  std::shared_ptr<Spell> drums_of_war;
-  std::shared_ptr<Spell> drums_of_restoration;
-  std::shared_ptr<Spell> blade_of_wizardry;
-  std::shared_ptr<Spell> shattered_sun_pendant_of_acumen_aldor;
-  std::shared_ptr<Spell> shattered_sun_pendant_of_acumen_scryers;
-  std::shared_ptr<Spell> robe_of_the_elder_scribes;
-  std::shared_ptr<Spell> mystical_skyfire_diamond;
-  std::shared_ptr<Spell> insightful_earthstorm_diamond;
-  std::shared_ptr<Spell> timbals_focusing_crystal;
-  std::shared_ptr<Spell> mark_of_defiance;
-  std::shared_ptr<Spell> the_lightning_capacitor;
-  std::shared_ptr<Spell> quagmirrans_eye;
-  std::shared_ptr<Spell> shiffars_nexus_horn;
-  std::shared_ptr<Spell> sextant_of_unstable_currents;
-  std::shared_ptr<Spell> band_of_the_eternal_sage;
-  std::shared_ptr<Spell> chipped_power_core;
-  std::shared_ptr<Spell> cracked_power_core;
-  std::shared_ptr<Spell> mana_tide_totem;
-  std::shared_ptr<Spell> judgement_of_wisdom;
-  std::shared_ptr<Spell> flameshadow;
-  std::shared_ptr<Spell> shadowflame;
-  std::shared_ptr<Spell> spellstrike;
-  std::shared_ptr<Spell> mana_etched_4_set;
-  std::shared_ptr<Spell> ashtongue_talisman_of_shadows;
-  std::shared_ptr<Spell> wrath_of_cenarius;
-  std::shared_ptr<Spell> darkmoon_card_crusade;
-  std::shared_ptr<Spell> eye_of_magtheridon;
-  std::shared_ptr<Spell> improved_shadow_bolt;
-  std::shared_ptr<Spell> melee;
-  std::shared_ptr<Spell> firebolt;
-  std::shared_ptr<Spell> lash_of_pain;
-  std::shared_ptr<Spell> cleave;
-  std::shared_ptr<Spell> demonic_frenzy;
-  std::vector<std::shared_ptr<Spell>> power_infusion;
-  std::vector<std::shared_ptr<Spell>> bloodlust;
-  std::vector<std::shared_ptr<Spell>> innervate;
+  Spell* life_tap = nullptr;
+  Spell* seed_of_corruption = nullptr;
+  Spell* shadow_bolt = nullptr;
+  Spell* incinerate = nullptr;
+  Spell* searing_pain = nullptr;
+  Spell* corruption = nullptr;
+  Spell* unstable_affliction = nullptr;
+  Spell* siphon_life = nullptr;
+  Spell* immolate = nullptr;
+  Spell* curse_of_agony = nullptr;
+  Spell* curse_of_the_elements = nullptr;
+  Spell* curse_of_recklessness = nullptr;
+  Spell* curse_of_doom = nullptr;
+  Spell* conflagrate = nullptr;
+  Spell* shadowburn = nullptr;
+  Spell* death_coil = nullptr;
+  Spell* shadowfury = nullptr;
+  Spell* amplify_curse = nullptr;
+  Spell* dark_pact = nullptr;
+  Spell* destruction_potion = nullptr;
+  Spell* super_mana_potion = nullptr;
+  Spell* demonic_rune = nullptr;
+  Spell* flame_cap = nullptr;
+  Spell* blood_fury = nullptr;
+  Spell* drums_of_battle = nullptr;
+  Spell* drums_of_war = nullptr;
+  Spell* drums_of_restoration = nullptr;
+  Spell* blade_of_wizardry = nullptr;
+  Spell* shattered_sun_pendant_of_acumen_aldor = nullptr;
+  Spell* shattered_sun_pendant_of_acumen_scryers = nullptr;
+  Spell* robe_of_the_elder_scribes = nullptr;
+  Spell* mystical_skyfire_diamond = nullptr;
+  Spell* insightful_earthstorm_diamond = nullptr;
+  Spell* timbals_focusing_crystal = nullptr;
+  Spell* mark_of_defiance = nullptr;
+  Spell* the_lightning_capacitor = nullptr;
+  Spell* quagmirrans_eye = nullptr;
+  Spell* shiffars_nexus_horn = nullptr;
+  Spell* sextant_of_unstable_currents = nullptr;
+  Spell* band_of_the_eternal_sage = nullptr;
+  Spell* chipped_power_core = nullptr;
+  Spell* cracked_power_core = nullptr;
+  Spell* mana_tide_totem = nullptr;
+  Spell* judgement_of_wisdom = nullptr;
+  Spell* flameshadow = nullptr;
+  Spell* shadowflame = nullptr;
+  Spell* spellstrike = nullptr;
+  Spell* mana_etched_4_set = nullptr;
+  Spell* ashtongue_talisman_of_shadows = nullptr;
+  Spell* wrath_of_cenarius = nullptr;
+  Spell* darkmoon_card_crusade = nullptr;
+  Spell* eye_of_magtheridon = nullptr;
+  Spell* improved_shadow_bolt = nullptr;
+  Spell* melee = nullptr;
+  Spell* firebolt = nullptr;
+  Spell* lash_of_pain = nullptr;
+  Spell* cleave = nullptr;
+  Spell* demonic_frenzy = nullptr;
+  std::vector<Spell*> power_infusion;
+  std::vector<Spell*> bloodlust;
+  std::vector<Spell*> innervate;
 };
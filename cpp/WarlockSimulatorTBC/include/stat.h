@@ -1,24 +1,47 @@
 #pragma once
+#include <cstdint>
+#include <vector>
+
 #include "enums.h"
 
 struct Entity;
 
+// The CharacterStats field that a Stat modifies. Whether it's added or multiplied, its name and how many decimals the
+// combat log shows are looked up from it in stat.cc so that a Stat doesn't have to carry them around.
+enum class StatField : uint8_t {
+  kSpellPower,
+  kShadowPower,
+  kFirePower,
+  kSpellHasteRating,
+  kSpellHastePercent,
+  kMeleeHastePercent,
+  kManaCostModifier,
+  kSpellCritChance,
+  kSpellCritRating,
+  kAttackPower,
+  kAttackPowerModifier,
+};
+
 struct Stat {
   Entity& entity;
-  double& character_stat;
-  CalculationType calculation_type = CalculationType::kNoType;
-  std::string name;
   double value;
-  int combat_log_decimal_places = 0;
+  StatField field;
 
-  Stat(Entity& entity_param, double& character_stat, double kValue);
+  Stat(Entity& entity_param, StatField kField, double kValue);
   void AddStat() const;
   void RemoveStat(int kStacks = 1) const;
+  // Applies every stat of the list and then bumps the stats version of the entities they modify once, see AddStats()
+  static void ModifyStats(const std::vector<Stat>& kStats, bool kRemoving, int kStacks = 1);
 
 private:
-  void ModifyStat(const std::string& kAction, int kStacks = 1) const;
+  // Changes the stat without bumping Entity::stats_version, which is left to the caller
+  void ModifyStat(bool kRemoving, int kStacks = 1) const;
 };
 
+// Add or remove all of an aura's or a trinket's stats as one change to the entities' stats
+void AddStats(const std::vector<Stat>& kStats);
+void RemoveStats(const std::vector<Stat>& kStats, int kStacks = 1);
+
 struct SpellPower : Stat {
   SpellPower(Entity& entity_param, double kValue);
 };
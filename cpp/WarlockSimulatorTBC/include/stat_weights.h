@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "embind_constant.h"
+
+struct PlayerSettings;
+struct SimulationSettings;
+
+struct StatWeight {
+  EmbindConstant stat;
+  std::string name;
+  double amount;              // The amount of the stat that was added, negative if it was removed to stay at the hit cap
+  double dps_difference;      // Mean of the per-iteration dps differences to the unmodified player
+  double weight;              // Dps per point of the stat
+  double confidence_interval; // Half-width of the 95% confidence interval of the weight
+  int iterations;             // Fewer than SimulationSettings::iterations if the weights converged early
+};
+
+// Simulates the player once unmodified and once per stat with kAmount of the stat added. Every run uses the same
+// per-iteration random seeds, so iteration i of a stat's run sees the same fight length and rolls as iteration i of
+// the unmodified run and the weights come from the paired per-iteration differences, which vary far less than the dps
+// of two independent runs does. With a target standard error the runs stop once the standard error of every stat's mean
+// dps difference is below it.
+std::vector<StatWeight> CalculateStatWeights(PlayerSettings& settings, const SimulationSettings& kSimulationSettings,
+                                             double kAmount = 100);
@@ -44,4 +44,6 @@ struct Talents {
   int conflagrate;
   int shadow_and_flame;
   int shadowfury;
+
+  bool operator==(const Talents&) const = default;
 };
\ No newline at end of file
@@ -2,19 +2,23 @@
 #include <string>
 #include <vector>
 
+#include "scheduler.h"
+
 struct Stat;
 struct Player;
+enum class SpellId;
 
 struct Trinket {
   Player& player;
   std::vector<Stat> stats;
   int duration = 0;
-  double duration_remaining = 0;
+  Timer duration_timer;
   int cooldown = 0;
-  double cooldown_remaining = 0;
+  Timer cooldown_timer;
   bool active = false;
   bool shares_cooldown = true;
   std::string name;
+  SpellId id{};
 
   explicit Trinket(Player& player);
   [[nodiscard]] bool Ready() const;
@@ -22,7 +26,7 @@ struct Trinket {
   void Setup();
   void Use();
   void Fade();
-  void Tick(double kTime);
+  void OnCooldownEnd() const;
 };
 
 struct RestrainedEssenceOfSapphiron : Trinket {
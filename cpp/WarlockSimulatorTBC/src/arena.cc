@@ -0,0 +1,27 @@
+#include "../include/arena.h"
+
+#include <algorithm>
+
+// Destroys the objects in the reverse order of their creation like the members of a class
+Arena::~Arena() {
+  for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+    it->destroy(it->object);
+  }
+}
+
+void* Arena::Allocate(const size_t kSize, const size_t kAlignment) {
+  void* pointer = free_space;
+
+  if (std::align(kAlignment, kSize, pointer, free_space_size) == nullptr) {
+    // Objects bigger than a block get a block of their own
+    const size_t kNewBlockSize = std::max(kBlockSize, kSize + kAlignment);
+    blocks.push_back(std::make_unique<std::byte[]>(kNewBlockSize));
+    pointer = blocks.back().get();
+    free_space_size = kNewBlockSize;
+    std::align(kAlignment, kSize, pointer, free_space_size);
+  }
+
+  free_space = static_cast<std::byte*>(pointer) + kSize;
+  free_space_size -= kSize;
+  return pointer;
+}
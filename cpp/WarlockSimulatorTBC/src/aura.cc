@@ -10,42 +10,40 @@
 #include "../include/talents.h"
 #include "../include/pet.h"
 #include "../include/player_settings.h"
+#include "../include/profiling.h"
 
 Aura::Aura(Entity& entity_param)
   : entity(entity_param) {
 }
 
 void Aura::Setup() {
-  if (entity.recording_combat_log_breakdown && !entity.combat_log_breakdown.contains(name)) {
-    entity.combat_log_breakdown.insert({name, std::make_shared<CombatLogBreakdown>(name)});
+  if (entity.recording_combat_log_breakdown) {
+    entity.AddCombatLogBreakdown(id, name);
   }
 
+  duration_timer.Register(entity, TimerType::kAuraDuration, static_cast<int>(entity.aura_list.size()));
+  tick_timer.Register(entity, TimerType::kAuraTick, static_cast<int>(entity.aura_list.size()));
   entity.aura_list.push_back(this);
 }
 
-void Aura::Tick(const double kTime) {
-  if (has_duration) {
-    duration_remaining -= kTime;
-    if (duration_remaining <= 0) {
-      Fade();
-    }
-  }
+// Called when tick_timer runs out, which only auras that tick such as ManaOverTime start
+void Aura::Tick() {
 }
 
 void Aura::Apply() {
+  CountProfilingEvent(ProfilingCounter::kAuraApplications);
+
   if (active && entity.ShouldWriteToCombatLog() && stacks == max_stacks) {
-    entity.CombatLog(name + " refreshed");
+    entity.CombatLog({.type = CombatLogEventType::kAuraRefreshed, .id = id, .name = &name});
   } else if (!active) {
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->applied_at = entity.simulation->current_fight_time;
+      entity.GetCombatLogBreakdown(id).applied_at = entity.simulation->GetCurrentFightTime();
     }
 
-    for (auto& stat : stats) {
-      stat.AddStat();
-    }
+    AddStats(stats);
 
     if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(name + " applied");
+      entity.CombatLog({.type = CombatLogEventType::kAuraApplied, .id = id, .name = &name});
     }
 
     active = true;
@@ -55,19 +53,19 @@ void Aura::Apply() {
     stacks++;
 
     if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(name + " (" + std::to_string(stacks) + ")");
+      entity.CombatLog({.type = CombatLogEventType::kAuraStacks, .id = id, .name = &name, .values = {1.0 * stacks}});
     }
 
-    for (auto& stat : stats_per_stack) {
-      stat.AddStat();
-    }
+    AddStats(stats_per_stack);
   }
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->count++;
+    entity.GetCombatLogBreakdown(id).count++;
   }
 
-  duration_remaining = duration;
+  if (has_duration) {
+    duration_timer.Start(duration);
+  }
 }
 
 void Aura::Fade() {
@@ -75,25 +73,23 @@ void Aura::Fade() {
     entity.player->ThrowError("Attempting to fade " + name + " when it isn't active");
   }
 
-  for (auto& stat : stats) {
-    stat.RemoveStat();
-  }
+  RemoveStats(stats);
 
   if (entity.ShouldWriteToCombatLog()) {
-    entity.CombatLog(name + " faded");
+    entity.CombatLog({.type = CombatLogEventType::kAuraFaded, .id = id, .name = &name});
   }
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->uptime +=
-        entity.simulation->current_fight_time - entity.combat_log_breakdown.at(name)->applied_at;
+    entity.GetCombatLogBreakdown(id).uptime +=
+        entity.simulation->GetCurrentFightTime() - entity.GetCombatLogBreakdown(id).applied_at;
   }
 
   if (stacks > 0) {
-    for (auto& stat : stats_per_stack) {
-      stat.RemoveStat(stacks);
-    }
+    RemoveStats(stats_per_stack, stacks);
   }
 
+  duration_timer.Stop();
+  tick_timer.Stop();
   active = false;
   stacks = 0;
 }
@@ -104,6 +100,7 @@ void Aura::DecrementStacks() {
 ImprovedShadowBoltAura::ImprovedShadowBoltAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kImprovedShadowBolt;
+  id = SpellId::kImprovedShadowBolt;
   duration = 12;
   max_stacks = 4;
   modifier = 1 + entity_param.player->talents.improved_shadow_bolt * 0.04;
@@ -121,13 +118,14 @@ void ImprovedShadowBoltAura::DecrementStacks() {
   if (stacks <= 0) {
     Fade();
   } else if (entity.ShouldWriteToCombatLog()) {
-    entity.CombatLog(name + " (" + std::to_string(stacks) + ")");
+    entity.CombatLog({.type = CombatLogEventType::kAuraStacks, .id = id, .name = &name, .values = {1.0 * stacks}});
   }
 }
 
 CurseOfTheElementsAura::CurseOfTheElementsAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kCurseOfTheElements;
+  id = SpellId::kCurseOfTheElements;
   duration = 300;
   Aura::Setup();
 }
@@ -135,6 +133,7 @@ CurseOfTheElementsAura::CurseOfTheElementsAura(Entity& entity_param)
 CurseOfRecklessnessAura::CurseOfRecklessnessAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kCurseOfRecklessness;
+  id = SpellId::kCurseOfRecklessness;
   duration = 120;
   Aura::Setup();
 }
@@ -142,6 +141,7 @@ CurseOfRecklessnessAura::CurseOfRecklessnessAura(Entity& entity_param)
 ShadowTranceAura::ShadowTranceAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kNightfall;
+  id = SpellId::kNightfall;
   duration = 10;
   Aura::Setup();
 }
@@ -149,6 +149,7 @@ ShadowTranceAura::ShadowTranceAura(Entity& entity_param)
 FlameshadowAura::FlameshadowAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kFlameshadow;
+  id = SpellId::kFlameshadow;
   duration = 15;
   stats.push_back(ShadowPower(entity_param, 135));
   Aura::Setup();
@@ -157,6 +158,7 @@ FlameshadowAura::FlameshadowAura(Entity& entity_param)
 ShadowflameAura::ShadowflameAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kShadowflame;
+  id = SpellId::kShadowflame;
   duration = 15;
   stats.push_back(FirePower(entity_param, 135));
   Aura::Setup();
@@ -165,6 +167,7 @@ ShadowflameAura::ShadowflameAura(Entity& entity_param)
 SpellstrikeAura::SpellstrikeAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kSpellstrike;
+  id = SpellId::kSpellstrike;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 92));
   Aura::Setup();
@@ -173,6 +176,7 @@ SpellstrikeAura::SpellstrikeAura(Entity& entity_param)
 PowerInfusionAura::PowerInfusionAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kPowerInfusion;
+  id = SpellId::kPowerInfusion;
   duration = 15;
   stats.push_back(SpellHastePercent(entity_param, 1.2));
   stats.push_back(ManaCostModifier(entity_param, 0.8));
@@ -182,6 +186,7 @@ PowerInfusionAura::PowerInfusionAura(Entity& entity_param)
 EyeOfMagtheridonAura::EyeOfMagtheridonAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kEyeOfMagtheridon;
+  id = SpellId::kEyeOfMagtheridon;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 170));
   Aura::Setup();
@@ -190,6 +195,7 @@ EyeOfMagtheridonAura::EyeOfMagtheridonAura(Entity& entity_param)
 SextantOfUnstableCurrentsAura::SextantOfUnstableCurrentsAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kSextantOfUnstableCurrents;
+  id = SpellId::kSextantOfUnstableCurrents;
   duration = 15;
   stats.push_back(SpellPower(entity_param, 190));
   Aura::Setup();
@@ -198,6 +204,7 @@ SextantOfUnstableCurrentsAura::SextantOfUnstableCurrentsAura(Entity& entity_para
 QuagmirransEyeAura::QuagmirransEyeAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kQuagmirransEye;
+  id = SpellId::kQuagmirransEye;
   duration = 6;
   stats.push_back(SpellHasteRating(entity_param, 320));
   Aura::Setup();
@@ -206,6 +213,7 @@ QuagmirransEyeAura::QuagmirransEyeAura(Entity& entity_param)
 ShiffarsNexusHornAura::ShiffarsNexusHornAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kShiffarsNexusHorn;
+  id = SpellId::kShiffarsNexusHorn;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 225));
   Aura::Setup();
@@ -214,6 +222,7 @@ ShiffarsNexusHornAura::ShiffarsNexusHornAura(Entity& entity_param)
 ManaEtched4SetAura::ManaEtched4SetAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kManaEtched4Set;
+  id = SpellId::kManaEtched4Set;
   duration = 15;
   stats.push_back(SpellPower(entity_param, 110));
   Aura::Setup();
@@ -222,6 +231,7 @@ ManaEtched4SetAura::ManaEtched4SetAura(Entity& entity_param)
 DestructionPotionAura::DestructionPotionAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kDestructionPotion;
+  id = SpellId::kDestructionPotion;
   duration = 15;
   stats.push_back(SpellPower(entity_param, 120));
   stats.push_back(SpellCritChance(entity_param, 2));
@@ -231,6 +241,7 @@ DestructionPotionAura::DestructionPotionAura(Entity& entity_param)
 FlameCapAura::FlameCapAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kFlameCap;
+  id = SpellId::kFlameCap;
   duration = 60;
   stats.push_back(FirePower(entity_param, 80));
   Aura::Setup();
@@ -239,6 +250,7 @@ FlameCapAura::FlameCapAura(Entity& entity_param)
 BloodFuryAura::BloodFuryAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kBloodFury;
+  id = SpellId::kBloodFury;
   duration = 15;
   stats.push_back(SpellPower(entity_param, 140));
   Aura::Setup();
@@ -247,6 +259,7 @@ BloodFuryAura::BloodFuryAura(Entity& entity_param)
 BloodlustAura::BloodlustAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kBloodlust;
+  id = SpellId::kBloodlust;
   duration = 40;
   group_wide = true;
   stats.push_back(SpellHastePercent(entity_param, 1.3));
@@ -260,6 +273,7 @@ BloodlustAura::BloodlustAura(Entity& entity_param)
 DrumsOfBattleAura::DrumsOfBattleAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kDrumsOfBattle;
+  id = SpellId::kDrumsOfBattle;
   duration = 30;
   group_wide = true;
   stats.push_back(SpellHasteRating(entity_param, 80));
@@ -269,6 +283,7 @@ DrumsOfBattleAura::DrumsOfBattleAura(Entity& entity_param)
 DrumsOfWarAura::DrumsOfWarAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kDrumsOfWar;
+  id = SpellId::kDrumsOfWar;
   duration = 30;
   group_wide = true;
   stats.push_back(SpellPower(entity_param, 30));
@@ -278,6 +293,7 @@ DrumsOfWarAura::DrumsOfWarAura(Entity& entity_param)
 AshtongueTalismanOfShadowsAura::AshtongueTalismanOfShadowsAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kAshtongueTalismanOfShadows;
+  id = SpellId::kAshtongueTalismanOfShadows;
   duration = 5;
   stats.push_back(SpellPower(entity_param, 220));
   Aura::Setup();
@@ -286,6 +302,7 @@ AshtongueTalismanOfShadowsAura::AshtongueTalismanOfShadowsAura(Entity& entity_pa
 DarkmoonCardCrusadeAura::DarkmoonCardCrusadeAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kDarkmoonCardCrusade;
+  id = SpellId::kDarkmoonCardCrusade;
   duration = 10;
   max_stacks = 10;
   stats_per_stack.push_back(SpellPower(entity_param, 8));
@@ -295,6 +312,7 @@ DarkmoonCardCrusadeAura::DarkmoonCardCrusadeAura(Entity& entity_param)
 TheLightningCapacitorAura::TheLightningCapacitorAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kTheLightningCapacitor;
+  id = SpellId::kTheLightningCapacitor;
   has_duration = false;
   max_stacks = 3;
   Aura::Setup();
@@ -303,6 +321,7 @@ TheLightningCapacitorAura::TheLightningCapacitorAura(Entity& entity_param)
 BandOfTheEternalSageAura::BandOfTheEternalSageAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kBandOfTheEternalSage;
+  id = SpellId::kBandOfTheEternalSage;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 95));
   Aura::Setup();
@@ -311,6 +330,7 @@ BandOfTheEternalSageAura::BandOfTheEternalSageAura(Entity& entity_param)
 BladeOfWizardryAura::BladeOfWizardryAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kBladeOfWizardry;
+  id = SpellId::kBladeOfWizardry;
   duration = 6;
   stats.push_back(SpellHasteRating(entity_param, 280));
   Aura::Setup();
@@ -319,6 +339,7 @@ BladeOfWizardryAura::BladeOfWizardryAura(Entity& entity_param)
 ShatteredSunPendantOfAcumenAldorAura::ShatteredSunPendantOfAcumenAldorAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kShatteredSunPendantOfAcumenAldor;
+  id = SpellId::kShatteredSunPendantOfAcumenAldor;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 120));
   Aura::Setup();
@@ -327,6 +348,7 @@ ShatteredSunPendantOfAcumenAldorAura::ShatteredSunPendantOfAcumenAldorAura(Entit
 RobeOfTheElderScribesAura::RobeOfTheElderScribesAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kRobeOfTheElderScribes;
+  id = SpellId::kRobeOfTheElderScribes;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 130));
   Aura::Setup();
@@ -335,6 +357,7 @@ RobeOfTheElderScribesAura::RobeOfTheElderScribesAura(Entity& entity_param)
 MysticalSkyfireDiamondAura::MysticalSkyfireDiamondAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kMysticalSkyfireDiamond;
+  id = SpellId::kMysticalSkyfireDiamond;
   duration = 4;
   stats.push_back(SpellHasteRating(entity_param, 320));
   Aura::Setup();
@@ -343,6 +366,7 @@ MysticalSkyfireDiamondAura::MysticalSkyfireDiamondAura(Entity& entity_param)
 AmplifyCurseAura::AmplifyCurseAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kAmplifyCurse;
+  id = SpellId::kAmplifyCurse;
   duration = 30;
   Aura::Setup();
 }
@@ -350,6 +374,7 @@ AmplifyCurseAura::AmplifyCurseAura(Entity& entity_param)
 WrathOfCenariusAura::WrathOfCenariusAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kWrathOfCenarius;
+  id = SpellId::kWrathOfCenarius;
   duration = 10;
   stats.push_back(SpellPower(entity_param, 132));
   Aura::Setup();
@@ -358,6 +383,7 @@ WrathOfCenariusAura::WrathOfCenariusAura(Entity& entity_param)
 InnervateAura::InnervateAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kInnervate;
+  id = SpellId::kInnervate;
   duration = 20;
   Aura::Setup();
 }
@@ -365,6 +391,7 @@ InnervateAura::InnervateAura(Entity& entity_param)
 ChippedPowerCoreAura::ChippedPowerCoreAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kChippedPowerCore;
+  id = SpellId::kChippedPowerCore;
   duration = 30;
   stats.push_back(SpellPower(entity_param, 25));
   Aura::Setup();
@@ -373,6 +400,7 @@ ChippedPowerCoreAura::ChippedPowerCoreAura(Entity& entity_param)
 CrackedPowerCoreAura::CrackedPowerCoreAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kCrackedPowerCore;
+  id = SpellId::kCrackedPowerCore;
   duration = 30;
   stats.push_back(SpellPower(entity_param, 15));
   Aura::Setup();
@@ -381,6 +409,7 @@ CrackedPowerCoreAura::CrackedPowerCoreAura(Entity& entity_param)
 AirmansRibbonOfGallantryAura::AirmansRibbonOfGallantryAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kAirmansRibbonOfGallantry;
+  id = SpellId::kAirmansRibbonOfGallantry;
   duration = 30;  // should maybe lower this to 25 or so for more realism
   stats.push_back(SpellPower(entity_param, 80));
   Aura::Setup();
@@ -389,6 +418,7 @@ AirmansRibbonOfGallantryAura::AirmansRibbonOfGallantryAura(Entity& entity_param)
 DemonicFrenzyAura::DemonicFrenzyAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kDemonicFrenzy;
+  id = SpellId::kDemonicFrenzy;
   duration = 10;
   max_stacks = 10;
   Aura::Setup();
@@ -397,6 +427,7 @@ DemonicFrenzyAura::DemonicFrenzyAura(Entity& entity_param)
 BlackBookAura::BlackBookAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kBlackBook;
+  id = SpellId::kBlackBook;
   duration = 30;
   stats.push_back(SpellPower(entity_param, 200));
   stats.push_back(AttackPower(entity_param, 325));
@@ -406,6 +437,7 @@ BlackBookAura::BlackBookAura(Entity& entity_param)
 BattleSquawkAura::BattleSquawkAura(Entity& entity_param)
   : Aura(entity_param) {
   name = SpellName::kBattleSquawk;
+  id = SpellId::kBattleSquawk;
   duration = 300;
   stats.push_back(MeleeHastePercent(entity_param, std::pow(1.05, entity_param.player->settings.battle_squawk_amount)));
   Aura::Setup();
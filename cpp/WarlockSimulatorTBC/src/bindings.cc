@@ -7,6 +7,8 @@
 #include "../include/talents.h"
 #include "../include/player_settings.h"
 #include "../include/simulation.h"
+#include "../include/simulation_batch.h"
+#include "../include/stat_weights.h"
 #include "../include/aura_selection.h"
 #include "../include/sets.h"
 #include "../include/trinket.h"
@@ -58,7 +60,21 @@ void CombatLogUpdate(const char* combat_log_entry) {
 #ifdef EMSCRIPTEN
   EM_ASM({postMessage({event : "combatLogUpdate", data : {combatLogEntry : UTF8ToString($0)}})}, combat_log_entry);
 #else
-  std::cout << combat_log_entry << std::endl;
+  std::cerr << combat_log_entry << std::endl;
+#endif
+}
+
+// The native build writes the trace from the SimulationVariantResult instead, see test/main.cc
+void ChromeTraceUpdate(const char* chrome_trace) {
+#ifdef EMSCRIPTEN
+  EM_ASM({postMessage({event : "chromeTrace", data : {chromeTrace : UTF8ToString($0)}})}, chrome_trace);
+#endif
+}
+
+// The native build prints the counters from the SimulationVariantResult instead, see test/main.cc
+void SendProfilingCounters(const char* profiling_counters) {
+#ifdef EMSCRIPTEN
+  EM_ASM({postMessage({event : "profilingCounters", data : JSON.parse(UTF8ToString($0))})}, profiling_counters);
 #endif
 }
 
@@ -92,24 +108,14 @@ void SendSimulationResults(double median_dps, double min_dps, double max_dps, in
          })},
          median_dps, min_dps, max_dps, item_id, iteration_amount, total_fight_duration, custom_stat);
 #else
-  std::cout << "Median DPS: " << std::to_string(median_dps) << ". Min DPS: " << std::to_string(min_dps)
+  // Native builds keep stdout for the warlock_sim results
+  std::cerr << "Median DPS: " << std::to_string(median_dps) << ". Min DPS: " << std::to_string(min_dps)
       << ". Max DPS: " << std::to_string(max_dps) << std::endl;
-  std::cout << std::to_string(iteration_amount) << " iterations in "
+  std::cerr << std::to_string(iteration_amount) << " iterations in "
       << DoubleToString(round(simulation_duration / 1000) / 1000, 3) << " seconds" << std::endl;
 #endif
 }
 
-std::vector<uint32_t> AllocRandomSeeds(const int kAmountOfSeeds, const uint32_t kRandSeed) {
-  srand(kRandSeed);
-  std::vector<uint32_t> seeds(kAmountOfSeeds);
-
-  for (int i = 0; i < kAmountOfSeeds; i++) {
-    seeds[i] = rand();
-  }
-
-  return seeds;
-}
-
 Items AllocItems() { return {}; }
 
 AuraSelection AllocAuras() { return {}; }
@@ -145,6 +151,43 @@ EMSCRIPTEN_BINDINGS(module) {
       .constructor<Player&, SimulationSettings&>()
       .function("start", &Simulation::Start);
 
+  emscripten::class_<SimulationVariant>("SimulationVariant")
+      .constructor<>()
+      .property("name", &SimulationVariant::name)
+      .property("items", &SimulationVariant::items)
+      .property("talents", &SimulationVariant::talents)
+      .property("stats", &SimulationVariant::stats)
+      .property("customStat", &SimulationVariant::custom_stat)
+      .property("itemId", &SimulationVariant::item_id);
+
+  emscripten::value_object<SimulationVariantResult>("SimulationVariantResult")
+      .field("name", &SimulationVariantResult::name)
+      .field("medianDps", &SimulationVariantResult::median_dps)
+      .field("minDps", &SimulationVariantResult::min_dps)
+      .field("maxDps", &SimulationVariantResult::max_dps)
+      .field("meanDps", &SimulationVariantResult::mean_dps)
+      .field("dpsStandardDeviation", &SimulationVariantResult::dps_standard_deviation)
+      .field("iterations", &SimulationVariantResult::iterations)
+      .field("totalDuration", &SimulationVariantResult::total_fight_duration)
+      .field("simulationDuration", &SimulationVariantResult::simulation_duration)
+      .field("rebuiltPlayer", &SimulationVariantResult::rebuilt_player)
+      .field("chromeTrace", &SimulationVariantResult::chrome_trace);
+
+  emscripten::class_<SimulationBatch>("SimulationBatch")
+      .constructor<PlayerSettings&, SimulationSettings&>()
+      .property("keepDpsValues", &SimulationBatch::keep_dps_values)
+      .function("addVariant", &SimulationBatch::AddVariant)
+      .function("start", &SimulationBatch::Start);
+
+  emscripten::value_object<StatWeight>("StatWeight")
+      .field("stat", &StatWeight::stat)
+      .field("name", &StatWeight::name)
+      .field("amount", &StatWeight::amount)
+      .field("dpsDifference", &StatWeight::dps_difference)
+      .field("weight", &StatWeight::weight)
+      .field("confidenceInterval", &StatWeight::confidence_interval)
+      .field("iterations", &StatWeight::iterations);
+
   emscripten::class_<Items>("Items")
       .property("head", &Items::head)
       .property("neck", &Items::neck)
@@ -315,7 +358,6 @@ EMSCRIPTEN_BINDINGS(module) {
 
   emscripten::class_<PlayerSettings>("PlayerSettings")
       .constructor<AuraSelection&, Talents&, Sets&, CharacterStats&, Items&>()
-      .property("randomSeeds", &PlayerSettings::random_seeds)
       .property("itemId", &PlayerSettings::item_id)
       .property("metaGemId", &PlayerSettings::meta_gem_id)
       .property("equippedItemSimulation", &PlayerSettings::equipped_item_simulation)
@@ -383,13 +425,27 @@ EMSCRIPTEN_BINDINGS(module) {
       .property("iterations", &SimulationSettings::iterations)
       .property("minTime", &SimulationSettings::min_time)
       .property("maxTime", &SimulationSettings::max_time)
-      .property("simulationType", &SimulationSettings::simulation_type);
+      .property("simulationType", &SimulationSettings::simulation_type)
+      .property("threads", &SimulationSettings::threads)
+      .property("rngEngine", &SimulationSettings::rng_engine)
+      .property("seed", &SimulationSettings::seed)
+      .property("targetStandardError", &SimulationSettings::target_standard_error)
+      .property("combatLogFirstIteration", &SimulationSettings::combat_log_first_iteration)
+      .property("combatLogIterations", &SimulationSettings::combat_log_iterations)
+      .property("combatLogIterationInterval", &SimulationSettings::combat_log_iteration_interval)
+      .property("chromeTrace", &SimulationSettings::chrome_trace);
 
   emscripten::enum_<SimulationType>("SimulationType")
       .value("normal", SimulationType::kNormal)
       .value("allItems", SimulationType::kAllItems)
       .value("statWeights", SimulationType::kStatWeights);
 
+  emscripten::enum_<RngEngine>("RngEngine")
+      .value("xoshiro256PlusPlus", RngEngine::kXoshiro256PlusPlus)
+      .value("mersenneTwister", RngEngine::kMersenneTwister)
+      .value("pcg32", RngEngine::kPcg32)
+      .value("philox", RngEngine::kPhilox);
+
   emscripten::enum_<EmbindConstant>("EmbindConstant")
       .value("aldor", EmbindConstant::kAldor)
       .value("scryers", EmbindConstant::kScryers)
@@ -422,7 +478,6 @@ EMSCRIPTEN_BINDINGS(module) {
       .value("passive", EmbindConstant::kPassive)
       .value("aggressive", EmbindConstant::kAggressive);
 
-  emscripten::function("allocRandomSeeds", &AllocRandomSeeds);
   emscripten::function("allocItems", &AllocItems);
   emscripten::function("allocAuras", &AllocAuras);
   emscripten::function("allocTalents", &AllocTalents);
@@ -433,8 +488,10 @@ EMSCRIPTEN_BINDINGS(module) {
   emscripten::function("allocSimSettings", &AllocSimSettings);
   emscripten::function("allocSim", &AllocSim);
   emscripten::function("getExceptionMessage", &GetExceptionMessage);
+  emscripten::function("calculateStatWeights", &CalculateStatWeights);
 
-  emscripten::register_vector<uint32_t>("vector<uint32_t>");
+  emscripten::register_vector<SimulationVariantResult>("vector<SimulationVariantResult>");
+  emscripten::register_vector<StatWeight>("vector<StatWeight>");
 }
 #endif
 
@@ -0,0 +1,196 @@
+#include "../include/chrome_trace.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../include/combat_log.h"
+#include "../include/entity.h"
+#include "../include/enums.h"
+#include "../include/scheduler.h"
+
+namespace {
+constexpr long long kMicrosecondsPerTick = 1000000 / kTicksPerSecond;
+
+std::string EscapeJson(const std::string& kString) {
+  std::string escaped;
+
+  for (const char kCharacter : kString) {
+    if (kCharacter == '"' || kCharacter == '\\') {
+      escaped += '\\';
+    }
+
+    escaped += kCharacter;
+  }
+
+  return escaped;
+}
+
+// Turns the combat log's events into trace events one iteration at a time. Slices that have an event for their end
+// (casts, auras, dots and trinkets) are kept open until it comes and the ones that are still open when the iteration
+// ends are cut off at its last event. GCDs and swings are written out right away since their length is known.
+struct ChromeTraceWriter {
+  struct OpenSlice {
+    const char* category;
+    const std::string* name;
+    int start;
+  };
+
+  std::vector<std::string> trace_events;
+  std::map<std::pair<const Entity*, std::string>, int> track_ids;
+  std::vector<std::string> track_names;        // By track id
+  std::vector<bool> used_tracks;               // In the current iteration, by track id
+  std::map<int, OpenSlice> open_slices;        // By track id
+  int iteration = -1;                          // -1 until an iteration's kFightLength event is reached
+  int last_tick = 0;
+
+  // The entity's casts and global cooldown tracks come before its other tracks
+  int Track(const Entity* kEntity, const std::string& kName) {
+    if (const auto kIt = track_ids.find({kEntity, kName}); kIt != track_ids.end()) {
+      used_tracks[kIt->second] = true;
+      return kIt->second;
+    }
+
+    if (kName != "casts" && kName != "global cooldown") {
+      Track(kEntity, "casts");
+      Track(kEntity, "global cooldown");
+    }
+
+    const int kId = static_cast<int>(track_names.size());
+    track_ids.emplace(std::make_pair(kEntity, kName), kId);
+    track_names.push_back(kEntity->name + " " + kName);
+    used_tracks.push_back(true);
+    return kId;
+  }
+
+  void AddSlice(const int kTrack, const char* kCategory, const std::string& kName, const int kStart, const int kEnd) {
+    trace_events.push_back("{\"name\":\"" + EscapeJson(kName) + "\",\"cat\":\"" + kCategory +
+                           "\",\"ph\":\"X\",\"ts\":" + std::to_string(kStart * kMicrosecondsPerTick) +
+                           ",\"dur\":" + std::to_string((kEnd - kStart) * kMicrosecondsPerTick) +
+                           ",\"pid\":" + std::to_string(iteration) + ",\"tid\":" + std::to_string(kTrack) + "}");
+  }
+
+  void AddInstant(const int kTrack, const char* kCategory, const std::string& kName, const int kTime) {
+    trace_events.push_back("{\"name\":\"" + EscapeJson(kName) + "\",\"cat\":\"" + kCategory +
+                           "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" + std::to_string(kTime * kMicrosecondsPerTick) +
+                           ",\"pid\":" + std::to_string(iteration) + ",\"tid\":" + std::to_string(kTrack) + "}");
+  }
+
+  void AddMetadata(const std::string& kName, const int kTrack, const std::string& kArgs) {
+    trace_events.push_back("{\"name\":\"" + kName + "\",\"ph\":\"M\",\"pid\":" + std::to_string(iteration) +
+                           (kTrack >= 0 ? ",\"tid\":" + std::to_string(kTrack) : "") + ",\"args\":{" + kArgs + "}}");
+  }
+
+  // Refreshing an aura or dot that's already up doesn't start a new slice
+  void Open(const int kTrack, const char* kCategory, const std::string* kName, const int kTime) {
+    open_slices.try_emplace(kTrack, OpenSlice{kCategory, kName, kTime});
+  }
+
+  void Close(const int kTrack, const int kTime) {
+    if (const auto kIt = open_slices.find(kTrack); kIt != open_slices.end()) {
+      AddSlice(kTrack, kIt->second.category, *kIt->second.name, kIt->second.start, kTime);
+      open_slices.erase(kIt);
+    }
+  }
+
+  void EndIteration() {
+    if (iteration < 0) {
+      return;
+    }
+
+    while (!open_slices.empty()) {
+      Close(open_slices.begin()->first, last_tick);
+    }
+
+    for (int i = 0; i < static_cast<int>(track_names.size()); i++) {
+      if (used_tracks[i]) {
+        AddMetadata("thread_name", i, "\"name\":\"" + EscapeJson(track_names[i]) + "\"");
+        AddMetadata("thread_sort_index", i, "\"sort_index\":" + std::to_string(i));
+        used_tracks[i] = false;
+      }
+    }
+
+    iteration = -1;
+  }
+
+  void Add(const CombatLogEvent& kEvent) {
+    const auto& v = kEvent.values;
+
+    if (kEvent.type == CombatLogEventType::kFightLength) {
+      EndIteration();
+      iteration = static_cast<int>(v[1]);
+      AddMetadata("process_name", -1, "\"name\":\"Iteration " + std::to_string(iteration) + "\"");
+      AddMetadata("process_sort_index", -1, "\"sort_index\":" + std::to_string(iteration));
+    }
+
+    // The iteration's start was overwritten in the ring buffer
+    if (iteration < 0) {
+      return;
+    }
+
+    last_tick = kEvent.tick;
+
+    switch (kEvent.type) {
+      case CombatLogEventType::kFightEnd:
+        EndIteration();
+        break;
+      case CombatLogEventType::kSpellCast: {
+        const int kCastTrack = Track(kEvent.entity, "casts");
+
+        if (kEvent.flags & CombatLogFlag::kStartedCasting) {
+          Open(kCastTrack, "cast", kEvent.name, kEvent.tick);
+        } else if (kEvent.flags & CombatLogFlag::kCast) {
+          if (kEvent.id == SpellId::kMelee) {
+            AddSlice(kCastTrack, "swing", *kEvent.name, kEvent.tick, kEvent.tick + SecondsToTicks(v[0]));
+          } else {
+            AddInstant(kCastTrack, "cast", *kEvent.name, kEvent.tick);
+          }
+        }
+
+        if (kEvent.flags & CombatLogFlag::kGlobalCooldown) {
+          AddSlice(Track(kEvent.entity, "global cooldown"), "gcd", *kEvent.name, kEvent.tick,
+                   kEvent.tick + SecondsToTicks(v[3]));
+        }
+        break;
+      }
+      case CombatLogEventType::kSpellFinishedCasting:
+        Close(Track(kEvent.entity, "casts"), kEvent.tick);
+        break;
+      case CombatLogEventType::kAuraApplied:
+        Open(Track(kEvent.entity, *kEvent.name), "aura", kEvent.name, kEvent.tick);
+        break;
+      case CombatLogEventType::kDotApplied:
+        Open(Track(kEvent.entity, *kEvent.name), "dot", kEvent.name, kEvent.tick);
+        break;
+      case CombatLogEventType::kTrinketUsed:
+        Open(Track(kEvent.entity, *kEvent.name), "trinket", kEvent.name, kEvent.tick);
+        break;
+      case CombatLogEventType::kAuraFaded:
+      case CombatLogEventType::kDotFaded:
+      case CombatLogEventType::kTrinketFaded:
+        Close(Track(kEvent.entity, *kEvent.name), kEvent.tick);
+        break;
+      default:
+        break;
+    }
+  }
+};
+}
+
+std::string FormatChromeTrace(const CombatLogBuffer& kLog) {
+  auto writer = ChromeTraceWriter();
+
+  for (int i = 0; i < kLog.Size(); i++) {
+    writer.Add(kLog.Event(i));
+  }
+
+  writer.EndIteration();
+
+  std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  for (size_t i = 0; i < writer.trace_events.size(); i++) {
+    trace += (i == 0 ? "\n" : ",\n") + writer.trace_events[i];
+  }
+
+  return trace + "\n]}\n";
+}
@@ -0,0 +1,261 @@
+#include "../include/combat_log.h"
+
+#include <cmath>
+#include <unordered_map>
+
+#include "../include/common.h"
+#include "../include/entity.h"
+#include "../include/enums.h"
+#include "../include/pet.h"
+#include "../include/scheduler.h"
+
+namespace {
+const std::string kNoName;
+
+// The line without the fight time in front of it
+std::string FormatEntry(const CombatLogEvent& kEvent) {
+  const auto& v = kEvent.values;
+  const std::string& kName = kEvent.name != nullptr ? *kEvent.name : kNoName;
+  const std::string& kEntityName = kEvent.entity != nullptr ? kEvent.entity->name : kNoName;
+
+  switch (kEvent.type) {
+    // v: fight length, iteration
+    case CombatLogEventType::kFightLength:
+      return "Fight length: " + DoubleToString(v[0]) + " seconds";
+    case CombatLogEventType::kFightEnd:
+      return "Fight end";
+    // v: cast time left or attack speed, haste percent, base cast time or attack speed, GCD left, predicted damage
+    case CombatLogEventType::kSpellCast: {
+      std::string msg;
+
+      if (kEvent.flags & CombatLogFlag::kStartedCasting) {
+        msg += kEntityName + " started casting " + kName + " - Cast time: " + DoubleToString(v[0], 4) + " (" +
+            DoubleToString((v[1] - 1) * 100, 4) + "% haste at a base Cast speed of " + DoubleToString(v[2], 2) + ")";
+      } else if (kEvent.flags & CombatLogFlag::kCast) {
+        msg += kEntityName + " casts " + kName;
+
+        if (kEvent.id == SpellId::kMelee) {
+          msg += " - Attack Speed: " + DoubleToString(v[0], 2) + " (" +
+              DoubleToString(std::round(v[1] * 10000) / 100.0 - 100, 4) + "% haste at a base attack speed of " +
+              DoubleToString(v[2], 2) + ")";
+        }
+      }
+
+      if (kEvent.flags & CombatLogFlag::kGlobalCooldown) {
+        msg += " - Global cooldown: " + DoubleToString(v[3], 4);
+      }
+
+      if (kEvent.flags & CombatLogFlag::kPredictedDamage) {
+        msg += " - Estimated Damage / Cast time: " + DoubleToString(std::round(v[4]));
+      }
+
+      return msg;
+    }
+    // v: mana before, mana after, mana cost, mana cost modifier
+    case CombatLogEventType::kSpellFinishedCasting: {
+      auto msg = kEntityName + " finished casting " + kName + " - Mana: " + DoubleToString(v[0]) + " -> " +
+          DoubleToString(v[1]) + " - Mana Cost: " + DoubleToString(std::round(v[2]));
+
+      if (kEvent.flags & CombatLogFlag::kPlayer) {
+        msg += " - Mana Cost Modifier: " + DoubleToString(std::round(v[3] * 100)) + "%";
+      }
+
+      return msg;
+    }
+    case CombatLogEventType::kSpellOffCooldown:
+      return kEntityName + "'s " + kName + " off cooldown";
+    // v: damage, base damage, coefficient, spell power, partial resist multiplier, crit multiplier, damage modifier,
+    // glancing blow multiplier, attack power, damage reduction from armor
+    case CombatLogEventType::kSpellDamage: {
+      const bool kIsCrit = kEvent.flags & CombatLogFlag::kCrit;
+      const bool kIsGlancing = kEvent.flags & CombatLogFlag::kGlancing;
+      auto msg = kName + " ";
+
+      if (kIsCrit) {
+        msg += "*";
+      }
+
+      msg += DoubleToString(std::round(v[0]));
+
+      if (kIsCrit) {
+        msg += "*";
+      }
+
+      if (kIsGlancing) {
+        msg += " Glancing";
+      }
+
+      msg += " (" + DoubleToString(v[1], 1) + " Base Damage";
+
+      if (kEvent.flags & CombatLogFlag::kMagical) {
+        msg += " - " + DoubleToString(std::round(v[2] * 1000) / 1000, 3) + " Coefficient";
+        msg += " - " + DoubleToString(std::round(v[3])) + " Spell Power";
+        msg += " - " + DoubleToString(std::round(v[4] * 1000) / 10) + "% Partial Resist Multiplier)";
+      } else if (kEvent.flags & CombatLogFlag::kPhysical) {
+        if (kIsGlancing) {
+          msg += " - " + DoubleToString(v[7] * 100, 1) + "% Glancing Blow Multiplier";
+        }
+        msg += " - " + DoubleToString(std::round(v[8])) + " Attack Power";
+        msg += " - " + DoubleToString(std::round(v[9] * 10000) / 100.0, 2) + "% Damage Modifier (Armor)";
+      }
+
+      if (kIsCrit) {
+        msg += " - " + DoubleToString(v[5] * 100, 3) + "% Crit Multiplier";
+      }
+
+      return msg + " - " + DoubleToString(std::round(v[6] * 10000) / 100, 2) + "% Damage Modifier";
+    }
+    case CombatLogEventType::kSpellResist:
+      return kName + " *resist*";
+    case CombatLogEventType::kSpellDodge:
+      return kEntityName + " " + kName + " *dodge*";
+    case CombatLogEventType::kSpellMiss:
+      return kEntityName + " " + kName + " *miss*";
+    // v: damage, enemies, resists, crits, base damage, coefficient, spell power, damage modifier, crit multiplier,
+    // partial resist multiplier
+    case CombatLogEventType::kSeedOfCorruptionDamage: {
+      auto msg = kName + " " + DoubleToString(std::round(v[0])) + " (" + std::to_string(static_cast<int>(v[1])) +
+          " Enemies (" + std::to_string(static_cast<int>(v[2])) + " Resists & " +
+          std::to_string(static_cast<int>(v[3])) + " Crits) - " + DoubleToString(v[4], 1) + " Base Damage - " +
+          DoubleToString(v[5], 3) + " Coefficient - " + DoubleToString(v[6]) + " Spell Power - " +
+          DoubleToString(std::round(v[7] * 1000) / 10, 1) + "% Modifier - ";
+
+      if (v[3] > 0) {
+        msg += DoubleToString(v[8], 3) + "% Crit Multiplier";
+      }
+
+      return msg + " - " + DoubleToString(std::round(v[9] * 1000) / 10) + "% Partial Resist Multiplier)";
+    }
+    // v: mana gained, spell power, coefficient, modifier
+    case CombatLogEventType::kLifeTap:
+      return kName + " " + DoubleToString(v[0]) + " (" + DoubleToString(v[1]) + " Spell Power - " +
+          DoubleToString(v[2], 3) + " Coefficient - " + DoubleToString(v[3] * 100, 2) + "% Modifier)";
+    case CombatLogEventType::kLifeTapManaWasted:
+      return kName + " used at too high mana (mana wasted)";
+    // The mana gains' v: mana gained, mana before, mana after
+    case CombatLogEventType::kManaGain:
+      return "Player gains " + DoubleToString(v[0]) + " mana from " + kName + " (" + DoubleToString(v[1]) + " -> " +
+          DoubleToString(v[2]) + ")";
+    case CombatLogEventType::kMp5ManaGain:
+      return "Player gains " + DoubleToString(v[0]) + " mana from MP5 (" + DoubleToString(v[1]) + " -> " +
+          DoubleToString(v[2]) + ")";
+    case CombatLogEventType::kManaOverTimeGain:
+      return kEntityName + " gains " + DoubleToString(v[0]) + " mana from " + kName + " (" + DoubleToString(v[1]) +
+          " -> " + DoubleToString(v[2]) + ")" + ")";
+    case CombatLogEventType::kPetManaRegen:
+      return kEntityName + " gains " + DoubleToString(std::round(v[0])) + " mana from Mp5/Spirit regeneration (" +
+          DoubleToString(std::round(v[1])) + " -> " + DoubleToString(v[2]) + ")";
+    case CombatLogEventType::kManaFeed:
+      return kEntityName + " gains " + DoubleToString(v[0]) + " mana from Mana Feed";
+    case CombatLogEventType::kAuraApplied:
+      return kName + " applied";
+    case CombatLogEventType::kAuraRefreshed:
+      return kName + " refreshed";
+    // v: stacks
+    case CombatLogEventType::kAuraStacks:
+      return kName + " (" + std::to_string(static_cast<int>(v[0])) + ")";
+    case CombatLogEventType::kAuraFaded:
+    case CombatLogEventType::kDotFaded:
+    case CombatLogEventType::kTrinketFaded:
+      return kName + " faded";
+    // v: spell power
+    case CombatLogEventType::kDotApplied:
+      return kName + ((kEvent.flags & CombatLogFlag::kRefreshed) ? " refreshed" : " applied") + " (" +
+          DoubleToString(v[0]) + " Spell Power)";
+    case CombatLogEventType::kDotRefreshedEarly:
+      return kName + " refreshed before letting it expire";
+    // v: damage, base damage, spell power, coefficient, damage modifier, partial resist multiplier, T5 4pc modifier
+    case CombatLogEventType::kDotTick: {
+      auto msg = kName + " Tick " + DoubleToString(std::round(v[0])) + " (" + DoubleToString(v[1]) +
+          " Base Damage - " + DoubleToString(v[2]) + " Spell Power - " + DoubleToString(v[3], 3) + " Coefficient - " +
+          DoubleToString(std::round(v[4] * 10000) / 100, 3) + "% Damage Modifier - " +
+          DoubleToString(std::round(v[5] * 1000) / 10) + "% Partial Resist Multiplier";
+
+      if (v[6] > 1) {
+        msg += " - " + DoubleToString(std::round(v[6] * 10000) / 100, 3) + "% Base Dmg Modifier (T5 4pc bonus)";
+      }
+
+      return msg + ")";
+    }
+    // v: amount, value before, value after, decimal places
+    case CombatLogEventType::kStatChanged: {
+      const auto kDecimalPlaces = static_cast<int>(v[3]);
+      std::string operation;
+
+      if (kEvent.flags & CombatLogFlag::kMultiplicative) {
+        operation = kEvent.flags & CombatLogFlag::kRemoving ? "/" : "*";
+      } else {
+        operation = kEvent.flags & CombatLogFlag::kRemoving ? "-" : "+";
+      }
+
+      return kEntityName + " " + kName + " " + operation + " " + DoubleToString(v[0], kDecimalPlaces) + " (" +
+          DoubleToString(v[1], kDecimalPlaces) + " -> " + DoubleToString(v[2], kDecimalPlaces) + ")";
+    }
+    case CombatLogEventType::kTrinketUsed:
+      return kName + " used";
+    case CombatLogEventType::kTrinketOffCooldown:
+      return kName + " off cooldown";
+  }
+
+  return kName;
+}
+}
+
+std::string FormatCombatLogEvent(const CombatLogEvent& kEvent) {
+  return "|" + DoubleToString(TicksToSeconds(kEvent.tick), 4) + "| " + FormatEntry(kEvent);
+}
+
+void CombatLogBuffer::Add(const CombatLogEvent& kEvent) {
+  if (events.empty()) {
+    events.resize(kCapacity);
+  }
+
+  if (size < kCapacity) {
+    events[(first + size++) % kCapacity] = kEvent;
+  } else {
+    events[first] = kEvent;
+    first = (first + 1) % kCapacity;
+  }
+}
+
+// The other log's events point at the names of its own player's spells, auras etc. and at its player and pet, so
+// they get the interned copies of the names and kPlayer or kPlayer's pet instead
+void CombatLogBuffer::Merge(const CombatLogBuffer& kOther, const Entity& kOtherPlayer, const Entity& kPlayer) {
+  std::unordered_map<const std::string*, const std::string*> copied_names;
+
+  for (int i = 0; i < kOther.Size(); i++) {
+    CombatLogEvent event = kOther.Event(i);
+
+    if (event.name != nullptr) {
+      auto [it, kInserted] = copied_names.try_emplace(event.name, nullptr);
+
+      if (kInserted) {
+        it->second = &*names.insert(*event.name).first;
+      }
+
+      event.name = it->second;
+    }
+
+    event.entity = event.entity == &kOtherPlayer ? &kPlayer : kPlayer.pet;
+    Add(event);
+  }
+}
+
+void CombatLogBuffer::Clear() {
+  header.clear();
+  names.clear();
+  first = 0;
+  size = 0;
+}
+
+const CombatLogEvent& CombatLogBuffer::Event(const int kIndex) const { return events[(first + kIndex) % kCapacity]; }
+
+std::vector<std::string> CombatLogBuffer::Format() const {
+  std::vector<std::string> lines = header;
+
+  for (int i = 0; i < size; i++) {
+    lines.push_back(FormatCombatLogEvent(Event(i)));
+  }
+
+  return lines;
+}
@@ -4,7 +4,6 @@
 #include "../include/sets.h"
 #include "../include/combat_log_breakdown.h"
 #include "../include/simulation.h"
-#include "../include/common.h"
 #include "../include/player_settings.h"
 #include "../include/aura.h"
 #include "../include/talents.h"
@@ -19,57 +18,52 @@ void DamageOverTime::Setup() {
   original_duration = duration;
 
   // T4 4pc
-  if ((name == SpellName::kCorruption || name == SpellName::kImmolate) && player.sets.t4 >= 4) {
+  if ((id == SpellId::kCorruption || id == SpellId::kImmolate) && player.sets.t4 >= 4) {
     duration += 3;
   }
 
   ticks_total = duration / tick_timer_total;
 
-  if (player.recording_combat_log_breakdown && !player.combat_log_breakdown.contains(name)) {
-    player.combat_log_breakdown.insert({name, std::make_shared<CombatLogBreakdown>(name)});
+  if (player.recording_combat_log_breakdown) {
+    player.AddCombatLogBreakdown(id, name);
   }
 
+  tick_timer.Register(player, TimerType::kDotTick, static_cast<int>(player.dot_list.size()));
   player.dot_list.push_back(this);
 }
 
 void DamageOverTime::Apply() {
   if (active && player.ShouldWriteToCombatLog()) {
-    player.CombatLog(name + " refreshed before letting it expire");
+    player.CombatLog({.type = CombatLogEventType::kDotRefreshedEarly, .id = id, .name = &name});
   } else if (!active && player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->applied_at = player.simulation->current_fight_time;
+    player.GetCombatLogBreakdown(id).applied_at = player.simulation->GetCurrentFightTime();
   }
   const bool kIsAlreadyActive = active;
   spell_power = player.GetSpellPower(true, school);
 
   active = true;
-  tick_timer_remaining = tick_timer_total;
+  tick_timer.Start(tick_timer_total);
   ticks_remaining = ticks_total;
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->count++;
+    player.GetCombatLogBreakdown(id).count++;
   }
   if (player.ShouldWriteToCombatLog()) {
-    auto msg = name + " ";
-
-    if (kIsAlreadyActive) {
-      msg += "refreshed";
-    } else {
-      msg += "applied";
-    }
-
-    msg += " (" + DoubleToString(spell_power) + " Spell Power)";
-
-    player.CombatLog(msg);
+    player.CombatLog({.type = CombatLogEventType::kDotApplied,
+                      .flags = kIsAlreadyActive ? CombatLogFlag::kRefreshed : uint8_t{0},
+                      .id = id,
+                      .name = &name,
+                      .values = {spell_power}});
   }
   // Siphon Life snapshots the presence of ISB. So if ISB isn't up when it's
   // Cast, it doesn't get the benefit even if it comes up later during the
   // duration.
-  if (name == SpellName::kSiphonLife) {
+  if (id == SpellId::kSiphonLife) {
     isb_is_active = !player.settings.using_custom_isb_uptime && player.auras.improved_shadow_bolt != nullptr &&
                     player.auras.improved_shadow_bolt->active;
   }
   // Amplify Curse
-  if ((name == SpellName::kCurseOfAgony || name == SpellName::kCurseOfDoom) && player.auras.amplify_curse != nullptr &&
+  if ((id == SpellId::kCurseOfAgony || id == SpellId::kCurseOfDoom) && player.auras.amplify_curse != nullptr &&
       player.auras.amplify_curse->active) {
     applied_with_amplify_curse = true;
     player.auras.amplify_curse->Fade();
@@ -80,20 +74,20 @@ void DamageOverTime::Apply() {
 
 void DamageOverTime::Fade() {
   active = false;
-  tick_timer_remaining = 0;
+  tick_timer.Stop();
   ticks_remaining = 0;
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->uptime +=
-        player.simulation->current_fight_time - player.combat_log_breakdown.at(name)->applied_at;
+    player.GetCombatLogBreakdown(id).uptime +=
+        player.simulation->GetCurrentFightTime() - player.GetCombatLogBreakdown(id).applied_at;
   }
 
   if (player.ShouldWriteToCombatLog()) {
-    player.CombatLog(name + " faded");
+    player.CombatLog({.type = CombatLogEventType::kDotFaded, .id = id, .name = &name});
   }
 }
 
-std::vector<double> DamageOverTime::GetConstantDamage() const {
+DamageBreakdown DamageOverTime::GetConstantDamage() const {
   const auto kCurrentSpellPower = active ? spell_power : player.GetSpellPower(true, school);
   const auto kModifier = player.GetDamageModifier(*parent_spell, true);
   const auto kPartialResistMultiplier = player.GetPartialResistMultiplier(school);
@@ -103,7 +97,7 @@ std::vector<double> DamageOverTime::GetConstantDamage() const {
     dmg *= 1.5;
   }
   // Add the t5 4pc bonus modifier to the base damage
-  if ((name == SpellName::kCorruption || name == SpellName::kImmolate) && player.sets.t5 >= 4) {
+  if ((id == SpellId::kCorruption || id == SpellId::kImmolate) && player.sets.t5 >= 4) {
     dmg *= t5_bonus_modifier;
   }
 
@@ -111,17 +105,17 @@ std::vector<double> DamageOverTime::GetConstantDamage() const {
   total_damage += kCurrentSpellPower * coefficient;
   total_damage *= kModifier * kPartialResistMultiplier;
 
-  return std::vector{dmg, total_damage, kCurrentSpellPower, kModifier, kPartialResistMultiplier};
+  return {dmg, total_damage, kCurrentSpellPower, kModifier, kPartialResistMultiplier};
 }
 
 double DamageOverTime::PredictDamage() const {
-  auto damage = GetConstantDamage()[1];
+  auto damage = GetConstantDamage().damage;
   // If it's Corruption or Immolate then divide by the original duration (18s
   // and 15s) and multiply by the durationTotal property This is just for the t4
   // 4pc bonus since their durationTotal property is increased by 3 seconds to
   // include another tick but the damage they do stays the same which assumes
   // the normal duration without the bonus
-  if (name == SpellName::kCorruption || name == SpellName::kImmolate) {
+  if (id == SpellId::kCorruption || id == SpellId::kImmolate) {
     damage /= original_duration;
     damage *= duration;
   }
@@ -129,60 +123,49 @@ double DamageOverTime::PredictDamage() const {
   return damage;
 }
 
-void DamageOverTime::Tick(const double kTime) {
-  tick_timer_remaining -= kTime;
-
-  if (tick_timer_remaining <= 0) {
-    const std::vector<double> kConstantDamage = GetConstantDamage();
-    const double kBaseDamage = kConstantDamage[0];
-    const double kDamage = kConstantDamage[1] / (static_cast<double>(original_duration) / tick_timer_total);
-    const double kSpellPower = kConstantDamage[2];
-    const double kModifier = kConstantDamage[3];
-    const double kPartialResistMultiplier = kConstantDamage[4];
-
-    // Check for Nightfall proc
-    if (name == SpellName::kCorruption && player.talents.nightfall > 0) {
-      if (player.RollRng(player.talents.nightfall * 2)) {
-        player.auras.shadow_trance->Apply();
-      }
+void DamageOverTime::Tick() {
+  const DamageBreakdown kConstantDamage = GetConstantDamage();
+  const double kDamage = kConstantDamage.damage / (static_cast<double>(original_duration) / tick_timer_total);
+
+  // Check for Nightfall proc
+  if (id == SpellId::kCorruption && player.talents.nightfall > 0) {
+    if (player.RollRng(player.talents.nightfall * 2)) {
+      player.auras.shadow_trance->Apply();
     }
+  }
 
-    player.iteration_damage += kDamage;
-    ticks_remaining--;
-    tick_timer_remaining = tick_timer_total;
+  player.iteration_damage += kDamage;
+  ticks_remaining--;
+  tick_timer.Start(tick_timer_total);
 
-    if (player.recording_combat_log_breakdown) {
-      player.combat_log_breakdown.at(name)->iteration_damage += kDamage;
-    }
+  if (player.recording_combat_log_breakdown) {
+    player.GetCombatLogBreakdown(id).iteration_damage += kDamage;
+  }
 
-    if (player.ShouldWriteToCombatLog()) {
-      auto msg = name + " Tick " + DoubleToString(round(kDamage)) + " (" + DoubleToString(kBaseDamage) +
-                 " Base Damage - " + DoubleToString(kSpellPower) + " Spell Power - " + DoubleToString(coefficient, 3) +
-                 " Coefficient - " + DoubleToString(round(kModifier * 10000) / 100, 3) + "% Damage Modifier - " +
-                 DoubleToString(round(kPartialResistMultiplier * 1000) / 10) + "% Partial Resist Multiplier";
-      if (t5_bonus_modifier > 1) {
-        msg += " - " + DoubleToString(round(t5_bonus_modifier * 10000) / 100, 3) + "% Base Dmg Modifier (T5 4pc bonus)";
-      }
-      msg += ")";
-
-      player.CombatLog(msg);
-    }
+  if (player.ShouldWriteToCombatLog()) {
+    player.CombatLog({.type = CombatLogEventType::kDotTick,
+                      .id = id,
+                      .name = &name,
+                      .values = {kDamage, kConstantDamage.base_damage, kConstantDamage.spell_power, coefficient,
+                                 kConstantDamage.damage_modifier, kConstantDamage.partial_resist_multiplier,
+                                 t5_bonus_modifier}});
+  }
 
-    for (const auto& kProc : player.on_dot_tick_procs) {
-      if (kProc->Ready() && kProc->ShouldProc(this) && player.RollRng(kProc->proc_chance)) {
-        kProc->StartCast();
-      }
+  for (const auto& kProc : on_tick_procs) {
+    if (kProc->Ready() && player.RollProc(kProc->proc_chance)) {
+      kProc->StartCast();
     }
+  }
 
-    if (ticks_remaining <= 0) {
-      Fade();
-    }
+  if (ticks_remaining <= 0) {
+    Fade();
   }
 }
 
 CorruptionDot::CorruptionDot(Player& player_param)
   : DamageOverTime(player_param) {
   name = SpellName::kCorruption;
+  id = SpellId::kCorruption;
   duration = 18;
   tick_timer_total = 3;
   base_damage = 900;
@@ -200,6 +183,7 @@ void CorruptionDot::Apply() {
 UnstableAfflictionDot::UnstableAfflictionDot(Player& player_param)
   : DamageOverTime(player_param) {
   name = SpellName::kUnstableAffliction;
+  id = SpellId::kUnstableAffliction;
   duration = 18;
   tick_timer_total = 3;
   base_damage = 1050;
@@ -211,6 +195,7 @@ UnstableAfflictionDot::UnstableAfflictionDot(Player& player_param)
 SiphonLifeDot::SiphonLifeDot(Player& player_param)
   : DamageOverTime(player_param) {
   name = SpellName::kSiphonLife;
+  id = SpellId::kSiphonLife;
   duration = 30;
   tick_timer_total = 3;
   base_damage = 630;
@@ -222,6 +207,7 @@ SiphonLifeDot::SiphonLifeDot(Player& player_param)
 ImmolateDot::ImmolateDot(Player& player_param)
   : DamageOverTime(player_param) {
   name = SpellName::kImmolate;
+  id = SpellId::kImmolate;
   duration = 15;
   tick_timer_total = 3;
   base_damage = 615;
@@ -239,6 +225,7 @@ void ImmolateDot::Apply() {
 CurseOfAgonyDot::CurseOfAgonyDot(Player& player_param)
   : DamageOverTime(player_param) {
   name = SpellName::kCurseOfAgony;
+  id = SpellId::kCurseOfAgony;
   duration = 24;
   tick_timer_total = 3;
   base_damage = 1356;
@@ -250,6 +237,7 @@ CurseOfAgonyDot::CurseOfAgonyDot(Player& player_param)
 CurseOfDoomDot::CurseOfDoomDot(Player& player_param)
   : DamageOverTime(player_param) {
   name = SpellName::kCurseOfDoom;
+  id = SpellId::kCurseOfDoom;
   duration = 60;
   tick_timer_total = 60;
   base_damage = 4200;
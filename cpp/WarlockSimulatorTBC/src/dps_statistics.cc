@@ -0,0 +1,204 @@
+#include "../include/dps_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+P2Quantile::P2Quantile(const double kQuantile)
+  : quantile(kQuantile) {
+}
+
+void P2Quantile::Add(const double kValue) {
+  // The markers start out as the first five values
+  if (count < 5) {
+    heights[count++] = kValue;
+
+    if (count == 5) {
+      std::sort(heights.begin(), heights.end());
+      positions = {1, 2, 3, 4, 5};
+      desired_positions = {1, 1 + 2 * quantile, 1 + 4 * quantile, 3 + 2 * quantile, 5};
+      increments = {0, quantile / 2, quantile, (1 + quantile) / 2, 1};
+    }
+
+    return;
+  }
+
+  count++;
+
+  // Find the cell that the value falls into, extending the outer markers if it's outside of them
+  int cell;
+  if (kValue < heights[0]) {
+    heights[0] = kValue;
+    cell = 0;
+  } else if (kValue >= heights[4]) {
+    heights[4] = kValue;
+    cell = 3;
+  } else {
+    cell = 0;
+    while (kValue >= heights[cell + 1]) {
+      cell++;
+    }
+  }
+
+  for (int i = cell + 1; i < 5; i++) {
+    positions[i]++;
+  }
+
+  for (int i = 0; i < 5; i++) {
+    desired_positions[i] += increments[i];
+  }
+
+  // Move the middle markers towards their desired positions, adjusting their heights with the piecewise-parabolic
+  // formula or the linear one if the parabolic one would put the marker out of order
+  for (int i = 1; i < 4; i++) {
+    const double kOffset = desired_positions[i] - positions[i];
+
+    if ((kOffset >= 1 && positions[i + 1] - positions[i] > 1) ||
+        (kOffset <= -1 && positions[i - 1] - positions[i] < -1)) {
+      const int kDirection = kOffset > 0 ? 1 : -1;
+
+      if (const double kHeight = Parabolic(i, kDirection); heights[i - 1] < kHeight && kHeight < heights[i + 1]) {
+        heights[i] = kHeight;
+      } else {
+        heights[i] = Linear(i, kDirection);
+      }
+
+      positions[i] += kDirection;
+    }
+  }
+}
+
+double P2Quantile::Estimate() const {
+  if (count >= 5) {
+    return heights[2];
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  auto values = heights;
+  std::sort(values.begin(), values.begin() + count);
+  return values[static_cast<int>(std::lround(quantile * (count - 1)))];
+}
+
+double P2Quantile::Parabolic(const int kMarker, const double kDirection) const {
+  const int i = kMarker;
+  return heights[i] + kDirection / (positions[i + 1] - positions[i - 1]) *
+                          ((positions[i] - positions[i - 1] + kDirection) * (heights[i + 1] - heights[i]) /
+                               (positions[i + 1] - positions[i]) +
+                           (positions[i + 1] - positions[i] - kDirection) * (heights[i] - heights[i - 1]) /
+                               (positions[i] - positions[i - 1]));
+}
+
+double P2Quantile::Linear(const int kMarker, const int kDirection) const {
+  const int i = kMarker;
+  return heights[i] + kDirection * (heights[i + kDirection] - heights[i]) / (positions[i + kDirection] - positions[i]);
+}
+
+void RunningMeanVariance::Add(const double kValue) {
+  count++;
+  const double kDelta = kValue - mean;
+  mean += kDelta / count;
+  sum_of_squares += kDelta * (kValue - mean);
+}
+
+// Chan et al.'s formula for combining the means and variances of two sets of values
+void RunningMeanVariance::Merge(const RunningMeanVariance& kOther) {
+  if (kOther.count == 0) {
+    return;
+  }
+
+  if (count == 0) {
+    *this = kOther;
+    return;
+  }
+
+  const int kCount = count + kOther.count;
+  const double kDelta = kOther.mean - mean;
+  mean += kDelta * kOther.count / kCount;
+  sum_of_squares += kOther.sum_of_squares + kDelta * kDelta * count * kOther.count / kCount;
+  count = kCount;
+}
+
+double RunningMeanVariance::Variance() const { return count > 1 ? sum_of_squares / (count - 1) : 0; }
+
+double RunningMeanVariance::StandardDeviation() const { return std::sqrt(Variance()); }
+
+double RunningMeanVariance::StandardError() const { return count > 0 ? std::sqrt(Variance() / count) : 0; }
+
+void DpsStatistics::Add(const double kValue) {
+  // E.g. the dps of a fight that's 0 seconds long
+  if (!std::isfinite(kValue)) {
+    throw std::invalid_argument("expected a finite dps but got " + std::to_string(kValue));
+  }
+
+  if (count == 0) {
+    min = kValue;
+    max = kValue;
+  } else {
+    min = std::min(min, kValue);
+    max = std::max(max, kValue);
+  }
+
+  RunningMeanVariance::Add(kValue);
+
+  constexpr double kBinsPerDps = 1 / kHistogramBinWidth;
+  const auto kBin = static_cast<size_t>(std::clamp(kValue, 0.0, kHistogramMaxDps) * kBinsPerDps);
+
+  if (kBin >= histogram.size()) {
+    histogram.resize(kBin + 1);
+  }
+
+  histogram[kBin]++;
+  running_median.Add(kValue);
+}
+
+void DpsStatistics::Merge(const DpsStatistics& kOther) {
+  if (kOther.count == 0) {
+    return;
+  }
+
+  if (count == 0) {
+    *this = kOther;
+    return;
+  }
+
+  RunningMeanVariance::Merge(kOther);
+  min = std::min(min, kOther.min);
+  max = std::max(max, kOther.max);
+
+  if (kOther.histogram.size() > histogram.size()) {
+    histogram.resize(kOther.histogram.size());
+  }
+
+  for (size_t i = 0; i < kOther.histogram.size(); i++) {
+    histogram[i] += kOther.histogram[i];
+  }
+}
+
+void DpsStatistics::Clear() { *this = DpsStatistics(); }
+
+// Walks the histogram to the bin that the quantile's rank falls in and interpolates linearly within that bin
+double DpsStatistics::Quantile(const double kQuantile) const {
+  if (count == 0) {
+    return 0;
+  }
+
+  const double kRank = kQuantile * count;
+  auto values_before = 0;
+
+  for (size_t i = 0; i < histogram.size(); i++) {
+    if (histogram[i] > 0 && values_before + histogram[i] >= kRank) {
+      const double kValue = (i + (kRank - values_before) / histogram[i]) * kHistogramBinWidth;
+      return std::clamp(kValue, min, max);
+    }
+
+    values_before += histogram[i];
+  }
+
+  return max;
+}
+
+double DpsStatistics::Median() const { return Quantile(0.5); }
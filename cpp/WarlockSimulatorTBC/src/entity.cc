@@ -1,5 +1,9 @@
 #include "../include/entity.h"
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
 #include "../include/player_settings.h"
 #include "../include/combat_log_breakdown.h"
 #include "../include/aura.h"
@@ -9,10 +13,25 @@
 #include "../include/talents.h"
 #include "../include/pet.h"
 #include "../include/damage_over_time.h"
-#include "../include/common.h"
 #include "../include/bindings.h"
 #include "../include/aura_selection.h"
 #include "../include/sets.h"
+#include "../include/trinket.h"
+#include "../include/simulation_snapshot.h"
+#include "../include/on_hit_proc.h"
+#include "../include/on_crit_proc.h"
+#include "../include/on_dot_tick_proc.h"
+#include "../include/on_damage_proc.h"
+#include "../include/on_resist_proc.h"
+
+namespace {
+template <typename TProc, typename TSpell>
+void FilterProcs(const std::vector<TProc*>& kProcs, TSpell* spell, std::vector<TProc*>& eligible_procs) {
+  eligible_procs.clear();
+  std::copy_if(kProcs.begin(), kProcs.end(), std::back_inserter(eligible_procs),
+               [spell](TProc* proc) { return proc->ShouldProc(spell); });
+}
+}
 
 Entity::Entity(Player* player, PlayerSettings& player_settings, EntityType entity_type)
   : player(player),
@@ -27,6 +46,11 @@ Entity::Entity(Player* player, PlayerSettings& player_settings, EntityType entit
     // I don't know if this formula only works for bosses or not, so for the
     // moment I'm only using it for targets 3+ levels above.
     enemy_level_difference_resistance(player_settings.enemy_level >= kLevel + 3 ? 6 * kLevel * 5 / 75 : 0) {
+  cast_timer.Register(*this, TimerType::kCastTime);
+  gcd_timer.Register(*this, TimerType::kGcd);
+  five_second_rule_timer.Register(*this, TimerType::kFiveSecondRule);
+  mp5_timer.Register(*this, TimerType::kMp5);
+
   // Crit chance
   if (entity_type == EntityType::kPlayer) {
     if (player_settings.auras.atiesh_mage) {
@@ -120,11 +144,10 @@ Entity::Entity(Player* player, PlayerSettings& player_settings, EntityType entit
   }
 }
 
-void Entity::PostIterationDamageAndMana(const std::string& kSpellName) const {
-  PostCombatLogBreakdownVector(kSpellName.c_str(), combat_log_breakdown.at(kSpellName)->iteration_mana_gain,
-                               combat_log_breakdown.at(kSpellName)->iteration_damage);
-  combat_log_breakdown.at(kSpellName)->iteration_damage = 0;
-  combat_log_breakdown.at(kSpellName)->iteration_mana_gain = 0;
+void Entity::PostIterationDamageAndMana(CombatLogBreakdown& breakdown) {
+  PostCombatLogBreakdownVector(breakdown.name.c_str(), breakdown.iteration_mana_gain, breakdown.iteration_damage);
+  breakdown.iteration_damage = 0;
+  breakdown.iteration_mana_gain = 0;
 }
 
 void Entity::EndAuras() {
@@ -136,10 +159,13 @@ void Entity::EndAuras() {
 }
 
 void Entity::Reset() {
-  cast_time_remaining = 0;
-  gcd_remaining = 0;
-  mp5_timer_remaining = 5;
-  five_second_rule_timer_remaining = 5;
+  // The stats can also be changed directly while the entity is being set up, so the cached derived stats are never
+  // carried over into an iteration
+  stats_version++;
+  cast_timer.Start(0);
+  gcd_timer.Start(0);
+  mp5_timer.Start(5);
+  five_second_rule_timer.Start(5);
 
   for (const auto& kSpell : spell_list) {
     kSpell->Reset();
@@ -148,87 +174,121 @@ void Entity::Reset() {
 
 void Entity::Initialize(Simulation* simulation_ptr) { simulation = simulation_ptr; }
 
-void Entity::SendCombatLogBreakdown() const {
-  for (const auto& [kSpellName, kSpell] : combat_log_breakdown) {
-    if (kSpell->iteration_damage > 0 || kSpell->iteration_mana_gain > 0) {
-      PostIterationDamageAndMana(kSpellName);
+// Looks up the spells that share a cooldown with each spell once all of them have been created, so casting a spell
+// doesn't have to search the spell list for them
+void Entity::SetupSharedCooldowns() const {
+  for (const auto& kSpell : spell_list) {
+    kSpell->shared_cooldown_spell_indices.clear();
+
+    for (int i = 0; i < static_cast<int>(spell_list.size()); i++) {
+      if (std::find(kSpell->shared_cooldown_spells.begin(), kSpell->shared_cooldown_spells.end(), spell_list[i]->id) !=
+          kSpell->shared_cooldown_spells.end()) {
+        kSpell->shared_cooldown_spell_indices.push_back(i);
+      }
     }
+  }
+}
 
-    PostCombatLogBreakdown(kSpell->name.c_str(), kSpell->casts, kSpell->crits,
-                           kSpell->misses, kSpell->count, kSpell->uptime,
-                           kSpell->dodge, kSpell->glancing_blows);
+// Procs only check things about the spell that don't change during a fight, like its school, to decide whether it can
+// trigger them, so that's decided for every spell and dot up front and hitting, critting etc. only goes through the
+// procs that the spell can actually trigger. They're still checked for being ready and rolled for in the same order.
+void Entity::SetupProcs() const {
+  for (const auto& kSpell : spell_list) {
+    FilterProcs(on_hit_procs, kSpell, kSpell->on_hit_procs);
+    FilterProcs(on_crit_procs, kSpell, kSpell->on_crit_procs);
+    FilterProcs(on_damage_procs, kSpell, kSpell->on_damage_procs);
+    FilterProcs(on_resist_procs, kSpell, kSpell->on_resist_procs);
+  }
+
+  for (const auto& kDot : dot_list) {
+    FilterProcs(on_dot_tick_procs, kDot, kDot->on_tick_procs);
   }
 }
 
-double Entity::GetStamina() { return stats.stamina * stats.stamina_modifier; }
+// Gives the spell, aura etc. with this ID an entry in the combat log breakdown. Things that share an ID (e.g. a spell
+// and the aura that it applies) share the entry.
+void Entity::AddCombatLogBreakdown(const SpellId kId, const std::string& kName) {
+  if (combat_log_breakdown.empty()) {
+    combat_log_breakdown.resize(static_cast<int>(SpellId::kCount));
+  }
 
-double Entity::GetIntellect() { return stats.intellect * stats.intellect_modifier; }
+  combat_log_breakdown[static_cast<int>(kId)].name = kName;
+}
 
-double Entity::GetSpirit() const { return stats.spirit * stats.spirit_modifier; }
+void Entity::SendCombatLogBreakdown() {
+  for (auto& breakdown : combat_log_breakdown) {
+    if (breakdown.name.empty()) {
+      continue;
+    }
 
-bool Entity::ShouldWriteToCombatLog() const { return simulation->iteration == 10 && equipped_item_simulation; }
+    if (breakdown.iteration_damage > 0 || breakdown.iteration_mana_gain > 0) {
+      PostIterationDamageAndMana(breakdown);
+    }
 
-void Entity::CombatLog(const std::string& kEntry) const {
-  player->combat_log_entries.push_back("|" + DoubleToString(simulation->current_fight_time, 4) + "| " + kEntry);
+    PostCombatLogBreakdown(breakdown.name.c_str(), breakdown.casts, breakdown.crits, breakdown.misses, breakdown.count,
+                           breakdown.uptime, breakdown.dodge, breakdown.glancing_blows);
+  }
 }
 
-double Entity::GetMultiplicativeDamageModifier(const Spell& kSpell, bool) const {
-  auto damage_modifier = stats.damage_modifier;
+// Both entities' breakdowns are indexed by SpellId so they're added together entry by entry
+void Entity::MergeCombatLogBreakdown(const Entity& kEntity) {
+  if (combat_log_breakdown.empty()) {
+    combat_log_breakdown.resize(kEntity.combat_log_breakdown.size());
+  }
 
-  if (kSpell.spell_school == SpellSchool::kShadow) {
-    damage_modifier *= stats.shadow_modifier;
+  for (size_t i = 0; i < kEntity.combat_log_breakdown.size(); i++) {
+    const auto& kOther = kEntity.combat_log_breakdown[i];
+    auto& breakdown = combat_log_breakdown[i];
 
-    if (!settings.using_custom_isb_uptime && auras.improved_shadow_bolt != nullptr && auras.improved_shadow_bolt->active) {
-      damage_modifier *= auras.improved_shadow_bolt->modifier;
+    if (breakdown.name.empty()) {
+      breakdown.name = kOther.name;
     }
-  } else if (kSpell.spell_school == SpellSchool::kFire) {
-    damage_modifier *= stats.fire_modifier;
-  }
 
-  return damage_modifier;
+    breakdown.casts += kOther.casts;
+    breakdown.crits += kOther.crits;
+    breakdown.misses += kOther.misses;
+    breakdown.count += kOther.count;
+    breakdown.dodge += kOther.dodge;
+    breakdown.glancing_blows += kOther.glancing_blows;
+    breakdown.uptime += kOther.uptime;
+    breakdown.iteration_damage += kOther.iteration_damage;
+    breakdown.iteration_mana_gain += kOther.iteration_mana_gain;
+  }
 }
 
-double Entity::FindTimeUntilNextAction() {
-  auto time = cast_time_remaining;
-
-  if (time <= 0) {
-    time = gcd_remaining;
+void Entity::ResetCombatLogBreakdown() {
+  for (auto& breakdown : combat_log_breakdown) {
+    breakdown = CombatLogBreakdown{breakdown.name};
   }
+}
 
-  if (time <= 0 || mp5_timer_remaining < time && mp5_timer_remaining > 0) {
-    time = mp5_timer_remaining;
-  }
+double Entity::GetStamina() { return stats.stamina * stats.stamina_modifier; }
 
-  if (five_second_rule_timer_remaining > 0 && five_second_rule_timer_remaining < time) {
-    time = five_second_rule_timer_remaining;
-  }
+double Entity::GetIntellect() { return stats.intellect * stats.intellect_modifier; }
 
-  for (const auto& kSpell : spell_list) {
-    if (kSpell->cooldown_remaining < time && kSpell->cooldown_remaining > 0) {
-      time = kSpell->cooldown_remaining;
-    }
-  }
+double Entity::GetSpirit() const { return stats.spirit * stats.spirit_modifier; }
 
-  for (const auto& kAura : aura_list) {
-    if (kAura->active && kAura->has_duration) {
-      if (kAura->duration_remaining < time) {
-        time = kAura->duration_remaining;
-      }
+// Only records the event, it's written out when the combat log is sent, see CombatLogBuffer::Format()
+void Entity::CombatLog(CombatLogEvent event) const {
+  event.tick = simulation->current_tick;
+  event.entity = this;
+  player->combat_log.Add(event);
+}
 
-      if (kAura->tick_timer_remaining > 0 && kAura->tick_timer_remaining < time) {
-        time = kAura->tick_timer_remaining;
-      }
-    }
-  }
+double Entity::GetMultiplicativeDamageModifier(const Spell& kSpell, bool) const {
+  auto damage_modifier = stats.damage_modifier;
 
-  // TODO make DamageOverTime inherit from Aura and combine dot_list and aura_list
-  for (const auto& kDot : dot_list) {
-    if (kDot->active && kDot->tick_timer_remaining < time) {
-      time = kDot->tick_timer_remaining;
+  if (kSpell.spell_school == SpellSchool::kShadow) {
+    damage_modifier *= stats.shadow_modifier;
+
+    if (!settings.using_custom_isb_uptime && auras.improved_shadow_bolt != nullptr && auras.improved_shadow_bolt->active) {
+      damage_modifier *= auras.improved_shadow_bolt->modifier;
     }
+  } else if (kSpell.spell_school == SpellSchool::kFire) {
+    damage_modifier *= stats.fire_modifier;
   }
 
-  return time;
+  return damage_modifier;
 }
 
 double Entity::GetPartialResistMultiplier(const SpellSchool kSchool) const {
@@ -295,38 +355,116 @@ double Entity::GetCustomImprovedShadowBoltDamageModifier() const {
   return 1 + 0.2 * (settings.custom_isb_uptime_value / 100.0);
 }
 
-void Entity::Tick(const double kTime) {
-  cast_time_remaining -= kTime;
-  gcd_remaining -= kTime;
-  five_second_rule_timer_remaining -= kTime;
-  mp5_timer_remaining -= kTime;
+// Called by the simulation once one of the timers of this entity or of its spells, auras, dots or trinkets runs out
+void Entity::HandleTimer(const Timer& kTimer) {
+  switch (kTimer.type) {
+    case TimerType::kAuraDuration:
+      if (aura_list[kTimer.index]->active) {
+        aura_list[kTimer.index]->Fade();
+      }
+      break;
+    case TimerType::kAuraTick:
+      if (aura_list[kTimer.index]->active) {
+        aura_list[kTimer.index]->Tick();
+      }
+      break;
+    case TimerType::kDotTick:
+      if (dot_list[kTimer.index]->active) {
+        dot_list[kTimer.index]->Tick();
+      }
+      break;
+    case TimerType::kSpellCooldown:
+      spell_list[kTimer.index]->OnCooldownEnd();
+      break;
+    case TimerType::kCastTime:
+      if (spell_list[kTimer.index]->casting) {
+        spell_list[kTimer.index]->Cast();
+      }
+      break;
+    case TimerType::kTrinketCooldown:
+      player->trinkets[kTimer.index].OnCooldownEnd();
+      break;
+    case TimerType::kTrinketDuration:
+      if (player->trinkets[kTimer.index].active) {
+        player->trinkets[kTimer.index].Fade();
+      }
+      break;
+    case TimerType::kMp5:
+      mp5_timer.Start(5);
+      Mp5Tick();
+      break;
+    case TimerType::kGcd:
+    case TimerType::kFiveSecondRule:
+      // Nothing to do, the simulation just needs to check what it can cast now
+      break;
+  }
+}
+
+// Reuses the snapshot's vectors so that taking snapshots repeatedly doesn't allocate
+void Entity::SaveState(EntitySnapshot& snapshot) const {
+  snapshot.stats = stats;
+  snapshot.stats_version = stats_version;
+  snapshot.cast_timer = cast_timer.GetState();
+  snapshot.gcd_timer = gcd_timer.GetState();
+  snapshot.five_second_rule_timer = five_second_rule_timer.GetState();
+  snapshot.mp5_timer = mp5_timer.GetState();
 
-  // Auras need to tick before Spells because otherwise you'll, for example,
-  // finish casting Corruption and then immediately afterwards, in the same
-  // millisecond, immediately tick down the aura This was also causing buffs like
-  // e.g. the t4 4pc buffs to expire sooner than they should.
+  snapshot.auras.clear();
   for (const auto& kAura : aura_list) {
-    if (kAura->active && kAura->duration_remaining > 0) {
-      kAura->Tick(kTime);
-    }
+    snapshot.auras.push_back({kAura->duration_timer.GetState(), kAura->tick_timer.GetState(), kAura->ticks_remaining,
+                              kAura->stacks, kAura->active});
   }
 
+  snapshot.dots.clear();
   for (const auto& kDot : dot_list) {
-    if (kDot->active && kDot->tick_timer_remaining > 0) {
-      kDot->Tick(kTime);
-    }
+    snapshot.dots.push_back({kDot->tick_timer.GetState(), kDot->ticks_remaining, kDot->spell_power,
+                             kDot->t5_bonus_modifier, kDot->active, kDot->applied_with_amplify_curse,
+                             kDot->isb_is_active});
   }
 
-  // TLC needs to tick before other spells because otherwise a spell might proc TLC and then later in the same loop,
-  // during the same millisecond of the fight, tick down TLC's cooldown
-  // TODO find a better solution for this since this might occur for other spells as well.
-  if (spells.the_lightning_capacitor != nullptr && spells.the_lightning_capacitor->cooldown_remaining > 0) {
-    spells.the_lightning_capacitor->Tick(kTime);
+  snapshot.spells.clear();
+  for (const auto& kSpell : spell_list) {
+    snapshot.spells.push_back({kSpell->cooldown_timer.GetState(), kSpell->amount_of_casts_this_fight, kSpell->casting});
   }
+}
 
-  for (const auto& kSpell : spell_list) {
-    if (kSpell->name != SpellName::kTheLightningCapacitor && (kSpell->cooldown_remaining > 0 || kSpell->casting)) {
-      kSpell->Tick(kTime);
-    }
+void Entity::RestoreState(const EntitySnapshot& kSnapshot) {
+  if (kSnapshot.auras.size() != aura_list.size() || kSnapshot.dots.size() != dot_list.size() ||
+      kSnapshot.spells.size() != spell_list.size()) {
+    throw std::invalid_argument("the snapshot was taken of " + name + " with different auras, dots or spells");
+  }
+
+  stats = kSnapshot.stats;
+  stats_version = kSnapshot.stats_version;
+  cast_timer.SetState(kSnapshot.cast_timer);
+  gcd_timer.SetState(kSnapshot.gcd_timer);
+  five_second_rule_timer.SetState(kSnapshot.five_second_rule_timer);
+  mp5_timer.SetState(kSnapshot.mp5_timer);
+
+  for (size_t i = 0; i < aura_list.size(); i++) {
+    const auto& kState = kSnapshot.auras[i];
+    aura_list[i]->duration_timer.SetState(kState.duration_timer);
+    aura_list[i]->tick_timer.SetState(kState.tick_timer);
+    aura_list[i]->ticks_remaining = kState.ticks_remaining;
+    aura_list[i]->stacks = kState.stacks;
+    aura_list[i]->active = kState.active;
+  }
+
+  for (size_t i = 0; i < dot_list.size(); i++) {
+    const auto& kState = kSnapshot.dots[i];
+    dot_list[i]->tick_timer.SetState(kState.tick_timer);
+    dot_list[i]->ticks_remaining = kState.ticks_remaining;
+    dot_list[i]->spell_power = kState.spell_power;
+    dot_list[i]->t5_bonus_modifier = kState.t5_bonus_modifier;
+    dot_list[i]->active = kState.active;
+    dot_list[i]->applied_with_amplify_curse = kState.applied_with_amplify_curse;
+    dot_list[i]->isb_is_active = kState.isb_is_active;
+  }
+
+  for (size_t i = 0; i < spell_list.size(); i++) {
+    const auto& kState = kSnapshot.spells[i];
+    spell_list[i]->cooldown_timer.SetState(kState.cooldown_timer);
+    spell_list[i]->amount_of_casts_this_fight = kState.amount_of_casts_this_fight;
+    spell_list[i]->casting = kState.casting;
   }
-}
\ No newline at end of file
+}
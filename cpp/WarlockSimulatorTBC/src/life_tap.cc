@@ -3,7 +3,6 @@
 #include "../include/entity.h"
 #include "../include/player.h"
 #include "../include/talents.h"
-#include "../include/common.h"
 #include "../include/combat_log_breakdown.h"
 #include "../include/pet.h"
 
@@ -12,6 +11,7 @@ LifeTap::LifeTap(Entity& entity)
     mana_return(582),
     modifier(1 * (1 + 0.1 * entity.player->talents.improved_life_tap)) {
   name = SpellName::kLifeTap;
+  id = SpellId::kLifeTap;
 
   coefficient = 0.8;
 
@@ -31,17 +31,17 @@ void LifeTap::Cast() {
   const double kManaGained = entity.stats.mana - kCurrentPlayerMana;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->casts++;
-    entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
+    entity.GetCombatLogBreakdown(id).casts++;
+    entity.GetCombatLogBreakdown(id).iteration_mana_gain += kManaGained;
   }
   if (entity.ShouldWriteToCombatLog()) {
-    entity.CombatLog(name + " " + DoubleToString(kManaGained) + " (" +
-                     DoubleToString(entity.GetSpellPower(false, spell_school)) + " Spell Power - " +
-                     DoubleToString(coefficient, 3) + " Coefficient - " + DoubleToString(modifier * 100, 2) +
-                     "% Modifier)");
+    entity.CombatLog({.type = CombatLogEventType::kLifeTap,
+                      .id = id,
+                      .name = &name,
+                      .values = {kManaGained, entity.GetSpellPower(false, spell_school), coefficient, modifier}});
 
     if (kCurrentPlayerMana + kManaGain > entity.stats.max_mana) {
-      entity.CombatLog(name + " used at too high mana (mana wasted)");
+      entity.CombatLog({.type = CombatLogEventType::kLifeTapManaWasted, .id = id, .name = &name});
     }
   }
 
@@ -52,12 +52,12 @@ void LifeTap::Cast() {
                                       entity.pet->CalculateMaxMana());
 
     if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(entity.pet->name + " gains " + DoubleToString(entity.pet->stats.mana - kCurrentPetMana) +
-                       " mana from Mana Feed");
+      entity.pet->CombatLog(
+          {.type = CombatLogEventType::kManaFeed, .values = {entity.pet->stats.mana - kCurrentPetMana}});
     }
   }
 
-  if (name == SpellName::kDarkPact) {
+  if (id == SpellId::kDarkPact) {
     entity.pet->stats.mana = std::max(0.0, entity.pet->stats.mana - kManaGain);
   }
 }
@@ -65,6 +65,7 @@ void LifeTap::Cast() {
 DarkPact::DarkPact(Entity& entity)
   : LifeTap(entity) {
   name = SpellName::kDarkPact;
+  id = SpellId::kDarkPact;
   mana_return = 700;
   coefficient = 0.96;
   modifier = 1;
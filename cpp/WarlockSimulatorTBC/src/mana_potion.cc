@@ -2,7 +2,6 @@
 
 #include "../include/player.h"
 #include "../include/player_settings.h"
-#include "../include/common.h"
 #include "../include/combat_log_breakdown.h"
 
 ManaPotion::ManaPotion(Player& player)
@@ -23,19 +22,21 @@ void ManaPotion::Cast() {
   const double kManaGained = entity.stats.mana - kCurrentPlayerMana;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
+    entity.GetCombatLogBreakdown(id).iteration_mana_gain += kManaGained;
   }
 
   if (entity.ShouldWriteToCombatLog()) {
-    entity.CombatLog("Player gains " + DoubleToString(kManaGained) + " mana from " + name + " (" +
-                     DoubleToString(round(kCurrentPlayerMana)) + " -> " + DoubleToString(round(entity.stats.mana)) +
-                     ")");
+    entity.CombatLog({.type = CombatLogEventType::kManaGain,
+                      .id = id,
+                      .name = &name,
+                      .values = {kManaGained, round(kCurrentPlayerMana), round(entity.stats.mana)}});
   }
 }
 
 SuperManaPotion::SuperManaPotion(Player& player)
   : ManaPotion(player) {
   name = SpellName::kSuperManaPotion;
+  id = SpellId::kSuperManaPotion;
   min_mana_gain = 1800;
   max_mana_gain = 3000;
   Spell::Setup();
@@ -44,6 +45,7 @@ SuperManaPotion::SuperManaPotion(Player& player)
 DemonicRune::DemonicRune(Player& player)
   : ManaPotion(player) {
   name = SpellName::kDemonicRune;
+  id = SpellId::kDemonicRune;
   min_mana_gain = 900;
   max_mana_gain = 1500;
   Spell::Setup();
@@ -52,9 +54,9 @@ DemonicRune::DemonicRune(Player& player)
 void DemonicRune::Cast() {
   ManaPotion::Cast();
   if (entity.player->spells.chipped_power_core != nullptr) {
-    entity.player->spells.chipped_power_core->cooldown_remaining = cooldown;
+    entity.player->spells.chipped_power_core->cooldown_timer.Start(cooldown);
   }
   if (entity.player->spells.cracked_power_core != nullptr) {
-    entity.player->spells.cracked_power_core->cooldown_remaining = cooldown;
+    entity.player->spells.cracked_power_core->cooldown_timer.Start(cooldown);
   }
 }
\ No newline at end of file
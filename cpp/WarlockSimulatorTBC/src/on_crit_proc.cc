@@ -1,5 +1,3 @@
-#include <utility>
-
 #include "../include/on_crit_proc.h"
 
 #include "../include/entity.h"
@@ -8,8 +6,8 @@
 #include "../include/talents.h"
 #include "../include/aura.h"
 
-OnCritProc::OnCritProc(Player& player, std::shared_ptr<Aura> aura)
-  : SpellProc(player, std::move(aura)) { procs_on_crit = true; }
+OnCritProc::OnCritProc(Player& player, Aura* aura)
+  : SpellProc(player, aura) { procs_on_crit = true; }
 
 void OnCritProc::Setup() {
   SpellProc::Setup();
@@ -19,19 +17,21 @@ void OnCritProc::Setup() {
   }
 }
 
-ImprovedShadowBolt::ImprovedShadowBolt(Player& player, std::shared_ptr<Aura> aura)
-  : OnCritProc(player, std::move(aura)) {
+ImprovedShadowBolt::ImprovedShadowBolt(Player& player, Aura* aura)
+  : OnCritProc(player, aura) {
   name = SpellName::kImprovedShadowBolt;
+  id = SpellId::kImprovedShadowBolt;
   proc_chance = 100;
   on_crit_procs_enabled = !player.settings.using_custom_isb_uptime && player.talents.improved_shadow_bolt > 0;
   OnCritProc::Setup();
 }
 
-bool ImprovedShadowBolt::ShouldProc(Spell* spell) { return spell->name == SpellName::kShadowBolt; }
+bool ImprovedShadowBolt::ShouldProc(Spell* spell) { return spell->id == SpellId::kShadowBolt; }
 
 TheLightningCapacitor::TheLightningCapacitor(Player& player)
   : OnCritProc(player) {
   name = SpellName::kTheLightningCapacitor;
+  id = SpellId::kTheLightningCapacitor;
   cooldown = 2.5;
   min_dmg = 694;
   max_dmg = 806;
@@ -43,7 +43,7 @@ TheLightningCapacitor::TheLightningCapacitor(Player& player)
 }
 
 void TheLightningCapacitor::StartCast(double) {
-  if (cooldown_remaining <= 0) {
+  if (cooldown_timer.Remaining() <= 0) {
     entity.player->auras.the_lightning_capacitor->Apply();
     if (entity.player->auras.the_lightning_capacitor->stacks ==
         entity.player->auras.the_lightning_capacitor->max_stacks) {
@@ -53,18 +53,20 @@ void TheLightningCapacitor::StartCast(double) {
   }
 }
 
-ShiffarsNexusHorn::ShiffarsNexusHorn(Player& player, std::shared_ptr<Aura> aura)
-  : OnCritProc(player, std::move(aura)) {
+ShiffarsNexusHorn::ShiffarsNexusHorn(Player& player, Aura* aura)
+  : OnCritProc(player, aura) {
   name = SpellName::kShiffarsNexusHorn;
+  id = SpellId::kShiffarsNexusHorn;
   cooldown = 45;
   proc_chance = 20;
   is_item = true;
   OnCritProc::Setup();
 }
 
-SextantOfUnstableCurrents::SextantOfUnstableCurrents(Player& player, std::shared_ptr<Aura> aura)
-  : OnCritProc(player, std::move(aura)) {
+SextantOfUnstableCurrents::SextantOfUnstableCurrents(Player& player, Aura* aura)
+  : OnCritProc(player, aura) {
   name = SpellName::kSextantOfUnstableCurrents;
+  id = SpellId::kSextantOfUnstableCurrents;
   cooldown = 45;
   proc_chance = 20;
   is_item = true;
@@ -4,7 +4,7 @@
 #include "../include/player.h"
 #include "../include/player_settings.h"
 
-OnDamageProc::OnDamageProc(Player& player, const std::shared_ptr<Aura>& kAura) : SpellProc(player, kAura) {
+OnDamageProc::OnDamageProc(Player& player, Aura* aura) : SpellProc(player, aura) {
   procs_on_damage = true;
 }
 
@@ -16,9 +16,10 @@ void OnDamageProc::Setup() {
   }
 }
 
-ShatteredSunPendantOfAcumenAldor::ShatteredSunPendantOfAcumenAldor(Player& player, std::shared_ptr<Aura> aura)
+ShatteredSunPendantOfAcumenAldor::ShatteredSunPendantOfAcumenAldor(Player& player, Aura* aura)
   : OnDamageProc(player, aura) {
   name = SpellName::kShatteredSunPendantOfAcumenAldor;
+  id = SpellId::kShatteredSunPendantOfAcumenAldor;
   cooldown = 45;
   proc_chance = 15;
   is_item = true;
@@ -29,6 +30,7 @@ ShatteredSunPendantOfAcumenAldor::ShatteredSunPendantOfAcumenAldor(Player& playe
 ShatteredSunPendantOfAcumenScryers::ShatteredSunPendantOfAcumenScryers(Player& player)
   : OnDamageProc(player) {
   name = SpellName::kShatteredSunPendantOfAcumenScryers;
+  id = SpellId::kShatteredSunPendantOfAcumenScryers;
   cooldown = 45;
   proc_chance = 15;
   min_dmg = 333;
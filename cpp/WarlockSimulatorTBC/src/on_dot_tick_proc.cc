@@ -4,8 +4,8 @@
 #include "../include/damage_over_time.h"
 #include "../include/player.h"
 
-OnDotTickProc::OnDotTickProc(Player& player, const std::shared_ptr<Aura>& kAura)
-  : SpellProc(player, kAura) {
+OnDotTickProc::OnDotTickProc(Player& player, Aura* aura)
+  : SpellProc(player, aura) {
   procs_on_dot_ticks = true;
 }
 
@@ -19,18 +19,20 @@ void OnDotTickProc::Setup() {
   }
 }
 
-AshtongueTalismanOfShadows::AshtongueTalismanOfShadows(Player& player, const std::shared_ptr<Aura>& kAura)
-  : OnDotTickProc(player, kAura) {
+AshtongueTalismanOfShadows::AshtongueTalismanOfShadows(Player& player, Aura* aura)
+  : OnDotTickProc(player, aura) {
   name = SpellName::kAshtongueTalismanOfShadows;
+  id = SpellId::kAshtongueTalismanOfShadows;
   proc_chance = 20;
   OnDotTickProc::Setup();
 }
 
-bool AshtongueTalismanOfShadows::ShouldProc(DamageOverTime* spell) { return spell->name == SpellName::kCorruption; }
+bool AshtongueTalismanOfShadows::ShouldProc(DamageOverTime* spell) { return spell->id == SpellId::kCorruption; }
 
 TimbalsFocusingCrystal::TimbalsFocusingCrystal(Player& player)
   : OnDotTickProc(player) {
   name = SpellName::kTimbalsFocusingCrystal;
+  id = SpellId::kTimbalsFocusingCrystal;
   cooldown = 15;
   proc_chance = 10;
   min_dmg = 285;
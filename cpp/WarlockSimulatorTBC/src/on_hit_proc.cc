@@ -1,13 +1,11 @@
-#include <utility>
-
 #include "../include/on_hit_proc.h"
 
 #include "../include/entity.h"
 #include "../include/player.h"
 #include "../include/sets.h"
 
-OnHitProc::OnHitProc(Entity& entity, std::shared_ptr<Aura> aura)
-  : SpellProc(entity, std::move(aura)) { procs_on_hit = true; }
+OnHitProc::OnHitProc(Entity& entity, Aura* aura)
+  : SpellProc(entity, aura) { procs_on_hit = true; }
 
 void OnHitProc::Setup() {
   SpellProc::Setup();
@@ -20,6 +18,7 @@ void OnHitProc::Setup() {
 MarkOfDefiance::MarkOfDefiance(Entity& entity)
   : OnHitProc(entity) {
   name = SpellName::kMarkOfDefiance;
+  id = SpellId::kMarkOfDefiance;
   cooldown = 17;
   proc_chance = 15;
   is_item = true;
@@ -32,6 +31,7 @@ MarkOfDefiance::MarkOfDefiance(Entity& entity)
 InsightfulEarthstormDiamond::InsightfulEarthstormDiamond(Entity& entity)
   : OnHitProc(entity) {
   name = SpellName::kInsightfulEarthstormDiamond;
+  id = SpellId::kInsightfulEarthstormDiamond;
   cooldown = 15;
   proc_chance = 5;
   is_item = true;
@@ -40,45 +40,50 @@ InsightfulEarthstormDiamond::InsightfulEarthstormDiamond(Entity& entity)
   OnHitProc::Setup();
 }
 
-BladeOfWizardry::BladeOfWizardry(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+BladeOfWizardry::BladeOfWizardry(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kBladeOfWizardry;
+  id = SpellId::kBladeOfWizardry;
   cooldown = 50;
   proc_chance = 15;
   is_item = true;
   OnHitProc::Setup();
 }
 
-RobeOfTheElderScribes::RobeOfTheElderScribes(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+RobeOfTheElderScribes::RobeOfTheElderScribes(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kRobeOfTheElderScribes;
+  id = SpellId::kRobeOfTheElderScribes;
   cooldown = 50;
   proc_chance = 20;
   is_item = true;
   OnHitProc::Setup();
 }
 
-QuagmirransEye::QuagmirransEye(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+QuagmirransEye::QuagmirransEye(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kQuagmirransEye;
+  id = SpellId::kQuagmirransEye;
   cooldown = 45;
   proc_chance = 10;
   is_item = true;
   OnHitProc::Setup();
 }
 
-BandOfTheEternalSage::BandOfTheEternalSage(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+BandOfTheEternalSage::BandOfTheEternalSage(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kBandOfTheEternalSage;
+  id = SpellId::kBandOfTheEternalSage;
   cooldown = 60;
   proc_chance = 10;
   is_item = true;
   OnHitProc::Setup();
 }
 
-MysticalSkyfireDiamond::MysticalSkyfireDiamond(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+MysticalSkyfireDiamond::MysticalSkyfireDiamond(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kMysticalSkyfireDiamond;
+  id = SpellId::kMysticalSkyfireDiamond;
   cooldown = 35;
   proc_chance = 15;
   is_item = true;
@@ -88,15 +93,17 @@ MysticalSkyfireDiamond::MysticalSkyfireDiamond(Entity& entity, std::shared_ptr<A
 JudgementOfWisdom::JudgementOfWisdom(Entity& entity)
   : OnHitProc(entity) {
   name = SpellName::kJudgementOfWisdom;
+  id = SpellId::kJudgementOfWisdom;
   mana_gain = 74;
   gain_mana_on_cast = true;
   proc_chance = 50;
   OnHitProc::Setup();
 }
 
-Flameshadow::Flameshadow(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+Flameshadow::Flameshadow(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kFlameshadow;
+  id = SpellId::kFlameshadow;
   proc_chance = 5;
   on_hit_procs_enabled = entity.player->sets.t4 >= 2;
   OnHitProc::Setup();
@@ -104,9 +111,10 @@ Flameshadow::Flameshadow(Entity& entity, std::shared_ptr<Aura> aura)
 
 bool Flameshadow::ShouldProc(Spell* spell) { return spell->spell_school == SpellSchool::kShadow; }
 
-Shadowflame::Shadowflame(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+Shadowflame::Shadowflame(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kShadowflame;
+  id = SpellId::kShadowflame;
   proc_chance = 5;
   on_hit_procs_enabled = entity.player->sets.t4 >= 2;
   OnHitProc::Setup();
@@ -114,39 +122,44 @@ Shadowflame::Shadowflame(Entity& entity, std::shared_ptr<Aura> aura)
 
 bool Shadowflame::ShouldProc(Spell* spell) { return spell->spell_school == SpellSchool::kFire; }
 
-Spellstrike::Spellstrike(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+Spellstrike::Spellstrike(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kSpellstrike;
+  id = SpellId::kSpellstrike;
   proc_chance = 5;
   on_hit_procs_enabled = entity.player->sets.spellstrike == 2;
   OnHitProc::Setup();
 }
 
-ManaEtched4Set::ManaEtched4Set(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+ManaEtched4Set::ManaEtched4Set(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kManaEtched4Set;
+  id = SpellId::kManaEtched4Set;
   proc_chance = 2;
   on_hit_procs_enabled = entity.player->sets.mana_etched >= 4;
   OnHitProc::Setup();
 }
 
-WrathOfCenarius::WrathOfCenarius(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+WrathOfCenarius::WrathOfCenarius(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kWrathOfCenarius;
+  id = SpellId::kWrathOfCenarius;
   proc_chance = 5;
   OnHitProc::Setup();
 }
 
-DarkmoonCardCrusade::DarkmoonCardCrusade(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+DarkmoonCardCrusade::DarkmoonCardCrusade(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kDarkmoonCardCrusade;
+  id = SpellId::kDarkmoonCardCrusade;
   proc_chance = 100;
   OnHitProc::Setup();
 }
 
-DemonicFrenzy::DemonicFrenzy(Entity& entity, std::shared_ptr<Aura> aura)
-  : OnHitProc(entity, std::move(aura)) {
+DemonicFrenzy::DemonicFrenzy(Entity& entity, Aura* aura)
+  : OnHitProc(entity, aura) {
   name = SpellName::kDemonicFrenzy;
+  id = SpellId::kDemonicFrenzy;
   proc_chance = 100;
   OnHitProc::Setup();
 }
\ No newline at end of file
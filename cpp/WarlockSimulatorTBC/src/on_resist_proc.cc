@@ -1,11 +1,9 @@
-#include <utility>
-
 #include "../include/on_resist_proc.h"
 
 #include "../include/player.h"
 
-OnResistProc::OnResistProc(Player& player, std::shared_ptr<Aura> aura)
-  : SpellProc(player, std::move(aura)) {
+OnResistProc::OnResistProc(Player& player, Aura* aura)
+  : SpellProc(player, aura) {
   procs_on_resist = true;
 }
 
@@ -17,9 +15,10 @@ void OnResistProc::Setup() {
   }
 }
 
-EyeOfMagtheridon::EyeOfMagtheridon(Player& player, const std::shared_ptr<Aura>& kAura)
-  : OnResistProc(player, kAura) {
+EyeOfMagtheridon::EyeOfMagtheridon(Player& player, Aura* aura)
+  : OnResistProc(player, aura) {
   name = SpellName::kEyeOfMagtheridon;
+  id = SpellId::kEyeOfMagtheridon;
   proc_chance = 100;
   is_item = true;
   OnResistProc::Setup();
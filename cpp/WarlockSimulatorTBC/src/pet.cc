@@ -8,7 +8,6 @@
 #include "../include/on_hit_proc.h"
 #include "../include/aura_selection.h"
 #include "../include/items.h"
-#include "../include/common.h"
 #include "../include/stat.h"
 
 Pet::Pet(Player& player_param, const EmbindConstant kSelectedPet)
@@ -51,29 +50,29 @@ Pet::Pet(Player& player_param, const EmbindConstant kSelectedPet)
 
 void Pet::Initialize(Simulation* simulation_ptr) {
   Entity::Initialize(simulation_ptr);
-  pet = shared_from_this();
+  pet = this;
   Setup();
 
   if (pet_name == PetName::kImp) {
-    spells.firebolt = std::make_shared<ImpFirebolt>(*this);
+    spells.firebolt = player->arena.Create<ImpFirebolt>(*this);
   } else {
-    spells.melee = std::make_shared<PetMelee>(*this);
+    spells.melee = player->arena.Create<PetMelee>(*this);
 
     if (pet_name == PetName::kSuccubus) {
-      spells.lash_of_pain = std::make_shared<SuccubusLashOfPain>(*this);
+      spells.lash_of_pain = player->arena.Create<SuccubusLashOfPain>(*this);
     } else if (pet_name == PetName::kFelguard) {
-      spells.cleave = std::make_shared<FelguardCleave>(*this);
-      auras.demonic_frenzy = std::make_shared<DemonicFrenzyAura>(*this);
-      spells.demonic_frenzy = std::make_shared<DemonicFrenzy>(*this, auras.demonic_frenzy);
+      spells.cleave = player->arena.Create<FelguardCleave>(*this);
+      auras.demonic_frenzy = player->arena.Create<DemonicFrenzyAura>(*this);
+      spells.demonic_frenzy = player->arena.Create<DemonicFrenzy>(*this, auras.demonic_frenzy);
     }
 
     if (player->selected_auras.pet_battle_squawk) {
-      auras.battle_squawk = std::make_shared<BattleSquawkAura>(*this);
+      auras.battle_squawk = player->arena.Create<BattleSquawkAura>(*this);
     }
   }
 
   if (player->settings.prepop_black_book) {
-    auras.black_book = std::make_shared<BlackBookAura>(*this);
+    auras.black_book = player->arena.Create<BlackBookAura>(*this);
   }
 }
 
@@ -221,11 +220,11 @@ void Pet::CalculateStatsFromAuras() {
     enemy_damage_reduction_from_armor = 1.0;
 
     if (player->settings.enemy_level >= 60) {
-      enemy_damage_reduction_from_armor = 1 - player->settings.enemy_armor / (player->settings.enemy_armor - 22167.5 +
-                                                                              467.5 * player->settings.enemy_level);
+      enemy_damage_reduction_from_armor =
+          1 - player->enemy_armor / (player->enemy_armor - 22167.5 + 467.5 * player->settings.enemy_level);
     } else {
       enemy_damage_reduction_from_armor =
-          1 - player->settings.enemy_armor / (player->settings.enemy_armor + 400.0 + 85 * player->settings.enemy_level);
+          1 - player->enemy_armor / (player->enemy_armor + 400.0 + 85 * player->settings.enemy_level);
     }
 
     enemy_damage_reduction_from_armor = std::max(0.25, enemy_damage_reduction_from_armor);
@@ -330,41 +329,34 @@ double Pet::GetStrength() const { return stats.strength * stats.strength_modifie
 
 double Pet::GetAgility() const { return stats.agility * stats.agility_modifier; }
 
-void Pet::Tick(const double kTime) {
-  Entity::Tick(kTime);
-
-  // MP5
-  if (mp5_timer_remaining <= 0) {
-    auto mana_gain = stats.mp5;
-    mp5_timer_remaining = 5;
-
-    // Formulas from Max on the warlock discord
-    // https://discord.com/channels/253210018697052162/823476479550816266/836007015762886707
-    // &
-    // https://discord.com/channels/253210018697052162/823476479550816266/839484387741138994
-    // Mana regen from spirit
-    if (five_second_rule_timer_remaining <= 0) {
-      if (pet_name == PetName::kImp) {
-        mana_gain += GetSpirit() + 0.7 * GetIntellect() - 258;
-      } else if (pet_name == PetName::kFelguard || pet_name == PetName::kSuccubus) {
-        mana_gain += 0.75 * GetSpirit() + 0.62 * GetIntellect() - 108;
-      }
+void Pet::Mp5Tick() {
+  auto mana_gain = stats.mp5;
+
+  // Formulas from Max on the warlock discord
+  // https://discord.com/channels/253210018697052162/823476479550816266/836007015762886707
+  // &
+  // https://discord.com/channels/253210018697052162/823476479550816266/839484387741138994
+  // Mana regen from spirit
+  if (five_second_rule_timer.Remaining() <= 0) {
+    if (pet_name == PetName::kImp) {
+      mana_gain += GetSpirit() + 0.7 * GetIntellect() - 258;
+    } else if (pet_name == PetName::kFelguard || pet_name == PetName::kSuccubus) {
+      mana_gain += 0.75 * GetSpirit() + 0.62 * GetIntellect() - 108;
     }
-    // Mana regen while the 5 second spirit regen timer is active (no bonus from
-    // spirit)
-    else {
-      if (pet_name == PetName::kImp) {
-        mana_gain += 0.375 * GetIntellect() - 123;
-      } else if (pet_name == PetName::kFelguard || pet_name == PetName::kSuccubus) {
-        mana_gain += 0.365 * GetIntellect() - 48;
-      }
+  }
+  // Mana regen while the 5 second spirit regen timer is active (no bonus from
+  // spirit)
+  else {
+    if (pet_name == PetName::kImp) {
+      mana_gain += 0.375 * GetIntellect() - 123;
+    } else if (pet_name == PetName::kFelguard || pet_name == PetName::kSuccubus) {
+      mana_gain += 0.365 * GetIntellect() - 48;
     }
+  }
 
-    const auto current_mana = stats.mana;
-    stats.mana = std::min(CalculateMaxMana(), stats.mana + static_cast<int>(mana_gain));
-    if (stats.mana > current_mana && ShouldWriteToCombatLog()) {
-      CombatLog(name + " gains " + DoubleToString(round(mana_gain)) + " mana from Mp5/Spirit regeneration (" +
-                DoubleToString(round(current_mana)) + " -> " + DoubleToString(stats.mana) + ")");
-    }
+  const auto current_mana = stats.mana;
+  stats.mana = std::min(CalculateMaxMana(), stats.mana + static_cast<int>(mana_gain));
+  if (stats.mana > current_mana && ShouldWriteToCombatLog()) {
+    CombatLog({.type = CombatLogEventType::kPetManaRegen, .values = {mana_gain, current_mana, stats.mana}});
   }
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #include "../include/player.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "../include/player_settings.h"
@@ -24,6 +25,8 @@
 #include "../include/life_tap.h"
 #include "../include/on_resist_proc.h"
 #include "../include/bindings.h"
+#include "../include/simulation.h"
+#include "../include/profiling.h"
 
 Player::Player(PlayerSettings& settings)
   : Entity(nullptr, settings, EntityType::kPlayer),
@@ -36,7 +39,7 @@ Player::Player(PlayerSettings& settings)
   infinite_mana = settings.infinite_player_mana;
 
   if (recording_combat_log_breakdown) {
-    combat_log_breakdown.insert({StatName::kMp5, std::make_shared<CombatLogBreakdown>(StatName::kMp5)});
+    AddCombatLogBreakdown(SpellId::kMp5, StatName::kMp5);
   }
 
   if (settings.custom_stat == EmbindConstant::kStamina) {
@@ -98,23 +101,25 @@ Player::Player(PlayerSettings& settings)
     stats.spell_power += 15;
   }
 
-  // Enemy Armor Reduction
+  // Enemy Armor Reduction. This is kept on the player instead of being written back into the settings so that several
+  // players can be built from the same settings (e.g. one per simulation thread).
+  enemy_armor = settings.enemy_armor;
   if (selected_auras.faerie_fire) {
-    settings.enemy_armor -= 610;
+    enemy_armor -= 610;
   }
   if (selected_auras.sunder_armor && selected_auras.expose_armor && settings.improved_expose_armor == 2 ||
       selected_auras.expose_armor && !selected_auras.sunder_armor) {
-    settings.enemy_armor -= static_cast<int>(2050 * (1 + 0.25 * settings.improved_expose_armor));
+    enemy_armor -= static_cast<int>(2050 * (1 + 0.25 * settings.improved_expose_armor));
   } else if (selected_auras.sunder_armor) {
-    settings.enemy_armor -= 520 * 5;
+    enemy_armor -= 520 * 5;
   }
   if (selected_auras.curse_of_recklessness) {
-    settings.enemy_armor -= 800;
+    enemy_armor -= 800;
   }
   if (selected_auras.annihilator) {
-    settings.enemy_armor -= 600;
+    enemy_armor -= 600;
   }
-  settings.enemy_armor = std::max(0, settings.enemy_armor);
+  enemy_armor = std::max(0, enemy_armor);
 
   // Health & Mana
   stats.health = (stats.health + Entity::GetStamina() * StatConstant::kHealthPerStamina) *
@@ -131,11 +136,11 @@ void Player::Initialize(Simulation* simulation_ptr) {
   player = this;
 
   if (!settings.sacrificing_pet || talents.demonic_sacrifice == 0) {
-    pet = std::make_shared<Pet>(*this, settings.selected_pet);
+    pet = arena.Create<Pet>(*this, settings.selected_pet);
     pet->Initialize(simulation_ptr);
   } else if (talents.demonic_sacrifice == 1 && settings.sacrificing_pet &&
              settings.selected_pet == EmbindConstant::kFelhunter) {
-    auras.fel_energy = std::make_shared<FelEnergyAura>(*this);
+    auras.fel_energy = arena.Create<FelEnergyAura>(*this);
   }
 
   for (const auto& trinket_id : equipped_trinket_ids) {
@@ -192,320 +197,320 @@ void Player::Initialize(Simulation* simulation_ptr) {
   // Auras
   if (settings.fight_type == EmbindConstant::kSingleTarget) {
     if (talents.improved_shadow_bolt > 0) {
-      auras.improved_shadow_bolt = std::make_shared<ImprovedShadowBoltAura>(*this);
+      auras.improved_shadow_bolt = arena.Create<ImprovedShadowBoltAura>(*this);
     }
     if (settings.has_corruption || settings.rotation_option == EmbindConstant::kSimChooses) {
-      auras.corruption = std::make_shared<CorruptionDot>(*this);
+      auras.corruption = arena.Create<CorruptionDot>(*this);
     }
     if (talents.unstable_affliction == 1 &&
         (settings.has_unstable_affliction || settings.rotation_option == EmbindConstant::kSimChooses)) {
-      auras.unstable_affliction = std::make_shared<UnstableAfflictionDot>(*this);
+      auras.unstable_affliction = arena.Create<UnstableAfflictionDot>(*this);
     }
     if (talents.siphon_life == 1 &&
         (settings.has_siphon_life || settings.rotation_option == EmbindConstant::kSimChooses)) {
-      auras.siphon_life = std::make_shared<SiphonLifeDot>(*this);
+      auras.siphon_life = arena.Create<SiphonLifeDot>(*this);
     }
     if (settings.has_immolate || settings.rotation_option == EmbindConstant::kSimChooses) {
-      auras.immolate = std::make_shared<ImmolateDot>(*this);
+      auras.immolate = arena.Create<ImmolateDot>(*this);
     }
     if (settings.has_curse_of_agony || settings.has_curse_of_doom) {
-      auras.curse_of_agony = std::make_shared<CurseOfAgonyDot>(*this);
+      auras.curse_of_agony = arena.Create<CurseOfAgonyDot>(*this);
     }
     if (settings.has_curse_of_the_elements) {
-      auras.curse_of_the_elements = std::make_shared<CurseOfTheElementsAura>(*this);
+      auras.curse_of_the_elements = arena.Create<CurseOfTheElementsAura>(*this);
     }
     if (settings.has_curse_of_recklessness) {
-      auras.curse_of_recklessness = std::make_shared<CurseOfRecklessnessAura>(*this);
+      auras.curse_of_recklessness = arena.Create<CurseOfRecklessnessAura>(*this);
     }
     if (settings.has_curse_of_doom) {
-      auras.curse_of_doom = std::make_shared<CurseOfDoomDot>(*this);
+      auras.curse_of_doom = arena.Create<CurseOfDoomDot>(*this);
     }
     if (talents.nightfall > 0) {
-      auras.shadow_trance = std::make_shared<ShadowTranceAura>(*this);
+      auras.shadow_trance = arena.Create<ShadowTranceAura>(*this);
     }
     if (talents.amplify_curse == 1 &&
         (settings.has_amplify_curse || settings.rotation_option == EmbindConstant::kSimChooses)) {
-      auras.amplify_curse = std::make_shared<AmplifyCurseAura>(*this);
+      auras.amplify_curse = arena.Create<AmplifyCurseAura>(*this);
     }
   }
   if (selected_auras.airmans_ribbon_of_gallantry) {
-    auras.airmans_ribbon_of_gallantry = std::make_shared<AirmansRibbonOfGallantryAura>(*this);
+    auras.airmans_ribbon_of_gallantry = arena.Create<AirmansRibbonOfGallantryAura>(*this);
   }
   if (selected_auras.mana_tide_totem) {
-    auras.mana_tide_totem = std::make_shared<ManaTideTotemAura>(*this);
+    auras.mana_tide_totem = arena.Create<ManaTideTotemAura>(*this);
   }
   if (selected_auras.chipped_power_core) {
-    auras.chipped_power_core = std::make_shared<ChippedPowerCoreAura>(*this);
+    auras.chipped_power_core = arena.Create<ChippedPowerCoreAura>(*this);
   }
   if (selected_auras.cracked_power_core) {
-    auras.cracked_power_core = std::make_shared<CrackedPowerCoreAura>(*this);
+    auras.cracked_power_core = arena.Create<CrackedPowerCoreAura>(*this);
   }
   if (selected_auras.power_infusion) {
-    auras.power_infusion = std::make_shared<PowerInfusionAura>(*this);
+    auras.power_infusion = arena.Create<PowerInfusionAura>(*this);
   }
   if (selected_auras.innervate) {
-    auras.innervate = std::make_shared<InnervateAura>(*this);
+    auras.innervate = arena.Create<InnervateAura>(*this);
   }
   if (selected_auras.bloodlust) {
-    auras.bloodlust = std::make_shared<BloodlustAura>(*this);
+    auras.bloodlust = arena.Create<BloodlustAura>(*this);
   }
   if (selected_auras.destruction_potion) {
-    auras.destruction_potion = std::make_shared<DestructionPotionAura>(*this);
+    auras.destruction_potion = arena.Create<DestructionPotionAura>(*this);
   }
   if (selected_auras.flame_cap) {
-    auras.flame_cap = std::make_shared<FlameCapAura>(*this);
+    auras.flame_cap = arena.Create<FlameCapAura>(*this);
   }
   if (settings.race == EmbindConstant::kOrc) {
-    auras.blood_fury = std::make_shared<BloodFuryAura>(*this);
+    auras.blood_fury = arena.Create<BloodFuryAura>(*this);
   }
   if (selected_auras.drums_of_battle) {
-    auras.drums_of_battle = std::make_shared<DrumsOfBattleAura>(*this);
+    auras.drums_of_battle = arena.Create<DrumsOfBattleAura>(*this);
   } else if (selected_auras.drums_of_war) {
-    auras.drums_of_war = std::make_shared<DrumsOfWarAura>(*this);
+    auras.drums_of_war = arena.Create<DrumsOfWarAura>(*this);
   } else if (selected_auras.drums_of_restoration) {
-    auras.drums_of_restoration = std::make_shared<DrumsOfRestorationAura>(*this);
+    auras.drums_of_restoration = arena.Create<DrumsOfRestorationAura>(*this);
   }
   if (items.main_hand == ItemId::kBladeOfWizardry) {
-    auras.blade_of_wizardry = std::make_shared<BladeOfWizardryAura>(*this);
+    auras.blade_of_wizardry = arena.Create<BladeOfWizardryAura>(*this);
   }
   if (items.neck == ItemId::kShatteredSunPendantOfAcumen && settings.exalted_with_shattrath_faction) {
     if (settings.shattrath_faction == EmbindConstant::kAldor) {
-      auras.shattered_sun_pendant_of_acumen_aldor = std::make_shared<ShatteredSunPendantOfAcumenAldorAura>(*this);
+      auras.shattered_sun_pendant_of_acumen_aldor = arena.Create<ShatteredSunPendantOfAcumenAldorAura>(*this);
     } else if (settings.shattrath_faction == EmbindConstant::kScryers) {
-      spells.shattered_sun_pendant_of_acumen_scryers = std::make_shared<ShatteredSunPendantOfAcumenScryers>(*this);
+      spells.shattered_sun_pendant_of_acumen_scryers = arena.Create<ShatteredSunPendantOfAcumenScryers>(*this);
     }
   }
   if (items.chest == ItemId::kRobeOfTheElderScribes) {
-    auras.robe_of_the_elder_scribes = std::make_shared<RobeOfTheElderScribesAura>(*this);
+    auras.robe_of_the_elder_scribes = arena.Create<RobeOfTheElderScribesAura>(*this);
   }
   if (settings.meta_gem_id == ItemId::kMysticalSkyfireDiamond) {
-    auras.mystical_skyfire_diamond = std::make_shared<MysticalSkyfireDiamondAura>(*this);
+    auras.mystical_skyfire_diamond = arena.Create<MysticalSkyfireDiamondAura>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kEyeOfMagtheridon) !=
       equipped_trinket_ids.end()) {
-    auras.eye_of_magtheridon = std::make_shared<EyeOfMagtheridonAura>(*this);
-    spells.eye_of_magtheridon = std::make_shared<EyeOfMagtheridon>(*this, auras.eye_of_magtheridon);
+    auras.eye_of_magtheridon = arena.Create<EyeOfMagtheridonAura>(*this);
+    spells.eye_of_magtheridon = arena.Create<EyeOfMagtheridon>(*this, auras.eye_of_magtheridon);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kAshtongueTalismanOfShadows) !=
       equipped_trinket_ids.end()) {
-    auras.ashtongue_talisman_of_shadows = std::make_shared<AshtongueTalismanOfShadowsAura>(*this);
+    auras.ashtongue_talisman_of_shadows = arena.Create<AshtongueTalismanOfShadowsAura>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kDarkmoonCardCrusade) !=
       equipped_trinket_ids.end()) {
-    auras.darkmoon_card_crusade = std::make_shared<DarkmoonCardCrusadeAura>(*this);
+    auras.darkmoon_card_crusade = arena.Create<DarkmoonCardCrusadeAura>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kTheLightningCapacitor) !=
       equipped_trinket_ids.end()) {
-    auras.the_lightning_capacitor = std::make_shared<TheLightningCapacitorAura>(*this);
+    auras.the_lightning_capacitor = arena.Create<TheLightningCapacitorAura>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kQuagmirransEye) !=
       equipped_trinket_ids.end()) {
-    auras.quagmirrans_eye = std::make_shared<QuagmirransEyeAura>(*this);
+    auras.quagmirrans_eye = arena.Create<QuagmirransEyeAura>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kShiffarsNexusHorn) !=
       equipped_trinket_ids.end()) {
-    auras.shiffars_nexus_horn = std::make_shared<ShiffarsNexusHornAura>(*this);
+    auras.shiffars_nexus_horn = arena.Create<ShiffarsNexusHornAura>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kSextantOfUnstableCurrents) !=
       equipped_trinket_ids.end()) {
-    auras.sextant_of_unstable_currents = std::make_shared<SextantOfUnstableCurrentsAura>(*this);
+    auras.sextant_of_unstable_currents = arena.Create<SextantOfUnstableCurrentsAura>(*this);
   }
   if (std::find(equipped_ring_ids.begin(), equipped_ring_ids.end(), ItemId::kBandOfTheEternalSage) !=
       equipped_ring_ids.end()) {
-    auras.band_of_the_eternal_sage = std::make_shared<BandOfTheEternalSageAura>(*this);
+    auras.band_of_the_eternal_sage = arena.Create<BandOfTheEternalSageAura>(*this);
   }
   if (std::find(equipped_ring_ids.begin(), equipped_ring_ids.end(), ItemId::kWrathOfCenarius) !=
       equipped_ring_ids.end()) {
-    auras.wrath_of_cenarius = std::make_shared<WrathOfCenariusAura>(*this);
+    auras.wrath_of_cenarius = arena.Create<WrathOfCenariusAura>(*this);
   }
   if (sets.t4 >= 2) {
-    auras.flameshadow = std::make_shared<FlameshadowAura>(*this);
-    auras.shadowflame = std::make_shared<ShadowflameAura>(*this);
+    auras.flameshadow = arena.Create<FlameshadowAura>(*this);
+    auras.shadowflame = arena.Create<ShadowflameAura>(*this);
   }
   if (sets.spellstrike >= 2) {
-    auras.spellstrike = std::make_shared<SpellstrikeAura>(*this);
+    auras.spellstrike = arena.Create<SpellstrikeAura>(*this);
   }
   if (sets.mana_etched >= 4) {
-    auras.mana_etched_4_set = std::make_shared<ManaEtched4SetAura>(*this);
+    auras.mana_etched_4_set = arena.Create<ManaEtched4SetAura>(*this);
   }
 
   // Spells
-  spells.life_tap = std::make_shared<LifeTap>(*this);
+  spells.life_tap = arena.Create<LifeTap>(*this);
   if (settings.fight_type == EmbindConstant::kAoe) {
-    spells.seed_of_corruption = std::make_shared<SeedOfCorruption>(*this);
+    spells.seed_of_corruption = arena.Create<SeedOfCorruption>(*this);
   } else {
     if (settings.has_shadow_bolt || talents.nightfall > 0 || settings.rotation_option == EmbindConstant::kSimChooses) {
-      spells.shadow_bolt = std::make_shared<ShadowBolt>(*this);
+      spells.shadow_bolt = arena.Create<ShadowBolt>(*this);
     }
     if (settings.has_incinerate || settings.rotation_option == EmbindConstant::kSimChooses) {
-      spells.incinerate = std::make_shared<Incinerate>(*this);
+      spells.incinerate = arena.Create<Incinerate>(*this);
     }
     if (settings.has_searing_pain || settings.rotation_option == EmbindConstant::kSimChooses) {
-      spells.searing_pain = std::make_shared<SearingPain>(*this);
+      spells.searing_pain = arena.Create<SearingPain>(*this);
     }
     if (settings.has_death_coil || settings.rotation_option == EmbindConstant::kSimChooses) {
-      spells.death_coil = std::make_shared<DeathCoil>(*this);
+      spells.death_coil = arena.Create<DeathCoil>(*this);
     }
     if (talents.conflagrate == 1 &&
         (settings.has_conflagrate || settings.rotation_option == EmbindConstant::kSimChooses)) {
-      spells.conflagrate = std::make_shared<Conflagrate>(*this);
+      spells.conflagrate = arena.Create<Conflagrate>(*this);
     }
     if (talents.shadowburn == 1 &&
         (settings.has_shadow_burn || settings.rotation_option == EmbindConstant::kSimChooses)) {
-      spells.shadowburn = std::make_shared<Shadowburn>(*this);
+      spells.shadowburn = arena.Create<Shadowburn>(*this);
     }
     if (talents.shadowfury == 1 && (settings.has_shadowfury || settings.rotation_option == EmbindConstant::kSimChooses)) {
-      spells.shadowfury = std::make_shared<Shadowfury>(*this);
+      spells.shadowfury = arena.Create<Shadowfury>(*this);
     }
     if (auras.corruption != nullptr) {
-      spells.corruption = std::make_shared<Corruption>(*this, nullptr, auras.corruption);
+      spells.corruption = arena.Create<Corruption>(*this, nullptr, auras.corruption);
       auras.corruption->parent_spell = spells.corruption;
     }
     if (auras.unstable_affliction != nullptr) {
-      spells.unstable_affliction = std::make_shared<UnstableAffliction>(*this, nullptr, auras.unstable_affliction);
+      spells.unstable_affliction = arena.Create<UnstableAffliction>(*this, nullptr, auras.unstable_affliction);
       auras.unstable_affliction->parent_spell = spells.unstable_affliction;
     }
     if (auras.siphon_life != nullptr) {
-      spells.siphon_life = std::make_shared<SiphonLife>(*this, nullptr, auras.siphon_life);
+      spells.siphon_life = arena.Create<SiphonLife>(*this, nullptr, auras.siphon_life);
       auras.siphon_life->parent_spell = spells.siphon_life;
     }
     if (auras.immolate != nullptr) {
-      spells.immolate = std::make_shared<Immolate>(*this, nullptr, auras.immolate);
+      spells.immolate = arena.Create<Immolate>(*this, nullptr, auras.immolate);
       auras.immolate->parent_spell = spells.immolate;
     }
     if (auras.curse_of_agony != nullptr || auras.curse_of_doom != nullptr) {
-      spells.curse_of_agony = std::make_shared<CurseOfAgony>(*this, nullptr, auras.curse_of_agony);
+      spells.curse_of_agony = arena.Create<CurseOfAgony>(*this, nullptr, auras.curse_of_agony);
       auras.curse_of_agony->parent_spell = spells.curse_of_agony;
     }
     if (auras.curse_of_the_elements != nullptr) {
-      spells.curse_of_the_elements = std::make_shared<CurseOfTheElements>(*this, auras.curse_of_the_elements);
+      spells.curse_of_the_elements = arena.Create<CurseOfTheElements>(*this, auras.curse_of_the_elements);
     }
     if (auras.curse_of_recklessness != nullptr) {
-      spells.curse_of_recklessness = std::make_shared<CurseOfRecklessness>(*this, auras.curse_of_recklessness);
+      spells.curse_of_recklessness = arena.Create<CurseOfRecklessness>(*this, auras.curse_of_recklessness);
     }
     if (auras.curse_of_doom != nullptr) {
-      spells.curse_of_doom = std::make_shared<CurseOfDoom>(*this, nullptr, auras.curse_of_doom);
+      spells.curse_of_doom = arena.Create<CurseOfDoom>(*this, nullptr, auras.curse_of_doom);
       auras.curse_of_doom->parent_spell = spells.curse_of_doom;
     }
     if (auras.amplify_curse != nullptr) {
-      spells.amplify_curse = std::make_shared<AmplifyCurse>(*this, auras.amplify_curse);
+      spells.amplify_curse = arena.Create<AmplifyCurse>(*this, auras.amplify_curse);
     }
   }
   if (auras.improved_shadow_bolt != nullptr) {
-    spells.improved_shadow_bolt = std::make_shared<ImprovedShadowBolt>(*this, auras.improved_shadow_bolt);
+    spells.improved_shadow_bolt = arena.Create<ImprovedShadowBolt>(*this, auras.improved_shadow_bolt);
   }
   if (auras.mana_tide_totem != nullptr) {
-    spells.mana_tide_totem = std::make_shared<ManaTideTotem>(*this, auras.mana_tide_totem);
+    spells.mana_tide_totem = arena.Create<ManaTideTotem>(*this, auras.mana_tide_totem);
   }
   if (auras.chipped_power_core != nullptr) {
-    spells.chipped_power_core = std::make_shared<ChippedPowerCore>(*this, auras.chipped_power_core);
+    spells.chipped_power_core = arena.Create<ChippedPowerCore>(*this, auras.chipped_power_core);
   }
   if (auras.cracked_power_core != nullptr) {
-    spells.cracked_power_core = std::make_shared<CrackedPowerCore>(*this, auras.cracked_power_core);
+    spells.cracked_power_core = arena.Create<CrackedPowerCore>(*this, auras.cracked_power_core);
   }
   if (selected_auras.super_mana_potion) {
-    spells.super_mana_potion = std::make_shared<SuperManaPotion>(*this);
+    spells.super_mana_potion = arena.Create<SuperManaPotion>(*this);
   }
   if (selected_auras.demonic_rune) {
-    spells.demonic_rune = std::make_shared<DemonicRune>(*this);
+    spells.demonic_rune = arena.Create<DemonicRune>(*this);
   }
   if (talents.dark_pact == 1 && (settings.has_dark_pact || settings.rotation_option == EmbindConstant::kSimChooses)) {
-    spells.dark_pact = std::make_shared<DarkPact>(*this);
+    spells.dark_pact = arena.Create<DarkPact>(*this);
   }
   if (auras.destruction_potion != nullptr) {
-    spells.destruction_potion = std::make_shared<DestructionPotion>(*this, auras.destruction_potion);
+    spells.destruction_potion = arena.Create<DestructionPotion>(*this, auras.destruction_potion);
   }
   if (auras.flame_cap != nullptr) {
-    spells.flame_cap = std::make_shared<FlameCap>(*this, auras.flame_cap);
+    spells.flame_cap = arena.Create<FlameCap>(*this, auras.flame_cap);
   }
   if (auras.blood_fury != nullptr) {
-    spells.blood_fury = std::make_shared<BloodFury>(*this, auras.blood_fury);
+    spells.blood_fury = arena.Create<BloodFury>(*this, auras.blood_fury);
   }
   if (auras.drums_of_battle != nullptr) {
-    spells.drums_of_battle = std::make_shared<DrumsOfBattle>(*this, auras.drums_of_battle);
+    spells.drums_of_battle = arena.Create<DrumsOfBattle>(*this, auras.drums_of_battle);
   } else if (auras.drums_of_war != nullptr) {
-    spells.drums_of_war = std::make_shared<DrumsOfWar>(*this, auras.drums_of_war);
+    spells.drums_of_war = arena.Create<DrumsOfWar>(*this, auras.drums_of_war);
   } else if (auras.drums_of_restoration != nullptr) {
-    spells.drums_of_restoration = std::make_shared<DrumsOfRestoration>(*this, auras.drums_of_restoration);
+    spells.drums_of_restoration = arena.Create<DrumsOfRestoration>(*this, auras.drums_of_restoration);
   }
   if (auras.blade_of_wizardry != nullptr) {
-    spells.blade_of_wizardry = std::make_shared<BladeOfWizardry>(*this, auras.blade_of_wizardry);
+    spells.blade_of_wizardry = arena.Create<BladeOfWizardry>(*this, auras.blade_of_wizardry);
   }
   if (auras.shattered_sun_pendant_of_acumen_aldor != nullptr) {
     spells.shattered_sun_pendant_of_acumen_aldor =
-        std::make_shared<ShatteredSunPendantOfAcumenAldor>(*this, auras.shattered_sun_pendant_of_acumen_aldor);
+        arena.Create<ShatteredSunPendantOfAcumenAldor>(*this, auras.shattered_sun_pendant_of_acumen_aldor);
   }
   if (auras.robe_of_the_elder_scribes != nullptr) {
-    spells.robe_of_the_elder_scribes = std::make_shared<RobeOfTheElderScribes>(*this, auras.robe_of_the_elder_scribes);
+    spells.robe_of_the_elder_scribes = arena.Create<RobeOfTheElderScribes>(*this, auras.robe_of_the_elder_scribes);
   }
   if (auras.mystical_skyfire_diamond != nullptr) {
-    spells.mystical_skyfire_diamond = std::make_shared<MysticalSkyfireDiamond>(*this, auras.mystical_skyfire_diamond);
+    spells.mystical_skyfire_diamond = arena.Create<MysticalSkyfireDiamond>(*this, auras.mystical_skyfire_diamond);
   }
   if (settings.meta_gem_id == ItemId::kInsightfulEarthstormDiamond) {
-    spells.insightful_earthstorm_diamond = std::make_shared<InsightfulEarthstormDiamond>(*this);
+    spells.insightful_earthstorm_diamond = arena.Create<InsightfulEarthstormDiamond>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kTimbalsFocusingCrystal) !=
       equipped_trinket_ids.end()) {
-    spells.timbals_focusing_crystal = std::make_shared<TimbalsFocusingCrystal>(*this);
+    spells.timbals_focusing_crystal = arena.Create<TimbalsFocusingCrystal>(*this);
   }
   if (std::find(equipped_trinket_ids.begin(), equipped_trinket_ids.end(), ItemId::kMarkOfDefiance) !=
       equipped_trinket_ids.end()) {
-    spells.mark_of_defiance = std::make_shared<MarkOfDefiance>(*this);
+    spells.mark_of_defiance = arena.Create<MarkOfDefiance>(*this);
   }
   if (auras.the_lightning_capacitor != nullptr) {
-    spells.the_lightning_capacitor = std::make_shared<TheLightningCapacitor>(*this);
+    spells.the_lightning_capacitor = arena.Create<TheLightningCapacitor>(*this);
   }
   if (auras.quagmirrans_eye != nullptr) {
-    spells.quagmirrans_eye = std::make_shared<QuagmirransEye>(*this, auras.quagmirrans_eye);
+    spells.quagmirrans_eye = arena.Create<QuagmirransEye>(*this, auras.quagmirrans_eye);
   }
   if (auras.shiffars_nexus_horn != nullptr) {
-    spells.shiffars_nexus_horn = std::make_shared<ShiffarsNexusHorn>(*this, auras.shiffars_nexus_horn);
+    spells.shiffars_nexus_horn = arena.Create<ShiffarsNexusHorn>(*this, auras.shiffars_nexus_horn);
   }
   if (auras.sextant_of_unstable_currents != nullptr) {
     spells.sextant_of_unstable_currents =
-        std::make_shared<SextantOfUnstableCurrents>(*this, auras.sextant_of_unstable_currents);
+        arena.Create<SextantOfUnstableCurrents>(*this, auras.sextant_of_unstable_currents);
   }
   if (auras.band_of_the_eternal_sage != nullptr) {
-    spells.band_of_the_eternal_sage = std::make_shared<BandOfTheEternalSage>(*this, auras.band_of_the_eternal_sage);
+    spells.band_of_the_eternal_sage = arena.Create<BandOfTheEternalSage>(*this, auras.band_of_the_eternal_sage);
   }
   if (selected_auras.judgement_of_wisdom) {
-    spells.judgement_of_wisdom = std::make_shared<JudgementOfWisdom>(*this);
+    spells.judgement_of_wisdom = arena.Create<JudgementOfWisdom>(*this);
   }
   if (auras.flameshadow != nullptr) {
-    spells.flameshadow = std::make_shared<Flameshadow>(*this, auras.flameshadow);
+    spells.flameshadow = arena.Create<Flameshadow>(*this, auras.flameshadow);
   }
   if (auras.shadowflame != nullptr) {
-    spells.shadowflame = std::make_shared<Shadowflame>(*this, auras.shadowflame);
+    spells.shadowflame = arena.Create<Shadowflame>(*this, auras.shadowflame);
   }
   if (auras.spellstrike != nullptr) {
-    spells.spellstrike = std::make_shared<Spellstrike>(*this, auras.spellstrike);
+    spells.spellstrike = arena.Create<Spellstrike>(*this, auras.spellstrike);
   }
   if (auras.mana_etched_4_set != nullptr) {
-    spells.mana_etched_4_set = std::make_shared<ManaEtched4Set>(*this, auras.mana_etched_4_set);
+    spells.mana_etched_4_set = arena.Create<ManaEtched4Set>(*this, auras.mana_etched_4_set);
   }
   if (auras.ashtongue_talisman_of_shadows != nullptr) {
     spells.ashtongue_talisman_of_shadows =
-        std::make_shared<AshtongueTalismanOfShadows>(*this, auras.ashtongue_talisman_of_shadows);
+        arena.Create<AshtongueTalismanOfShadows>(*this, auras.ashtongue_talisman_of_shadows);
   }
   if (auras.wrath_of_cenarius != nullptr) {
-    spells.wrath_of_cenarius = std::make_shared<WrathOfCenarius>(*this, auras.wrath_of_cenarius);
+    spells.wrath_of_cenarius = arena.Create<WrathOfCenarius>(*this, auras.wrath_of_cenarius);
   }
   if (auras.darkmoon_card_crusade != nullptr) {
-    spells.darkmoon_card_crusade = std::make_shared<DarkmoonCardCrusade>(*this, auras.darkmoon_card_crusade);
+    spells.darkmoon_card_crusade = arena.Create<DarkmoonCardCrusade>(*this, auras.darkmoon_card_crusade);
   }
   if (auras.power_infusion != nullptr) {
     for (int i = 0; i < settings.power_infusion_amount; i++) {
-      spells.power_infusion.push_back(std::make_shared<PowerInfusion>(*this, auras.power_infusion));
+      spells.power_infusion.push_back(arena.Create<PowerInfusion>(*this, auras.power_infusion));
     }
   }
   if (auras.bloodlust != nullptr) {
     for (int i = 0; i < settings.bloodlust_amount; i++) {
-      spells.bloodlust.push_back(std::make_shared<Bloodlust>(*this, auras.bloodlust));
+      spells.bloodlust.push_back(arena.Create<Bloodlust>(*this, auras.bloodlust));
     }
   }
   if (auras.innervate != nullptr) {
     for (int i = 0; i < settings.innervate_amount; i++) {
-      spells.innervate.push_back(std::make_shared<Innervate>(*this, auras.innervate));
+      spells.innervate.push_back(arena.Create<Innervate>(*this, auras.innervate));
     }
   }
 
@@ -531,6 +536,35 @@ void Player::Initialize(Simulation* simulation_ptr) {
     curse_spell = spells.curse_of_agony;
   }
 
+  SetupSharedCooldowns();
+  SetupProcs();
+  simulation->scheduler.AddTimers(*this);
+
+  if (pet != nullptr) {
+    pet->SetupProcs();
+    simulation->scheduler.AddTimers(*pet);
+  }
+
+  SendPlayerInfoToCombatLog();
+}
+
+// Re-derives everything the constructor takes from the settings (e.g. after the settings' stats changed) without
+// rebuilding the spells, auras and procs that were created in Initialize()
+void Player::RefreshStats() {
+  const auto kPlayer = Player(settings);
+  stats = kPlayer.stats;
+  stats_version++;
+  custom_stat = kPlayer.custom_stat;
+  enemy_armor = kPlayer.enemy_armor;
+
+  ResetCombatLogBreakdown();
+
+  if (pet != nullptr) {
+    pet->stats.max_mana = pet->CalculateMaxMana();
+    pet->ResetCombatLogBreakdown();
+  }
+
+  combat_log.Clear();
   SendPlayerInfoToCombatLog();
 }
 
@@ -561,28 +595,52 @@ void Player::EndAuras() {
   }
 }
 
-double Player::GetHastePercent() {
+const DerivedStats& Player::GetDerivedStats() {
+  const int kPetStatsVersion = pet != nullptr ? pet->stats_version : 0;
+
+  if (derived_stats.player_stats_version == stats_version && derived_stats.pet_stats_version == kPetStatsVersion) {
+    return derived_stats;
+  }
+
+  derived_stats.player_stats_version = stats_version;
+  derived_stats.pet_stats_version = kPetStatsVersion;
+  derived_stats.demonic_knowledge_spell_power =
+      pet != nullptr && talents.demonic_knowledge > 0
+          ? (pet->GetStamina() + pet->GetIntellect()) * 0.04 * talents.demonic_knowledge
+          : 0;
+  derived_stats.spellfire_spell_power = sets.spellfire == 3 ? GetIntellect() * 0.07 : 0;
+  derived_stats.spirit_spell_power = selected_auras.prayer_of_spirit && settings.improved_divine_spirit > 0
+                                         ? GetSpirit() * (0 + static_cast<double>(settings.improved_divine_spirit) / 20.0)
+                                         : 0;
+  derived_stats.spell_crit_chance = stats.spell_crit_chance + GetIntellect() * StatConstant::kCritChancePerIntellect +
+                                    stats.spell_crit_rating / StatConstant::kCritRatingPerPercent;
+
   auto haste_percent = stats.spell_haste_percent;
 
   // If both Bloodlust and Power Infusion are active then remove the 20% PI
-  // bonus since they don't stack
+  // bonus since they don't stack. Both of them change the stats when they're applied or fade so this is cached too.
   if (auras.bloodlust != nullptr && auras.power_infusion != nullptr && auras.bloodlust->active &&
       auras.power_infusion->active) {
     for (auto& stat : auras.power_infusion->stats) {
-      if (stat.name == StatName::kSpellHastePercent) {
+      if (stat.field == StatField::kSpellHastePercent) {
         haste_percent /= stat.value;
       }
     }
   }
 
-  return haste_percent * (1 + stats.spell_haste_rating / StatConstant::kHasteRatingPerPercent / 100.0);
+  derived_stats.haste_percent =
+      haste_percent * (1 + stats.spell_haste_rating / StatConstant::kHasteRatingPerPercent / 100.0);
+  return derived_stats;
 }
 
+double Player::GetHastePercent() { return GetDerivedStats().haste_percent; }
+
 double Player::GetSpellPower(const bool kDealingDamage, const SpellSchool kSchool) {
+  const auto& kDerivedStats = GetDerivedStats();
   auto spell_power = stats.spell_power;
 
   if (pet != nullptr && talents.demonic_knowledge > 0) {
-    spell_power += (pet->GetStamina() + pet->GetIntellect()) * 0.04 * talents.demonic_knowledge;
+    spell_power += kDerivedStats.demonic_knowledge_spell_power;
   }
 
   // If Mark of the Champion is equipped and the player isn't dealing damage then remove the spell power so it doesn't
@@ -593,7 +651,7 @@ double Player::GetSpellPower(const bool kDealingDamage, const SpellSchool kSchoo
   }
 
   if (sets.spellfire == 3) {
-    spell_power += GetIntellect() * 0.07;
+    spell_power += kDerivedStats.spellfire_spell_power;
   }
 
   if (kSchool == SpellSchool::kShadow) {
@@ -604,15 +662,14 @@ double Player::GetSpellPower(const bool kDealingDamage, const SpellSchool kSchoo
 
   // Spell Power from spirit if player has Improved Divine Spirit buffed
   if (selected_auras.prayer_of_spirit && settings.improved_divine_spirit > 0) {
-    spell_power += GetSpirit() * (0 + static_cast<double>(settings.improved_divine_spirit) / 20.0);
+    spell_power += kDerivedStats.spirit_spell_power;
   }
 
   return spell_power;
 }
 
 double Player::GetSpellCritChance(const SpellType kSpellType) {
-  auto crit_chance = stats.spell_crit_chance + GetIntellect() * StatConstant::kCritChancePerIntellect +
-                     stats.spell_crit_rating / StatConstant::kCritRatingPerPercent;
+  auto crit_chance = GetDerivedStats().spell_crit_chance;
 
   if (kSpellType != SpellType::kDestruction) {
     crit_chance -= talents.devastation;
@@ -621,9 +678,13 @@ double Player::GetSpellCritChance(const SpellType kSpellType) {
   return crit_chance;
 }
 
-int Player::GetRand() { return rng.Range(0, 100 * kFloatNumberMultiplier); }
+bool Player::RollRng(const double kChance) { return rng.Roll(Rng::ChanceToThreshold(kChance)); }
 
-bool Player::RollRng(const double kChance) { return GetRand() <= kChance * kFloatNumberMultiplier; }
+// The same roll as RollRng() but for the procs that a spell or dot tick can trigger, which are counted when profiling
+bool Player::RollProc(const double kProcChance) {
+  CountProfilingEvent(ProfilingCounter::kProcRolls);
+  return RollRng(kProcChance);
+}
 
 void Player::UseCooldowns(const double kFightTimeRemaining) {
   // Only use PI if Bloodlust isn't selected or if Bloodlust isn't active since they don't stack, or if there are enough
@@ -673,8 +734,9 @@ void Player::UseCooldowns(const double kFightTimeRemaining) {
       // the duration of the trinket just used if the trinkets share cooldown
       if (const auto kOtherTrinketSlot = i == 1 ? 0 : 1; trinkets.size() > kOtherTrinketSlot 
                                                          && trinkets[kOtherTrinketSlot].shares_cooldown && trinkets[i].shares_cooldown) {
-        trinkets[kOtherTrinketSlot].cooldown_remaining =
-            std::max(trinkets[kOtherTrinketSlot].cooldown_remaining, static_cast<double>(trinkets[i].duration));
+        auto& other_trinket = trinkets[kOtherTrinketSlot];
+        other_trinket.cooldown_timer.Start(
+            std::max(other_trinket.cooldown_timer.Remaining(), static_cast<double>(trinkets[i].duration)));
       }
     }
   }
@@ -685,31 +747,31 @@ double Player::GetDamageModifier(Spell& spell, const bool kIsDot) {
   auto additive_modifier = 1.0;
   const auto multiplicative_modifier = GetMultiplicativeDamageModifier(spell, kIsDot);
 
-  if (sets.t6 >= 4 && (spell.name == SpellName::kShadowBolt || spell.name == SpellName::kIncinerate)) {
+  if (sets.t6 >= 4 && (spell.id == SpellId::kShadowBolt || spell.id == SpellId::kIncinerate)) {
     additive_modifier += 0.06;
   }
 
-  if (sets.t3 >= 4 && spell.name == SpellName::kCorruption) {
+  if (sets.t3 >= 4 && spell.id == SpellId::kCorruption) {
     additive_modifier += 0.12;
   }
 
-  if (spell.spell_school == SpellSchool::kShadow && spell.name != SpellName::kCurseOfDoom) {
+  if (spell.spell_school == SpellSchool::kShadow && spell.id != SpellId::kCurseOfDoom) {
     additive_modifier += 0.02 * talents.shadow_mastery;
   }
 
-  if (spell.name == SpellName::kCurseOfAgony) {
+  if (spell.id == SpellId::kCurseOfAgony) {
     additive_modifier += 0.05 * talents.improved_curse_of_agony;
   }
 
-  if (spell.name == SpellName::kCurseOfAgony || spell.name == SpellName::kCorruption ||
-      spell.name == SpellName::kSeedOfCorruption) {
+  if (spell.id == SpellId::kCurseOfAgony || spell.id == SpellId::kCorruption ||
+      spell.id == SpellId::kSeedOfCorruption) {
     additive_modifier += 0.01 * talents.contagion;
   }
 
   if (spell.spell_school == SpellSchool::kFire) {
     additive_modifier += 0.02 * talents.emberstorm;
 
-    if (spell.name == SpellName::kImmolate && !kIsDot) {
+    if (spell.id == SpellId::kImmolate && !kIsDot) {
       additive_modifier += 0.05 * talents.improved_immolate;
     }
   }
@@ -732,134 +794,101 @@ void Player::ThrowError(const std::string& kError) const {
 }
 
 void Player::SendCombatLogEntries() const {
-  for (const auto& kValue : combat_log_entries) {
-    CombatLogUpdate(kValue.c_str());
+  for (const auto& kEntry : combat_log.Format()) {
+    CombatLogUpdate(kEntry.c_str());
   }
 }
 
-double Player::FindTimeUntilNextAction() {
-  auto time = Entity::FindTimeUntilNextAction();
+void Player::Mp5Tick() {
+  if (stats.mp5 > 0 || five_second_rule_timer.Remaining() <= 0 ||
+      auras.innervate != nullptr && auras.innervate->active) {
+    const bool kInnervateIsActive = auras.innervate != nullptr && auras.innervate->active;
+    const double kCurrentPlayerMana = stats.mana;
 
-  if (pet != nullptr) {
-
-    if (const double kTimeUntilNextPetAction = pet->FindTimeUntilNextAction(); kTimeUntilNextPetAction > 0 && kTimeUntilNextPetAction < time) {
-      time = kTimeUntilNextPetAction;
+    // MP5
+    if (stats.mp5 > 0) {
+      stats.mana += stats.mp5;
     }
-  }
+    // Spirit mana regen
+    if (kInnervateIsActive || five_second_rule_timer.Remaining() <= 0) {
+      // Formula from https://wowwiki-archive.fandom.com/wiki/Spirit?oldid=1572910
+      auto mp5_from_spirit = 5 * (0.001 + std::sqrt(GetIntellect()) * GetSpirit() * 0.009327);
 
-  for (const auto& trinket : trinkets) {
-    if (trinket.active && trinket.duration_remaining < time) {
-      time = trinket.duration_remaining;
-    }
-    if (trinket.cooldown_remaining > 0 && trinket.cooldown_remaining < time) {
-      time = trinket.cooldown_remaining;
-    }
-  }
-
-  return time;
-}
-
-void Player::Tick(const double kTime) {
-  Entity::Tick(kTime);
-
-  for (auto& trinket : trinkets) {
-    trinket.Tick(kTime);
-  }
-
-  if (mp5_timer_remaining <= 0) {
-    mp5_timer_remaining = 5;
-
-    if (stats.mp5 > 0 || five_second_rule_timer_remaining <= 0 ||
-        auras.innervate != nullptr && auras.innervate->active) {
-      const bool kInnervateIsActive = auras.innervate != nullptr && auras.innervate->active;
-      const double kCurrentPlayerMana = stats.mana;
-
-      // MP5
-      if (stats.mp5 > 0) {
-        stats.mana += stats.mp5;
+      if (kInnervateIsActive) {
+        mp5_from_spirit *= 4;
       }
-      // Spirit mana regen
-      if (kInnervateIsActive || five_second_rule_timer_remaining <= 0) {
-        // Formula from https://wowwiki-archive.fandom.com/wiki/Spirit?oldid=1572910
-        auto mp5_from_spirit = 5 * (0.001 + std::sqrt(GetIntellect()) * GetSpirit() * 0.009327);
-
-        if (kInnervateIsActive) {
-          mp5_from_spirit *= 4;
-        }
 
-        stats.mana += mp5_from_spirit;
-      }
+      stats.mana += mp5_from_spirit;
+    }
 
-      if (stats.mana > stats.max_mana) {
-        stats.mana = stats.max_mana;
-      }
+    if (stats.mana > stats.max_mana) {
+      stats.mana = stats.max_mana;
+    }
 
-      const double kManaGained = stats.mana - kCurrentPlayerMana;
-      if (recording_combat_log_breakdown) {
-        combat_log_breakdown.at(StatName::kMp5)->casts++;
-        combat_log_breakdown.at(StatName::kMp5)->iteration_mana_gain += kManaGained;
-      }
+    const double kManaGained = stats.mana - kCurrentPlayerMana;
+    if (recording_combat_log_breakdown) {
+      GetCombatLogBreakdown(SpellId::kMp5).casts++;
+      GetCombatLogBreakdown(SpellId::kMp5).iteration_mana_gain += kManaGained;
+    }
 
-      if (ShouldWriteToCombatLog()) {
-        CombatLog("Player gains " + DoubleToString(kManaGained) + " mana from MP5 (" +
-                  DoubleToString(kCurrentPlayerMana) + " -> " + DoubleToString(stats.mana) + ")");
-      }
+    if (ShouldWriteToCombatLog()) {
+      CombatLog({.type = CombatLogEventType::kMp5ManaGain, .values = {kManaGained, kCurrentPlayerMana, stats.mana}});
     }
   }
 }
 
 void Player::SendPlayerInfoToCombatLog() {
-  combat_log_entries.push_back("---------------- Player stats ----------------");
-  combat_log_entries.push_back("Health: " + DoubleToString(round(stats.health)));
-  combat_log_entries.push_back("Mana: " + DoubleToString(round(stats.max_mana)));
-  combat_log_entries.push_back("Stamina: " + DoubleToString(round(GetStamina())));
-  combat_log_entries.push_back("Intellect: " + DoubleToString(round(GetIntellect())));
-  combat_log_entries.push_back("Spell Power: " + DoubleToString(round(GetSpellPower(true))));
-  combat_log_entries.push_back("Shadow Power: " + DoubleToString(stats.shadow_power));
-  combat_log_entries.push_back("Fire Power: " + DoubleToString(stats.fire_power));
-  combat_log_entries.push_back(
+  combat_log.header.push_back("---------------- Player stats ----------------");
+  combat_log.header.push_back("Health: " + DoubleToString(round(stats.health)));
+  combat_log.header.push_back("Mana: " + DoubleToString(round(stats.max_mana)));
+  combat_log.header.push_back("Stamina: " + DoubleToString(round(GetStamina())));
+  combat_log.header.push_back("Intellect: " + DoubleToString(round(GetIntellect())));
+  combat_log.header.push_back("Spell Power: " + DoubleToString(round(GetSpellPower(true))));
+  combat_log.header.push_back("Shadow Power: " + DoubleToString(stats.shadow_power));
+  combat_log.header.push_back("Fire Power: " + DoubleToString(stats.fire_power));
+  combat_log.header.push_back(
       "Crit Chance: " + DoubleToString(round(GetSpellCritChance(SpellType::kDestruction) * 100) / 100, 2) + "%");
-  combat_log_entries.push_back(
+  combat_log.header.push_back(
       "Hit Chance: " + DoubleToString(std::min(16.0, round(stats.extra_spell_hit_chance * 100) / 100), 2) + "%");
-  combat_log_entries.push_back(
+  combat_log.header.push_back(
       "Haste: " +
       DoubleToString(round(stats.spell_haste_rating / StatConstant::kHasteRatingPerPercent * 100) / 100, 2) + "%");
-  combat_log_entries.push_back(
+  combat_log.header.push_back(
       "Shadow Modifier: " + DoubleToString(stats.shadow_modifier * (1 + 0.02 * talents.shadow_mastery) * 100, 2) + "%");
-  combat_log_entries.push_back(
+  combat_log.header.push_back(
       "Fire Modifier: " + DoubleToString(stats.fire_modifier * (1 + 0.02 * talents.emberstorm) * 100, 2) + "%");
-  combat_log_entries.push_back("MP5: " + DoubleToString(stats.mp5));
-  combat_log_entries.push_back("Spell Penetration: " + DoubleToString(stats.spell_penetration));
+  combat_log.header.push_back("MP5: " + DoubleToString(stats.mp5));
+  combat_log.header.push_back("Spell Penetration: " + DoubleToString(stats.spell_penetration));
   if (pet != nullptr) {
-    combat_log_entries.push_back("---------------- Pet stats ----------------");
-    combat_log_entries.push_back("Stamina: " + DoubleToString(pet->GetStamina()));
-    combat_log_entries.push_back("Intellect: " + DoubleToString(pet->GetIntellect()));
-    combat_log_entries.push_back("Strength: " + DoubleToString(pet->GetStrength()));
-    combat_log_entries.push_back("Agility: " + DoubleToString(pet->GetAgility()));
-    combat_log_entries.push_back("Spirit: " + DoubleToString(pet->GetSpirit()));
-    combat_log_entries.push_back("Attack Power: " + DoubleToString(round(pet->GetAttackPower())));
-    combat_log_entries.push_back("Spell Power: " + DoubleToString(pet->GetSpellPower(false, SpellSchool::kNoSchool)));
-    combat_log_entries.push_back("Mana: " + DoubleToString(pet->CalculateMaxMana()));
-    combat_log_entries.push_back("MP5: " + DoubleToString(pet->stats.mp5));
+    combat_log.header.push_back("---------------- Pet stats ----------------");
+    combat_log.header.push_back("Stamina: " + DoubleToString(pet->GetStamina()));
+    combat_log.header.push_back("Intellect: " + DoubleToString(pet->GetIntellect()));
+    combat_log.header.push_back("Strength: " + DoubleToString(pet->GetStrength()));
+    combat_log.header.push_back("Agility: " + DoubleToString(pet->GetAgility()));
+    combat_log.header.push_back("Spirit: " + DoubleToString(pet->GetSpirit()));
+    combat_log.header.push_back("Attack Power: " + DoubleToString(round(pet->GetAttackPower())));
+    combat_log.header.push_back("Spell Power: " + DoubleToString(pet->GetSpellPower(false, SpellSchool::kNoSchool)));
+    combat_log.header.push_back("Mana: " + DoubleToString(pet->CalculateMaxMana()));
+    combat_log.header.push_back("MP5: " + DoubleToString(pet->stats.mp5));
     if (pet->pet_type == PetType::kMelee) {
-      combat_log_entries.push_back(
+      combat_log.header.push_back(
           "Physical Hit Chance: " + DoubleToString(round(pet->stats.melee_hit_chance * 100) / 100.0, 2) + "%");
-      combat_log_entries.push_back(
+      combat_log.header.push_back(
           "Physical Crit Chance: " + DoubleToString(round(pet->GetMeleeCritChance() * 100) / 100.0, 2) + "% (" +
           DoubleToString(StatConstant::kMeleeCritChanceSuppression, 2) + "% Crit Suppression Applied)");
-      combat_log_entries.push_back("Glancing Blow Chance: " + DoubleToString(pet->glancing_blow_chance, 2) + "%");
-      combat_log_entries.push_back(
+      combat_log.header.push_back("Glancing Blow Chance: " + DoubleToString(pet->glancing_blow_chance, 2) + "%");
+      combat_log.header.push_back(
           "Attack Power Modifier: " + DoubleToString(pet->stats.attack_power_modifier * 100, 2) + "%");
     }
     if (pet->pet_name == PetName::kImp || pet->pet_name == PetName::kSuccubus) {
-      combat_log_entries.push_back(
+      combat_log.header.push_back(
           "Spell Hit Chance: " +
           DoubleToString(round(pet->GetSpellHitChance(SpellType::kNoSpellType) * 100) / 100.0, 2) + "%");
-      combat_log_entries.push_back(
+      combat_log.header.push_back(
           "Spell Crit Chance: " +
           DoubleToString(round(pet->GetSpellCritChance(SpellType::kNoSpellType) * 100) / 100.0, 2) + "%");
     }
-    combat_log_entries.push_back(
+    combat_log.header.push_back(
         "Damage Modifier: " +
         DoubleToString(round(pet->GetDamageModifier(
                                  *(pet->pet_name == PetName::kImp ? pet->spells.firebolt : pet->spells.melee), false) *
@@ -868,18 +897,18 @@ void Player::SendPlayerInfoToCombatLog() {
                        2) +
         "%");
   }
-  combat_log_entries.push_back("---------------- Enemy stats ----------------");
-  combat_log_entries.push_back("Level: " + std::to_string(settings.enemy_level));
-  combat_log_entries.push_back("Shadow Resistance: " + std::to_string(std::max(settings.enemy_shadow_resist,
-                                                                               enemy_level_difference_resistance)));
-  combat_log_entries.push_back("Fire Resistance: " +
-                               std::to_string(std::max(settings.enemy_fire_resist, enemy_level_difference_resistance)));
+  combat_log.header.push_back("---------------- Enemy stats ----------------");
+  combat_log.header.push_back("Level: " + std::to_string(settings.enemy_level));
+  combat_log.header.push_back("Shadow Resistance: " + std::to_string(std::max(settings.enemy_shadow_resist,
+                                                                              enemy_level_difference_resistance)));
+  combat_log.header.push_back("Fire Resistance: " +
+                              std::to_string(std::max(settings.enemy_fire_resist, enemy_level_difference_resistance)));
   if (pet != nullptr && pet->pet_name != PetName::kImp) {
-    combat_log_entries.push_back("Dodge Chance: " + DoubleToString(StatConstant::kBaseEnemyDodgeChance, 2) + "%");
-    combat_log_entries.push_back("Armor: " + std::to_string(settings.enemy_armor));
-    combat_log_entries.push_back(
+    combat_log.header.push_back("Dodge Chance: " + DoubleToString(StatConstant::kBaseEnemyDodgeChance, 2) + "%");
+    combat_log.header.push_back("Armor: " + std::to_string(enemy_armor));
+    combat_log.header.push_back(
         "Damage Reduction From Armor: " +
         DoubleToString(round((1 - pet->enemy_damage_reduction_from_armor) * 10000) / 100.0, 2) + "%");
   }
-  combat_log_entries.push_back("---------------------------------------------");
+  combat_log.header.push_back("---------------------------------------------");
 }
\ No newline at end of file
@@ -0,0 +1,542 @@
+#include "../include/profile.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <variant>
+
+#include "../include/enums.h"
+#include "../include/simulation_batch.h"
+
+namespace {
+template <typename T>
+using ProfileField =
+    std::variant<int T::*, bool T::*, double T::*, EmbindConstant T::*, SimulationType T::*, RngEngine T::*>;
+
+const std::map<std::string, ProfileField<Items>> kItemFields = {
+    {"head", &Items::head},
+    {"neck", &Items::neck},
+    {"shoulders", &Items::shoulders},
+    {"back", &Items::back},
+    {"chest", &Items::chest},
+    {"bracer", &Items::bracers},
+    {"gloves", &Items::gloves},
+    {"belt", &Items::belt},
+    {"legs", &Items::legs},
+    {"boots", &Items::boots},
+    {"ring1", &Items::ring_1},
+    {"ring2", &Items::ring_2},
+    {"trinket1", &Items::trinket_1},
+    {"trinket2", &Items::trinket_2},
+    {"mainhand", &Items::main_hand},
+    {"offhand", &Items::off_hand},
+    {"twohand", &Items::two_hand},
+    {"wand", &Items::wand}
+};
+
+const std::map<std::string, ProfileField<AuraSelection>> kAuraFields = {
+    {"felArmor", &AuraSelection::fel_armor},
+    {"judgementOfWisdom", &AuraSelection::judgement_of_wisdom},
+    {"manaSpringTotem", &AuraSelection::mana_spring_totem},
+    {"wrathOfAirTotem", &AuraSelection::wrath_of_air_totem},
+    {"totemOfWrath", &AuraSelection::totem_of_wrath},
+    {"markOfTheWild", &AuraSelection::mark_of_the_wild},
+    {"prayerOfSpirit", &AuraSelection::prayer_of_spirit},
+    {"bloodPact", &AuraSelection::blood_pact},
+    {"inspiringPresence", &AuraSelection::inspiring_presence},
+    {"moonkinAura", &AuraSelection::moonkin_aura},
+    {"powerInfusion", &AuraSelection::power_infusion},
+    {"powerOfTheGuardianWarlock", &AuraSelection::atiesh_warlock},
+    {"powerOfTheGuardianMage", &AuraSelection::atiesh_mage},
+    {"eyeOfTheNight", &AuraSelection::eye_of_the_night},
+    {"chainOfTheTwilightOwl", &AuraSelection::chain_of_the_twilight_owl},
+    {"jadePendantOfBlasting", &AuraSelection::jade_pendant_of_blasting},
+    {"drumsOfBattle", &AuraSelection::drums_of_battle},
+    {"drumsOfWar", &AuraSelection::drums_of_war},
+    {"drumsOfRestoration", &AuraSelection::drums_of_restoration},
+    {"bloodlust", &AuraSelection::bloodlust},
+    {"ferociousInspiration", &AuraSelection::ferocious_inspiration},
+    {"innervate", &AuraSelection::innervate},
+    {"manaTideTotem", &AuraSelection::mana_tide_totem},
+    {"airmansRibbonOfGallantry", &AuraSelection::airmans_ribbon_of_gallantry},
+    {"curseOfTheElements", &AuraSelection::curse_of_the_elements},
+    {"shadowWeaving", &AuraSelection::shadow_weaving},
+    {"improvedScorch", &AuraSelection::improved_scorch},
+    {"misery", &AuraSelection::misery},
+    {"judgementOfTheCrusader", &AuraSelection::judgement_of_the_crusader},
+    {"vampiricTouch", &AuraSelection::vampiric_touch},
+    {"faerieFire", &AuraSelection::faerie_fire},
+    {"sunderArmor", &AuraSelection::sunder_armor},
+    {"exposeArmor", &AuraSelection::expose_armor},
+    {"curseOfRecklessness", &AuraSelection::curse_of_recklessness},
+    {"bloodFrenzy", &AuraSelection::blood_frenzy},
+    {"exposeWeakness", &AuraSelection::expose_weakness},
+    {"annihilator", &AuraSelection::annihilator},
+    {"improvedHuntersMark", &AuraSelection::improved_hunters_mark},
+    {"superManaPotion", &AuraSelection::super_mana_potion},
+    {"destructionPotion", &AuraSelection::destruction_potion},
+    {"demonicRune", &AuraSelection::demonic_rune},
+    {"flameCap", &AuraSelection::flame_cap},
+    {"chippedPowerCore", &AuraSelection::chipped_power_core},
+    {"crackedPowerCore", &AuraSelection::cracked_power_core},
+    {"petBlessingOfKings", &AuraSelection::pet_blessing_of_kings},
+    {"petBlessingOfWisdom", &AuraSelection::pet_blessing_of_wisdom},
+    {"petBlessingOfMight", &AuraSelection::pet_blessing_of_might},
+    {"petBattleSquawk", &AuraSelection::pet_battle_squawk},
+    {"petArcaneIntellect", &AuraSelection::pet_arcane_intellect},
+    {"petMarkOfTheWild", &AuraSelection::pet_mark_of_the_wild},
+    {"petPrayerOfFortitude", &AuraSelection::pet_prayer_of_fortitude},
+    {"petPrayerOfSpirit", &AuraSelection::pet_prayer_of_spirit},
+    {"petKiblersBits", &AuraSelection::pet_kiblers_bits},
+    {"petHeroicPresence", &AuraSelection::pet_heroic_presence},
+    {"petStrengthOfEarthTotem", &AuraSelection::pet_strength_of_earth_totem},
+    {"petGraceOfAirTotem", &AuraSelection::pet_grace_of_air_totem},
+    {"petBattleShout", &AuraSelection::pet_battle_shout},
+    {"petTrueshotAura", &AuraSelection::pet_trueshot_aura},
+    {"petLeaderOfThePack", &AuraSelection::pet_leader_of_the_pack},
+    {"petUnleashedRage", &AuraSelection::pet_unleashed_rage},
+    {"petStaminaScroll", &AuraSelection::pet_stamina_scroll},
+    {"petIntellectScroll", &AuraSelection::pet_intellect_scroll},
+    {"petStrengthScroll", &AuraSelection::pet_strength_scroll},
+    {"petAgilityScroll", &AuraSelection::pet_agility_scroll},
+    {"petSpiritScroll", &AuraSelection::pet_spirit_scroll}
+};
+
+const std::map<std::string, ProfileField<CharacterStats>> kStatFields = {
+    {"health", &CharacterStats::health},
+    {"mana", &CharacterStats::mana},
+    {"stamina", &CharacterStats::stamina},
+    {"intellect", &CharacterStats::intellect},
+    {"spirit", &CharacterStats::spirit},
+    {"spellPower", &CharacterStats::spell_power},
+    {"shadowPower", &CharacterStats::shadow_power},
+    {"firePower", &CharacterStats::fire_power},
+    {"hasteRating", &CharacterStats::spell_haste_rating},
+    {"hastePercent", &CharacterStats::spell_haste_percent},
+    {"hitRating", &CharacterStats::spell_hit_rating},
+    {"critRating", &CharacterStats::spell_crit_rating},
+    {"critChance", &CharacterStats::spell_crit_chance},
+    {"mp5", &CharacterStats::mp5},
+    {"manaCostModifier", &CharacterStats::mana_cost_modifier},
+    {"spellPenetration", &CharacterStats::spell_penetration},
+    {"fireModifier", &CharacterStats::fire_modifier},
+    {"shadowModifier", &CharacterStats::shadow_modifier},
+    {"staminaModifier", &CharacterStats::stamina_modifier},
+    {"intellectModifier", &CharacterStats::intellect_modifier},
+    {"spiritModifier", &CharacterStats::spirit_modifier}
+};
+
+const std::map<std::string, ProfileField<Talents>> kTalentFields = {
+    {"suppression", &Talents::suppression},
+    {"improvedCorruption", &Talents::improved_corruption},
+    {"improvedLifeTap", &Talents::improved_life_tap},
+    {"improvedCurseOfAgony", &Talents::improved_curse_of_agony},
+    {"amplifyCurse", &Talents::amplify_curse},
+    {"nightfall", &Talents::nightfall},
+    {"empoweredCorruption", &Talents::empowered_corruption},
+    {"siphonLife", &Talents::siphon_life},
+    {"shadowMastery", &Talents::shadow_mastery},
+    {"contagion", &Talents::contagion},
+    {"darkPact", &Talents::dark_pact},
+    {"unstableAffliction", &Talents::unstable_affliction},
+    {"improvedImp", &Talents::improved_imp},
+    {"demonicEmbrace", &Talents::demonic_embrace},
+    {"felIntellect", &Talents::fel_intellect},
+    {"felStamina", &Talents::fel_stamina},
+    {"improvedSuccubus", &Talents::improved_succubus},
+    {"demonicAegis", &Talents::demonic_aegis},
+    {"unholyPower", &Talents::unholy_power},
+    {"demonicSacrifice", &Talents::demonic_sacrifice},
+    {"manaFeed", &Talents::mana_feed},
+    {"masterDemonologist", &Talents::master_demonologist},
+    {"soulLink", &Talents::soul_link},
+    {"demonicKnowledge", &Talents::demonic_knowledge},
+    {"demonicTactics", &Talents::demonic_tactics},
+    {"felguard", &Talents::felguard},
+    {"improvedShadowBolt", &Talents::improved_shadow_bolt},
+    {"cataclysm", &Talents::cataclysm},
+    {"bane", &Talents::bane},
+    {"improvedFirebolt", &Talents::improved_firebolt},
+    {"improvedLashOfPain", &Talents::improved_lash_of_pain},
+    {"devastation", &Talents::devastation},
+    {"shadowburn", &Talents::shadowburn},
+    {"improvedSearingPain", &Talents::improved_searing_pain},
+    {"improvedImmolate", &Talents::improved_immolate},
+    {"ruin", &Talents::ruin},
+    {"emberstorm", &Talents::emberstorm},
+    {"backlash", &Talents::backlash},
+    {"conflagrate", &Talents::conflagrate},
+    {"shadowAndFlame", &Talents::shadow_and_flame},
+    {"shadowfury", &Talents::shadowfury}
+};
+
+const std::map<std::string, ProfileField<Sets>> kSetFields = {
+    {"plagueheart", &Sets::t3},
+    {"spellfire", &Sets::spellfire},
+    {"spellstrike", &Sets::spellstrike},
+    {"oblivion", &Sets::oblivion},
+    {"manaEtched", &Sets::mana_etched},
+    {"twinStars", &Sets::twin_stars},
+    {"t4", &Sets::t4},
+    {"t5", &Sets::t5},
+    {"t6", &Sets::t6}
+};
+
+const std::map<std::string, ProfileField<PlayerSettings>> kPlayerSettingFields = {
+    {"itemId", &PlayerSettings::item_id},
+    {"metaGemId", &PlayerSettings::meta_gem_id},
+    {"equippedItemSimulation", &PlayerSettings::equipped_item_simulation},
+    {"recordingCombatLogBreakdown", &PlayerSettings::recording_combat_log_breakdown},
+    {"customStat", &PlayerSettings::custom_stat},
+    {"shattrathFaction", &PlayerSettings::shattrath_faction},
+    {"enemyLevel", &PlayerSettings::enemy_level},
+    {"enemyShadowResist", &PlayerSettings::enemy_shadow_resist},
+    {"enemyFireResist", &PlayerSettings::enemy_fire_resist},
+    {"mageAtieshAmount", &PlayerSettings::mage_atiesh_amount},
+    {"totemOfWrathAmount", &PlayerSettings::totem_of_wrath_amount},
+    {"chippedPowerCoreAmount", &PlayerSettings::chipped_power_core_amount},
+    {"crackedPowerCoreAmount", &PlayerSettings::cracked_power_core_amount},
+    {"sacrificingPet", &PlayerSettings::sacrificing_pet},
+    {"selectedPet", &PlayerSettings::selected_pet},
+    {"ferociousInspirationAmount", &PlayerSettings::ferocious_inspiration_amount},
+    {"improvedCurseOfTheElements", &PlayerSettings::improved_curse_of_the_elements},
+    {"usingCustomIsbUptime", &PlayerSettings::using_custom_isb_uptime},
+    {"customIsbUptimeValue", &PlayerSettings::custom_isb_uptime_value},
+    {"improvedDivineSpirit", &PlayerSettings::improved_divine_spirit},
+    {"improvedImp", &PlayerSettings::improved_imp},
+    {"shadowPriestDps", &PlayerSettings::shadow_priest_dps},
+    {"warlockAtieshAmount", &PlayerSettings::warlock_atiesh_amount},
+    {"improvedExposeArmor", &PlayerSettings::improved_expose_armor},
+    {"battleSquawkAmount", &PlayerSettings::battle_squawk_amount},
+    {"fightType", &PlayerSettings::fight_type},
+    {"enemyAmount", &PlayerSettings::enemy_amount},
+    {"race", &PlayerSettings::race},
+    {"powerInfusionAmount", &PlayerSettings::power_infusion_amount},
+    {"bloodlustAmount", &PlayerSettings::bloodlust_amount},
+    {"innervateAmount", &PlayerSettings::innervate_amount},
+    {"enemyArmor", &PlayerSettings::enemy_armor},
+    {"exposeWeaknessUptime", &PlayerSettings::expose_weakness_uptime},
+    {"improvedFaerieFire", &PlayerSettings::improved_faerie_fire},
+    {"infinitePlayerMana", &PlayerSettings::infinite_player_mana},
+    {"infinitePetMana", &PlayerSettings::infinite_pet_mana},
+    {"lashOfPainUsage", &PlayerSettings::lash_of_pain_usage},
+    {"petMode", &PlayerSettings::pet_mode},
+    {"prepopBlackBook", &PlayerSettings::prepop_black_book},
+    {"randomizeValues", &PlayerSettings::randomize_values},
+    {"rotationOption", &PlayerSettings::rotation_option},
+    {"exaltedWithShattrathFaction", &PlayerSettings::exalted_with_shattrath_faction},
+    {"survivalHunterAgility", &PlayerSettings::survival_hunter_agility},
+    {"hasImmolate", &PlayerSettings::has_immolate},
+    {"hasCorruption", &PlayerSettings::has_corruption},
+    {"hasSiphonLife", &PlayerSettings::has_siphon_life},
+    {"hasUnstableAffliction", &PlayerSettings::has_unstable_affliction},
+    {"hasSearingPain", &PlayerSettings::has_searing_pain},
+    {"hasShadowBolt", &PlayerSettings::has_shadow_bolt},
+    {"hasIncinerate", &PlayerSettings::has_incinerate},
+    {"hasCurseOfRecklessness", &PlayerSettings::has_curse_of_recklessness},
+    {"hasCurseOfTheElements", &PlayerSettings::has_curse_of_the_elements},
+    {"hasCurseOfAgony", &PlayerSettings::has_curse_of_agony},
+    {"hasCurseOfDoom", &PlayerSettings::has_curse_of_doom},
+    {"hasDeathCoil", &PlayerSettings::has_death_coil},
+    {"hasShadowburn", &PlayerSettings::has_shadow_burn},
+    {"hasConflagrate", &PlayerSettings::has_conflagrate},
+    {"hasShadowfury", &PlayerSettings::has_shadowfury},
+    {"hasAmplifyCurse", &PlayerSettings::has_amplify_curse},
+    {"hasDarkPact", &PlayerSettings::has_dark_pact},
+    {"hasElementalShamanT4Bonus", &PlayerSettings::has_elemental_shaman_t4_bonus}
+};
+
+const std::map<std::string, ProfileField<SimulationSettings>> kSimulationSettingFields = {
+    {"iterations", &SimulationSettings::iterations},
+    {"minTime", &SimulationSettings::min_time},
+    {"maxTime", &SimulationSettings::max_time},
+    {"simulationType", &SimulationSettings::simulation_type},
+    {"threads", &SimulationSettings::threads},
+    {"rngEngine", &SimulationSettings::rng_engine},
+    {"targetStandardError", &SimulationSettings::target_standard_error},
+    {"combatLogFirstIteration", &SimulationSettings::combat_log_first_iteration},
+    {"combatLogIterations", &SimulationSettings::combat_log_iterations},
+    {"combatLogIterationInterval", &SimulationSettings::combat_log_iteration_interval},
+    {"chromeTrace", &SimulationSettings::chrome_trace}
+};
+
+const std::map<std::string, EmbindConstant> kEmbindConstants = {
+    {"aldor", EmbindConstant::kAldor},
+    {"scryers", EmbindConstant::kScryers},
+    {"onCooldown", EmbindConstant::kOnCooldown},
+    {"singleTarget", EmbindConstant::kSingleTarget},
+    {"aoe", EmbindConstant::kAoe},
+    {"noIsb", EmbindConstant::kNoIsb},
+    {"human", EmbindConstant::kHuman},
+    {"gnome", EmbindConstant::kGnome},
+    {"orc", EmbindConstant::kOrc},
+    {"undead", EmbindConstant::kUndead},
+    {"bloodElf", EmbindConstant::kBloodElf},
+    {"simChooses", EmbindConstant::kSimChooses},
+    {"userChooses", EmbindConstant::kUserChooses},
+    {"stamina", EmbindConstant::kStamina},
+    {"intellect", EmbindConstant::kIntellect},
+    {"spirit", EmbindConstant::kSpirit},
+    {"spellPower", EmbindConstant::kSpellPower},
+    {"shadowPower", EmbindConstant::kShadowPower},
+    {"firePower", EmbindConstant::kFirePower},
+    {"hitRating", EmbindConstant::kHitRating},
+    {"critRating", EmbindConstant::kCritRating},
+    {"hasteRating", EmbindConstant::kHasteRating},
+    {"mp5", EmbindConstant::kMp5},
+    {"normal", EmbindConstant::kNormal},
+    {"imp", EmbindConstant::kImp},
+    {"succubus", EmbindConstant::kSuccubus},
+    {"felhunter", EmbindConstant::kFelhunter},
+    {"felguard", EmbindConstant::kFelguard},
+    {"passive", EmbindConstant::kPassive},
+    {"aggressive", EmbindConstant::kAggressive}
+};
+
+const std::map<std::string, SimulationType> kSimulationTypes = {
+    {"normal", SimulationType::kNormal},
+    {"allItems", SimulationType::kAllItems},
+    {"statWeights", SimulationType::kStatWeights}
+};
+
+const std::map<std::string, RngEngine> kRngEngines = {
+    {"xoshiro256PlusPlus", RngEngine::kXoshiro256PlusPlus},
+    {"mersenneTwister", RngEngine::kMersenneTwister},
+    {"pcg32", RngEngine::kPcg32},
+    {"philox", RngEngine::kPhilox}
+};
+
+const std::string kVariantSectionPrefix = "variant ";
+const std::set<std::string> kSections = {"items", "auras", "talents", "sets", "stats", "player", "simulation"};
+
+std::string Trim(const std::string& kString) {
+  const auto kFirst = kString.find_first_not_of(" \t\r");
+
+  if (kFirst == std::string::npos) {
+    return "";
+  }
+
+  return kString.substr(kFirst, kString.find_last_not_of(" \t\r") - kFirst + 1);
+}
+
+template <typename T>
+T ParseEnum(const std::map<std::string, T>& kValues, const std::string& kValue) {
+  if (!kValues.contains(kValue)) {
+    throw std::invalid_argument("unknown value '" + kValue + "'");
+  }
+
+  return kValues.at(kValue);
+}
+
+bool ParseBool(const std::string& kValue) {
+  if (kValue == "true" || kValue == "1") {
+    return true;
+  }
+
+  if (kValue == "false" || kValue == "0") {
+    return false;
+  }
+
+  throw std::invalid_argument("expected true or false but got '" + kValue + "'");
+}
+
+double ParseNumber(const std::string& kValue) {
+  size_t parsed_characters = 0;
+  double number = 0;
+
+  try {
+    number = std::stod(kValue, &parsed_characters);
+  } catch (const std::logic_error&) {
+  }
+
+  if (parsed_characters == 0 || parsed_characters != kValue.size()) {
+    throw std::invalid_argument("expected a number but got '" + kValue + "'");
+  }
+
+  return number;
+}
+
+// Accepts anything ParseNumber() does as long as it's a whole number that fits in a T, e.g. "150" or "1e3"
+template <typename T>
+T ParseInteger(const std::string& kValue) {
+  const double kNumber = ParseNumber(kValue);
+
+  if (kNumber != std::trunc(kNumber) || kNumber < std::numeric_limits<T>::min() ||
+      kNumber > std::numeric_limits<T>::max()) {
+    throw std::invalid_argument("expected a whole number between " + std::to_string(std::numeric_limits<T>::min()) +
+                                " and " + std::to_string(std::numeric_limits<T>::max()) + " but got '" + kValue +
+                                "'");
+  }
+
+  return static_cast<T>(kNumber);
+}
+
+template <typename T>
+void SetField(const std::map<std::string, ProfileField<T>>& kFields, T& target, const std::string& kKey,
+              const std::string& kValue) {
+  if (!kFields.contains(kKey)) {
+    throw std::invalid_argument("unknown key '" + kKey + "'");
+  }
+
+  std::visit(
+      [&]<typename TField>(TField T::* field) {
+        if constexpr (std::is_same_v<TField, bool>) {
+          target.*field = ParseBool(kValue);
+        } else if constexpr (std::is_same_v<TField, int>) {
+          target.*field = ParseInteger<int>(kValue);
+        } else if constexpr (std::is_same_v<TField, double>) {
+          target.*field = ParseNumber(kValue);
+        } else if constexpr (std::is_same_v<TField, EmbindConstant>) {
+          target.*field = ParseEnum(kEmbindConstants, kValue);
+        } else if constexpr (std::is_same_v<TField, SimulationType>) {
+          target.*field = ParseEnum(kSimulationTypes, kValue);
+        } else {
+          target.*field = ParseEnum(kRngEngines, kValue);
+        }
+      },
+      kFields.at(kKey));
+}
+
+// Variant keys are prefixed with the section of the base value they replace, e.g. "items.trinket1"
+void SetVariantField(SimulationVariant& variant, const std::string& kKey, const std::string& kValue) {
+  const auto kDot = kKey.find('.');
+  const auto kSection = kKey.substr(0, kDot);
+  const auto kField = kDot == std::string::npos ? "" : kKey.substr(kDot + 1);
+
+  if (kSection == "items") {
+    SetField(kItemFields, variant.items, kField, kValue);
+  } else if (kSection == "talents") {
+    SetField(kTalentFields, variant.talents, kField, kValue);
+  } else if (kSection == "stats") {
+    SetField(kStatFields, variant.stats, kField, kValue);
+  } else if (kKey == "player.customStat") {
+    variant.custom_stat = ParseEnum(kEmbindConstants, kValue);
+  } else if (kKey == "player.itemId") {
+    variant.item_id = ParseInteger<int>(kValue);
+  } else {
+    throw std::invalid_argument("variants can't change '" + kKey + "'");
+  }
+}
+}
+
+Profile::Profile()
+  : player_settings(auras, talents, sets, CharacterStats(), items) {
+  simulation_settings.iterations = 1000;
+  simulation_settings.min_time = 150;
+  simulation_settings.max_time = 210;
+  simulation_settings.simulation_type = SimulationType::kNormal;
+  simulation_settings.rng_engine = RngEngine::kXoshiro256PlusPlus;
+  // Taken from the current time if the profile doesn't set it
+  simulation_settings.seed = static_cast<uint32_t>(std::chrono::system_clock::now().time_since_epoch().count());
+  simulation_settings.target_standard_error = 0;
+  player_settings.custom_stat = EmbindConstant::kNormal;
+  player_settings.fight_type = EmbindConstant::kSingleTarget;
+  player_settings.rotation_option = EmbindConstant::kSimChooses;
+}
+
+void Profile::Read(std::istream& stream) {
+  // A variant's overrides are applied once the whole profile has been read so that they're relative to the final base
+  // values no matter where the variant's section is in the file
+  struct VariantOverride {
+    int line_number;
+    std::string key;
+    std::string value;
+  };
+  std::vector<std::pair<std::string, std::vector<VariantOverride>>> variant_overrides;
+  std::string line;
+  std::string section;
+
+  for (int line_number = 1; std::getline(stream, line); line_number++) {
+    line = Trim(line);
+
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    try {
+      if (line.front() == '[') {
+        if (line.back() != ']') {
+          throw std::invalid_argument("unterminated section name");
+        }
+
+        section = Trim(line.substr(1, line.size() - 2));
+
+        if (section.starts_with(kVariantSectionPrefix)) {
+          variant_overrides.push_back({Trim(section.substr(kVariantSectionPrefix.size())), {}});
+        } else if (!kSections.contains(section)) {
+          throw std::invalid_argument("unknown section '" + section + "'");
+        }
+
+        continue;
+      }
+
+      const auto kSeparator = line.find('=');
+
+      if (kSeparator == std::string::npos) {
+        throw std::invalid_argument("expected 'key = value'");
+      }
+
+      const auto kKey = Trim(line.substr(0, kSeparator));
+      const auto kValue = Trim(line.substr(kSeparator + 1));
+
+      if (section.starts_with(kVariantSectionPrefix)) {
+        variant_overrides.back().second.push_back({line_number, kKey, kValue});
+      } else {
+        Set(section, kKey, kValue);
+      }
+    } catch (const std::logic_error& kError) {
+      throw std::invalid_argument("line " + std::to_string(line_number) + ": " + kError.what());
+    }
+  }
+
+  for (const auto& [kName, kOverrides] : variant_overrides) {
+    auto variant = GetBaseVariant();
+    variant.name = kName;
+
+    for (const auto& kOverride : kOverrides) {
+      try {
+        SetVariantField(variant, kOverride.key, kOverride.value);
+      } catch (const std::logic_error& kError) {
+        throw std::invalid_argument("line " + std::to_string(kOverride.line_number) + ": " + kError.what());
+      }
+    }
+
+    variants.push_back(variant);
+  }
+}
+
+void Profile::Set(const std::string& kSection, const std::string& kKey, const std::string& kValue) {
+  if (kSection == "items") {
+    SetField(kItemFields, items, kKey, kValue);
+  } else if (kSection == "auras") {
+    SetField(kAuraFields, auras, kKey, kValue);
+  } else if (kSection == "talents") {
+    SetField(kTalentFields, talents, kKey, kValue);
+  } else if (kSection == "sets") {
+    SetField(kSetFields, sets, kKey, kValue);
+  } else if (kSection == "stats") {
+    SetField(kStatFields, player_settings.stats, kKey, kValue);
+  } else if (kSection == "player") {
+    SetField(kPlayerSettingFields, player_settings, kKey, kValue);
+  } else if (kSection == "simulation" && kKey == "seed") {
+    simulation_settings.seed = ParseInteger<uint32_t>(kValue);
+  } else if (kSection == "simulation") {
+    SetField(kSimulationSettingFields, simulation_settings, kKey, kValue);
+  } else {
+    throw std::invalid_argument("unknown section '" + kSection + "'");
+  }
+}
+
+SimulationVariant Profile::GetBaseVariant() const {
+  auto variant = SimulationVariant();
+  variant.name = "base";
+  variant.items = items;
+  variant.talents = talents;
+  variant.stats = player_settings.stats;
+  variant.custom_stat = player_settings.custom_stat;
+  variant.item_id = player_settings.item_id;
+  return variant;
+}
@@ -0,0 +1,29 @@
+#include "../include/profiling.h"
+
+#include <algorithm>
+
+#include "../include/common.h"
+
+std::string FormatProfilingCounters(const ProfilingCounters& kCounters, const int kIterations) {
+  const double kIterationDivisor = std::max(1, kIterations);
+  std::string json = "{\"iterations\":" + std::to_string(kIterations) + ",\"phases\":{";
+
+  for (size_t i = 0; i < kProfilingPhaseNames.size(); i++) {
+    const double kCalls = static_cast<double>(std::max<uint64_t>(1, kCounters.phase_calls[i]));
+    json += (i == 0 ? "\"" : ",\"") + std::string(kProfilingPhaseNames[i]) +
+        "\":{\"calls\":" + std::to_string(kCounters.phase_calls[i]) +
+        ",\"milliseconds\":" + DoubleToString(kCounters.phase_nanoseconds[i] / 1e6, 3) +
+        ",\"nanosecondsPerCall\":" + DoubleToString(kCounters.phase_nanoseconds[i] / kCalls, 1) +
+        ",\"callsPerIteration\":" + DoubleToString(kCounters.phase_calls[i] / kIterationDivisor, 1) + "}";
+  }
+
+  json += "},\"counters\":{";
+
+  for (size_t i = 0; i < kProfilingCounterNames.size(); i++) {
+    json += (i == 0 ? "\"" : ",\"") + std::string(kProfilingCounterNames[i]) +
+        "\":{\"total\":" + std::to_string(kCounters.counts[i]) +
+        ",\"perIteration\":" + DoubleToString(kCounters.counts[i] / kIterationDivisor, 1) + "}";
+  }
+
+  return json + "}}";
+}
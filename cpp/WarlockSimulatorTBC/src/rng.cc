@@ -1,9 +1,142 @@
 #include "../include/rng.h"
 
-#include <cmath>
+#include <algorithm>
 
-void Rng::Seed(const uint32_t kSeed) { _random_engine.seed(kSeed); }
+namespace {
+// Used to spread the seed over the larger states of the engines and to derive the iterations' seeds
+uint64_t SplitMix64(uint64_t& state) {
+  uint64_t z = state += 0x9E3779B97F4A7C15;
+  z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9;
+  z = (z ^ z >> 27) * 0x94D049BB133111EB;
+  return z ^ z >> 31;
+}
 
-double Rng::Next() { return _random(_random_engine); }
+uint64_t RotateLeft(const uint64_t kValue, const int kAmount) { return kValue << kAmount | kValue >> (64 - kAmount); }
 
-int Rng::Range(const int kMin, const int kMax) { return static_cast<int>(floor(Next() * (kMax - kMin + 1) + kMin)); }
\ No newline at end of file
+uint32_t RotateRight(const uint32_t kValue, const uint32_t kAmount) {
+  return kValue >> kAmount | kValue << (-kAmount & 31);
+}
+
+// xoshiro256++ by David Blackman and Sebastiano Vigna
+uint64_t Xoshiro256PlusPlus(std::array<uint64_t, 4>& s) {
+  const uint64_t kResult = RotateLeft(s[0] + s[3], 23) + s[0];
+  const uint64_t kT = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= kT;
+  s[3] = RotateLeft(s[3], 45);
+  return kResult;
+}
+
+// PCG32 (XSH RR) by Melissa O'Neill
+uint32_t Pcg32(uint64_t& state, const uint64_t kIncrement) {
+  const uint64_t kOldState = state;
+  state = kOldState * 6364136223846793005ULL + kIncrement;
+  const auto kXorShifted = static_cast<uint32_t>(((kOldState >> 18) ^ kOldState) >> 27);
+  return RotateRight(kXorShifted, static_cast<uint32_t>(kOldState >> 59));
+}
+
+// Philox4x32-10 by Salmon et al. Every block only depends on its counter, so the blocks of a refill don't depend on
+// each other like the outputs of the other engines do.
+std::array<uint32_t, 4> Philox4x32(const uint64_t kCounter, std::array<uint32_t, 2> key) {
+  std::array<uint32_t, 4> block = {static_cast<uint32_t>(kCounter), static_cast<uint32_t>(kCounter >> 32), 0, 0};
+
+  for (int round = 0; round < 10; round++) {
+    const uint64_t kProduct0 = 0xD2511F53ULL * block[0];
+    const uint64_t kProduct1 = 0xCD9E8D57ULL * block[2];
+    block = {static_cast<uint32_t>(kProduct1 >> 32) ^ block[1] ^ key[0], static_cast<uint32_t>(kProduct1),
+             static_cast<uint32_t>(kProduct0 >> 32) ^ block[3] ^ key[1], static_cast<uint32_t>(kProduct0)};
+    key[0] += 0x9E3779B9;
+    key[1] += 0xBB67AE85;
+  }
+
+  return block;
+}
+}
+
+uint64_t IterationSeed(const uint32_t kSimulationSeed, const int kIteration) {
+  // SplitMix64's output is a bijection of its state, so every (seed, iteration) pair gets its own seed
+  uint64_t state = static_cast<uint64_t>(kSimulationSeed) << 32 | static_cast<uint32_t>(kIteration);
+  return SplitMix64(state);
+}
+
+void Rng::Seed(const uint64_t kSeed, const RngEngine kEngine) {
+  _engine = kEngine;
+  uint64_t seed_state = kSeed;
+
+  switch (kEngine) {
+    case RngEngine::kMersenneTwister:
+      // Its seed is 32 bits, so both halves are folded into it
+      _mersenne_twister.seed(static_cast<uint32_t>(kSeed ^ kSeed >> 32));
+      break;
+    case RngEngine::kXoshiro256PlusPlus:
+      for (auto& state : _xoshiro_state) {
+        state = SplitMix64(seed_state);
+      }
+      break;
+    case RngEngine::kPcg32:
+      _pcg_state = SplitMix64(seed_state);
+      _pcg_increment = SplitMix64(seed_state) | 1;
+      break;
+    case RngEngine::kPhilox: {
+      const uint64_t kKey = SplitMix64(seed_state);
+      _philox_key = {static_cast<uint32_t>(kKey), static_cast<uint32_t>(kKey >> 32)};
+      _philox_counter = 0;
+      break;
+    }
+  }
+
+  Refill();
+}
+
+void Rng::Refill() {
+  switch (_engine) {
+    case RngEngine::kMersenneTwister:
+      for (auto& value : _buffer) {
+        value = static_cast<uint32_t>(_mersenne_twister());
+      }
+      break;
+    case RngEngine::kXoshiro256PlusPlus:
+      for (int i = 0; i < kBufferSize; i += 2) {
+        const uint64_t kValue = Xoshiro256PlusPlus(_xoshiro_state);
+        _buffer[i] = static_cast<uint32_t>(kValue >> 32);
+        _buffer[i + 1] = static_cast<uint32_t>(kValue);
+      }
+      break;
+    case RngEngine::kPcg32:
+      for (auto& value : _buffer) {
+        value = Pcg32(_pcg_state, _pcg_increment);
+      }
+      break;
+    case RngEngine::kPhilox:
+      for (int i = 0; i < kBufferSize; i += 4) {
+        const auto kBlock = Philox4x32(_philox_counter++, _philox_key);
+        std::copy(kBlock.begin(), kBlock.end(), _buffer.begin() + i);
+      }
+      break;
+  }
+
+  _position = 0;
+}
+
+// Lemire's multiply-shift maps the output onto the range without a division or a conversion to double
+int Rng::Range(const int kMin, const int kMax) {
+  const auto kRangeSize = static_cast<uint64_t>(kMax - kMin + 1);
+  return kMin + static_cast<int>(NextUint32() * kRangeSize >> 32);
+}
+
+uint64_t Rng::ChanceToThreshold(const double kChance) {
+  constexpr double kThresholdPerPercent = 4294967296.0 / 100;
+
+  if (kChance <= 0) {
+    return 0;
+  }
+
+  if (kChance >= 100) {
+    return 4294967296ULL;
+  }
+
+  return static_cast<uint64_t>(kChance * kThresholdPerPercent);
+}
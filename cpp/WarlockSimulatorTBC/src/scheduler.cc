@@ -0,0 +1,198 @@
+#include "../include/scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "../include/entity.h"
+#include "../include/enums.h"
+#include "../include/simulation.h"
+#include "../include/aura.h"
+#include "../include/damage_over_time.h"
+#include "../include/spell.h"
+#include "../include/player.h"
+#include "../include/trinket.h"
+
+int SecondsToTicks(const double kSeconds) { return static_cast<int>(std::lround(kSeconds * kTicksPerSecond)); }
+
+double TicksToSeconds(const int kTicks) { return static_cast<double>(kTicks) / kTicksPerSecond; }
+
+void Timer::Register(Entity& entity_param, const TimerType kType, const int kIndex) {
+  entity = &entity_param;
+  type = kType;
+  index = kIndex;
+}
+
+// Timers that run out immediately don't get an event since there's nothing to wait for. kWakeUp = false sets the
+// timer without an event for timers that run out while the simulation is waiting for something else anyway.
+void Timer::Start(const double kDuration, const bool kWakeUp) {
+  const int kTicks = SecondsToTicks(kDuration);
+  end = entity->simulation->current_tick + kTicks;
+
+  if (kTicks > 0 && kWakeUp) {
+    entity->simulation->scheduler.Schedule(*this);
+  } else {
+    entity->simulation->scheduler.Cancel(*this);
+  }
+}
+
+void Timer::Stop() {
+  end = entity->simulation->current_tick;
+  entity->simulation->scheduler.Cancel(*this);
+}
+
+// The type and the entity stay the same, so restoring a timer's state into the same timer of another entity that was
+// set up the same way works too
+void Timer::SetState(const TimerState& kState) {
+  index = kState.index;
+  end = kState.end;
+}
+
+double Timer::Remaining() const { return TicksToSeconds(end - entity->simulation->current_tick); }
+
+// Timers that run out at the same time are handled in the order that the entities used to tick them in before the
+// scheduler existed: the player before the pet, and for each of them auras, dots, spells (with a cast finishing after
+// the casting spell's cooldown), trinkets and mp5 in that order, each in the order of the entity's lists.
+int Timer::Order() const {
+  constexpr int kMaxIndex = 1024;
+  int phase;
+  int sub_order = 0;
+
+  switch (type) {
+    case TimerType::kAuraDuration:
+    case TimerType::kAuraTick:
+      phase = 0;
+      break;
+    case TimerType::kDotTick:
+      phase = 1;
+      break;
+    case TimerType::kCastTime:
+      sub_order = 1;
+      [[fallthrough]];
+    case TimerType::kSpellCooldown:
+      phase = 2;
+      break;
+    case TimerType::kTrinketDuration:
+      sub_order = 1;
+      [[fallthrough]];
+    case TimerType::kTrinketCooldown:
+      phase = 3;
+      break;
+    case TimerType::kMp5:
+      phase = 4;
+      break;
+    default:
+      phase = 5;
+      break;
+  }
+
+  const int kEntityOrder = entity->entity_type == EntityType::kPlayer ? 0 : 1;
+  return ((kEntityOrder * 8 + phase) * kMaxIndex + index) * 2 + sub_order;
+}
+
+// Gives every timer of the entity and of its auras, dots, spells and trinkets a slot, in a fixed order so that the
+// timers of two players that were initialized the same way have the same slots (see SimulationSnapshot)
+void Scheduler::AddTimers(Entity& entity) {
+  AddTimer(entity.cast_timer);
+  AddTimer(entity.gcd_timer);
+  AddTimer(entity.five_second_rule_timer);
+  AddTimer(entity.mp5_timer);
+
+  for (const auto& kAura : entity.aura_list) {
+    AddTimer(kAura->duration_timer);
+    AddTimer(kAura->tick_timer);
+  }
+
+  for (const auto& kDot : entity.dot_list) {
+    AddTimer(kDot->tick_timer);
+  }
+
+  for (const auto& kSpell : entity.spell_list) {
+    AddTimer(kSpell->cooldown_timer);
+  }
+
+  if (entity.entity_type == EntityType::kPlayer) {
+    for (auto& trinket : entity.player->trinkets) {
+      AddTimer(trinket.duration_timer);
+      AddTimer(trinket.cooldown_timer);
+    }
+  }
+}
+
+void Scheduler::AddTimer(Timer& timer) {
+  timer.slot = static_cast<int>(timers.size());
+  timers.push_back(&timer);
+
+  if (timers.size() > wake_times.size()) {
+    wake_times.resize(wake_times.size() + kLanes, kNotWaiting);
+    orders.resize(wake_times.size());
+  }
+}
+
+void Scheduler::Schedule(Timer& timer) {
+  wake_times[timer.slot] = timer.end;
+  orders[timer.slot] = timer.Order();
+}
+
+// Keeps a running minimum per lane instead of a single one so that the lanes are independent of each other and the
+// loop is compiled to vector min instructions
+int Scheduler::NextEventTime() const {
+  std::array<int, kLanes> lane_minimums;
+  lane_minimums.fill(kNotWaiting);
+
+  const int* wake_time = wake_times.data();
+
+  // GCC doesn't vectorize the inner loop if it updates lane_minimums in place
+  for (size_t i = 0; i < wake_times.size(); i += kLanes, wake_time += kLanes) {
+    std::array<int, kLanes> block_minimums;
+
+    for (int lane = 0; lane < kLanes; lane++) {
+      block_minimums[lane] = std::min(lane_minimums[lane], wake_time[lane]);
+    }
+
+    lane_minimums = block_minimums;
+  }
+
+  return *std::min_element(lane_minimums.begin(), lane_minimums.end());
+}
+
+// Returns the next timer that ran out at or before kTime, or nullptr if there's none left
+Timer* Scheduler::PopEvent(const int kTime) {
+  const int kNextTime = NextEventTime();
+
+  if (kNextTime > kTime) {
+    return nullptr;
+  }
+
+  // Same as NextEventTime() but for the lowest order of the timers that run out at kNextTime
+  std::array<int, kLanes> lane_minimums;
+  lane_minimums.fill(kNotWaiting);
+
+  const int* wake_time = wake_times.data();
+  const int* order = orders.data();
+
+  for (size_t i = 0; i < wake_times.size(); i += kLanes, wake_time += kLanes, order += kLanes) {
+    std::array<int, kLanes> block_minimums;
+
+    // A mask instead of a conditional so that GCC vectorizes it
+    for (int lane = 0; lane < kLanes; lane++) {
+      const int kRunsOut = -static_cast<int>(wake_time[lane] == kNextTime);
+      block_minimums[lane] = std::min(lane_minimums[lane], (order[lane] & kRunsOut) | (kNotWaiting & ~kRunsOut));
+    }
+
+    lane_minimums = block_minimums;
+  }
+
+  // An aura's duration and tick timers have the same order, the one in the lower slot goes first
+  const int kNextOrder = *std::min_element(lane_minimums.begin(), lane_minimums.end());
+  int next_slot = 0;
+
+  while (wake_times[next_slot] != kNextTime || orders[next_slot] != kNextOrder) {
+    next_slot++;
+  }
+
+  wake_times[next_slot] = kNotWaiting;
+  return timers[next_slot];
+}
+
+void Scheduler::Clear() { std::fill(wake_times.begin(), wake_times.end(), kNotWaiting); }
@@ -1,7 +1,9 @@
 #include "../include/simulation.h"
 
 #include <chrono>
-#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
 
 #include "../include/player.h"
 #include "../include/simulation_settings.h"
@@ -13,114 +15,291 @@
 #include "../include/trinket.h"
 #include "../include/damage_over_time.h"
 #include "../include/bindings.h"
+#include "../include/stat.h"
+#include "../include/simulation_snapshot.h"
+#include "../include/chrome_trace.h"
 
 Simulation::Simulation(Player& player, const SimulationSettings& kSimulationSettings)
   : player(player),
     kSettings(kSimulationSettings) {
 }
 
+namespace {
+// Everything one thread needs to run a range of iterations on its own copy of the player
+struct SimulationWorker {
+  PlayerSettings settings;
+  Player player;
+  Simulation simulation;
+
+  SimulationWorker(const PlayerSettings& kPlayerSettings, const SimulationSettings& kSimulationSettings)
+    : settings(kPlayerSettings),
+      player(settings),
+      simulation(player, kSimulationSettings) {
+  }
+};
+}
+
 void Simulation::Start() {
-  player.total_fight_duration = 0;
   player.Initialize(this);
-  min_dps = std::numeric_limits<double>::max();
-  max_dps = 0;
+  Run();
+}
+
+void Simulation::Run() {
+  ClearResults();
   const auto kStart = std::chrono::high_resolution_clock::now();
 
-  for (iteration = 0; iteration < kSettings.iterations; iteration++) {
-    const int kFightLength = player.rng.Range(kSettings.min_time, kSettings.max_time);
+  if (kSettings.target_standard_error > 0) {
+    // Check for convergence between fixed blocks of iterations so that where the simulation stops doesn't depend on the
+    // amount of threads
+    for (int first = 0; first < kSettings.iterations && !HasConverged(); first += kConvergenceCheckInterval) {
+      RunIterationRange(first, std::min(first + kConvergenceCheckInterval, kSettings.iterations));
+    }
+  } else {
+    RunIterationRange(0, kSettings.iterations);
+  }
+
+  const auto kEnd = std::chrono::high_resolution_clock::now();
+  const auto kMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(kEnd - kStart).count();
+
+  SimulationEnd(kMicroseconds);
+}
+
+void Simulation::ClearResults() {
+  player.total_fight_duration = 0;
+  dps_statistics.Clear();
+  dps_values.clear();
+  profiling = ProfilingCounters();
+}
 
-    IterationReset(kFightLength);
+// Adds the results of iterations kFirstIteration to kLastIteration - 1 to the results of the iterations before them
+void Simulation::RunIterationRange(const int kFirstIteration, const int kLastIteration) {
+  ResetThreadProfilingCounters();
 
-    while (current_fight_time < kFightLength) {
-      const double kFightTimeRemaining = kFightLength - current_fight_time;
+  if (const int kThreadAmount = std::min(kSettings.threads, kLastIteration - kFirstIteration); kThreadAmount > 1) {
+    RunIterationsInParallel(kFirstIteration, kLastIteration, kThreadAmount);
+  } else {
+    RunIterations(kFirstIteration, kLastIteration);
+  }
 
-      CastNonPlayerCooldowns(kFightTimeRemaining);
+  profiling.Merge(GetThreadProfilingCounters());
+}
 
-      if (player.cast_time_remaining <= 0) {
-        CastNonGcdSpells();
+bool Simulation::HasConverged() const {
+  return dps_statistics.count >= kConvergenceCheckInterval &&
+         dps_statistics.StandardError() < kSettings.target_standard_error;
+}
 
-        if (player.gcd_remaining <= 0) {
-          CastGcdSpells(kFightTimeRemaining);
-        }
-      }
+void Simulation::RunIterations(const int kFirstIteration, const int kLastIteration) {
+  for (int i = kFirstIteration; i < kLastIteration; i++) {
+    const int kFightLength = StartIteration(i);
+    const int kFightEnd = kFightLength * kTicksPerSecond;
 
-      if (player.pet != nullptr && player.settings.pet_mode == EmbindConstant::kAggressive) {
-        CastPetSpells();
-      }
+    RunFight(kFightEnd, kFightEnd);
+    IterationEnd(kFightLength, player.iteration_damage / static_cast<double>(kFightLength));
+  }
+}
 
-      if (PassTime(kFightTimeRemaining) <= 0) {
-        std::cout << "Iteration " << std::to_string(iteration) << " fightTime: " << std::to_string(current_fight_time)
-            << "/" << std::to_string(kFightLength) << " PassTime() returned <= 0" << std::endl;
-        player.ThrowError(
-            "The simulation got stuck in an endless loop. If you'd like to help with fixing this bug then please "
-            "export your current settings and post it in the #sim-bug-report channel on the Warlock Classic discord.");
+// Rolls the iteration's fight length and resets everything for it, returns the fight length in seconds
+int Simulation::StartIteration(const int kIteration) {
+  iteration = kIteration;
+  // Seed the rng before rolling the fight length so that an iteration's outcome only depends on the simulation's seed
+  // and its index, which lets the iterations be split between threads (or processes) without changing the results
+  player.rng.Seed(IterationSeed(kSettings.seed, iteration), kSettings.rng_engine);
+  const int kFightLength = player.rng.Range(kSettings.min_time, kSettings.max_time);
+
+  IterationReset(kFightLength);
+  return kFightLength;
+}
+
+// The casts of a step of the main loop, before time passes to the next timer event
+void Simulation::CastSpells(const int kFightEnd) const {
+  const double kFightTimeRemaining = TicksToSeconds(kFightEnd - current_tick);
+
+  CastNonPlayerCooldowns(kFightTimeRemaining);
+
+  if (player.cast_timer.Remaining() <= 0) {
+    CastNonGcdSpells();
+
+    if (player.gcd_timer.Remaining() <= 0) {
+      CastGcdSpells(kFightTimeRemaining);
+    }
+  }
+
+  if (player.pet != nullptr && player.settings.pet_mode == EmbindConstant::kAggressive) {
+    CastPetSpells();
+  }
+}
+
+void Simulation::RunIterationsInParallel(const int kFirstIteration, const int kLastIteration,
+                                         const int kThreadAmount) {
+  std::atomic<int> iterations_done = kFirstIteration;
+  completed_iterations = &iterations_done;
+
+  // Split the iterations into contiguous ranges. This simulation runs the first range itself and every other range is
+  // given to a worker with its own player, so no state is shared between the threads apart from the progress counter.
+  const int kIterationsPerThread = (kLastIteration - kFirstIteration) / kThreadAmount;
+  const int kRemainder = (kLastIteration - kFirstIteration) % kThreadAmount;
+  std::vector<std::pair<int, int>> ranges;
+
+  for (int i = 0, first = kFirstIteration; i < kThreadAmount; i++) {
+    const int kLast = first + kIterationsPerThread + (i < kRemainder ? 1 : 0);
+    ranges.emplace_back(first, kLast);
+    first = kLast;
+  }
+
+  std::vector<std::shared_ptr<SimulationWorker>> workers;
+  for (int i = 1; i < kThreadAmount; i++) {
+    const auto kWorker = std::make_shared<SimulationWorker>(player.settings, kSettings);
+    kWorker->simulation.is_worker = true;
+    kWorker->simulation.keep_dps_values = keep_dps_values || ShouldPostDpsValues();
+    kWorker->simulation.completed_iterations = &iterations_done;
+    workers.push_back(kWorker);
+  }
+
+  std::vector<std::exception_ptr> errors(kThreadAmount);
+  std::vector<std::thread> threads;
+
+  for (int i = 1; i < kThreadAmount; i++) {
+    threads.emplace_back([&, i] {
+      try {
+        auto& worker_simulation = workers[i - 1]->simulation;
+        worker_simulation.player.total_fight_duration = 0;
+        worker_simulation.player.Initialize(&worker_simulation);
+        // The player info at the top of the combat log is only needed once
+        worker_simulation.player.combat_log.Clear();
+        worker_simulation.dps_statistics.Clear();
+        worker_simulation.dps_values.clear();
+        ResetThreadProfilingCounters();
+        worker_simulation.RunIterations(ranges[i].first, ranges[i].second);
+        worker_simulation.profiling = GetThreadProfilingCounters();
+      } catch (...) {
+        errors[i] = std::current_exception();
       }
+    });
+  }
+
+  try {
+    RunIterations(ranges[0].first, ranges[0].second);
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  completed_iterations = nullptr;
+
+  for (const auto& kError : errors) {
+    if (kError != nullptr) {
+      std::rethrow_exception(kError);
     }
+  }
 
-    IterationEnd(kFightLength, player.iteration_damage / static_cast<double>(kFightLength));
+  for (const auto& kWorker : workers) {
+    MergeWorkerResults(kWorker->simulation);
   }
+}
 
-  const auto kEnd = std::chrono::high_resolution_clock::now();
-  const auto kMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(kEnd - kStart).count();
+void Simulation::MergeWorkerResults(const Simulation& kWorker) {
+  // The workers don't post their dps values so send them now that we're back on the main thread
+  if (ShouldPostDpsValues()) {
+    for (const auto& kDps : kWorker.dps_values) {
+      DpsUpdate(kDps);
+    }
+  }
 
-  SimulationEnd(kMicroseconds);
+  dps_statistics.Merge(kWorker.dps_statistics);
+
+  if (keep_dps_values) {
+    dps_values.insert(dps_values.end(), kWorker.dps_values.begin(), kWorker.dps_values.end());
+  }
+
+  profiling.Merge(kWorker.profiling);
+  player.total_fight_duration += kWorker.player.total_fight_duration;
+  player.combat_log.Merge(kWorker.player.combat_log, kWorker.player, player);
+  player.MergeCombatLogBreakdown(kWorker.player);
+
+  if (player.pet != nullptr && kWorker.player.pet != nullptr) {
+    player.pet->MergeCombatLogBreakdown(*kWorker.player.pet);
+  }
 }
 
-double Simulation::PassTime(const double kFightTimeRemaining) {
-  auto time_until_next_action = player.FindTimeUntilNextAction();
+// Skips to the next tick that one of the timers runs out at (or to the end of the fight) and handles every timer that
+// ran out by then. Timers only get an event if they run out at least one tick later than the tick they were started on,
+// so time always moves forward.
+void Simulation::PassTime(const int kFightEnd) {
+  PassTime(kFightEnd, [](const Timer&) {});
+}
 
-  time_until_next_action = std::min(time_until_next_action, kFightTimeRemaining);
+void Simulation::RunFight(const int kFightEnd, const int kUntilTick) {
+  RunFight(kFightEnd, kUntilTick, [] {}, [](const Timer&) {});
+}
 
-  Tick(time_until_next_action);
+double Simulation::GetCurrentFightTime() const { return TicksToSeconds(current_tick); }
+
+bool SpellCandidates::Contains(const Spell* kSpell) const {
+  for (int i = 0; i < size; i++) {
+    if (spells[i] == kSpell) {
+      return true;
+    }
+  }
 
-  return time_until_next_action;
+  return false;
 }
 
-void Simulation::SelectedSpellHandler(const std::shared_ptr<Spell>& kSpell,
-                                      std::map<std::shared_ptr<Spell>, double>& predicted_damage_of_spells,
+void SpellCandidates::Add(Spell* spell, const double kPredictedDamage) {
+  spells[size] = spell;
+  predicted_damage[size] = kPredictedDamage;
+  size++;
+}
+
+void Simulation::SelectedSpellHandler(Spell& spell, SpellCandidates& candidates,
                                       const double kFightTimeRemaining) const {
-  if ((player.settings.rotation_option == EmbindConstant::kSimChooses || kSpell->is_finisher) &&
-      !predicted_damage_of_spells.contains(kSpell)) {
-    predicted_damage_of_spells.insert({kSpell, kSpell->PredictDamage()});
-  } else if (kSpell->HasEnoughMana()) {
-    CastSelectedSpell(kSpell, kFightTimeRemaining);
+  if ((player.settings.rotation_option == EmbindConstant::kSimChooses || spell.is_finisher) &&
+      !candidates.Contains(&spell)) {
+    candidates.Add(&spell, spell.PredictDamage());
+  } else if (spell.HasEnoughMana()) {
+    CastSelectedSpell(spell, kFightTimeRemaining);
   } else {
     player.CastLifeTapOrDarkPact();
   }
 }
 
-void Simulation::CastSelectedSpell(const std::shared_ptr<Spell>& kSpell, const double kFightTimeRemaining,
+void Simulation::CastSelectedSpell(Spell& spell, const double kFightTimeRemaining,
                                    const double kPredictedDamage) const {
   player.UseCooldowns(kFightTimeRemaining);
 
   if (player.spells.amplify_curse != nullptr && player.spells.amplify_curse->Ready() &&
-      (kSpell->name == SpellName::kCurseOfAgony || kSpell->name == SpellName::kCurseOfDoom)) {
+      (spell.id == SpellId::kCurseOfAgony || spell.id == SpellId::kCurseOfDoom)) {
     player.spells.amplify_curse->StartCast();
   }
 
-  kSpell->StartCast(kPredictedDamage);
+  spell.StartCast(kPredictedDamage);
 }
 
-void Simulation::Tick(const double kTime) {
-  current_fight_time += kTime;
-  player.Tick(kTime);
+void Simulation::IterationReset(const double kFightLength) {
+  current_tick = 0;
+  scheduler.Clear();
+
+  // Checked on every event that could be logged, so it's worked out once per iteration
+  const int kIterationsSinceFirstLogged = iteration - kSettings.combat_log_first_iteration;
+  const int kInterval = std::max(1, kSettings.combat_log_iteration_interval);
+  player.writing_combat_log = player.equipped_item_simulation && kIterationsSinceFirstLogged >= 0 &&
+                              kIterationsSinceFirstLogged % kInterval == 0 &&
+                              kIterationsSinceFirstLogged / kInterval < kSettings.combat_log_iterations;
+
   if (player.pet != nullptr) {
-    player.pet->Tick(kTime);
+    player.pet->writing_combat_log = player.writing_combat_log;
   }
-}
-
-void Simulation::IterationReset(const double kFightLength) {
-  current_fight_time = 0;
 
   player.Reset();
   if (player.pet != nullptr) {
     player.pet->Reset();
   }
 
-  player.rng.Seed(player.settings.random_seeds[iteration]);
-
   if (player.ShouldWriteToCombatLog()) {
-    player.CombatLog("Fight length: " + DoubleToString(kFightLength) + " seconds");
+    player.CombatLog({.type = CombatLogEventType::kFightLength, .values = {kFightLength, 1.0 * iteration}});
   }
 
   if (player.auras.airmans_ribbon_of_gallantry != nullptr) {
@@ -141,7 +320,7 @@ void Simulation::IterationReset(const double kFightLength) {
       // trinkets, then assume that Black Book is equipped in the second trinket slot, otherwise the first slot
 
       if (const auto kBlackBookTrinketSlot = player.trinkets.size() == 1 || !player.trinkets[0].shares_cooldown ? 1 : 0; player.trinkets.size() > kBlackBookTrinketSlot) {
-        player.trinkets[kBlackBookTrinketSlot].cooldown_remaining = player.pet->auras.black_book->duration;
+        player.trinkets[kBlackBookTrinketSlot].cooldown_timer.Start(player.pet->auras.black_book->duration);
       }
 
       player.pet->auras.black_book->Apply();
@@ -149,7 +328,64 @@ void Simulation::IterationReset(const double kFightLength) {
   }
 }
 
+// Can be called at any point of a fight, e.g. to try out different decisions from the same state by restoring it
+// after each of them
+void Simulation::SaveSnapshot(SimulationSnapshot& snapshot) const {
+  snapshot.current_tick = current_tick;
+  snapshot.wake_times = scheduler.wake_times;
+  snapshot.orders = scheduler.orders;
+
+  player.SaveState(snapshot.player);
+  snapshot.has_pet = player.pet != nullptr;
+
+  if (snapshot.has_pet) {
+    player.pet->SaveState(snapshot.pet);
+  }
+
+  snapshot.trinkets.clear();
+  for (const auto& kTrinket : player.trinkets) {
+    snapshot.trinkets.push_back(
+        {kTrinket.duration_timer.GetState(), kTrinket.cooldown_timer.GetState(), kTrinket.active});
+  }
+
+  snapshot.rng = player.rng;
+  snapshot.derived_stats = player.derived_stats;
+  snapshot.iteration_damage = player.iteration_damage;
+  snapshot.power_infusions_ready = player.power_infusions_ready;
+}
+
+// The scheduler's slots only refer to the timers by their position, so they work for this simulation's player too
+void Simulation::RestoreSnapshot(const SimulationSnapshot& kSnapshot) {
+  if (kSnapshot.has_pet != (player.pet != nullptr) || kSnapshot.trinkets.size() != player.trinkets.size() ||
+      kSnapshot.wake_times.size() != scheduler.wake_times.size()) {
+    throw std::invalid_argument("the snapshot was taken of a player with a different pet or trinkets");
+  }
+
+  player.RestoreState(kSnapshot.player);
+
+  if (kSnapshot.has_pet) {
+    player.pet->RestoreState(kSnapshot.pet);
+  }
+
+  for (size_t i = 0; i < player.trinkets.size(); i++) {
+    player.trinkets[i].duration_timer.SetState(kSnapshot.trinkets[i].duration_timer);
+    player.trinkets[i].cooldown_timer.SetState(kSnapshot.trinkets[i].cooldown_timer);
+    player.trinkets[i].active = kSnapshot.trinkets[i].active;
+  }
+
+  player.rng = kSnapshot.rng;
+  player.derived_stats = kSnapshot.derived_stats;
+  player.iteration_damage = kSnapshot.iteration_damage;
+  player.power_infusions_ready = kSnapshot.power_infusions_ready;
+
+  current_tick = kSnapshot.current_tick;
+  scheduler.wake_times = kSnapshot.wake_times;
+  scheduler.orders = kSnapshot.orders;
+}
+
 void Simulation::CastNonPlayerCooldowns(const double kFightTimeRemaining) const {
+  const auto kProfilingTimer = ProfilingPhaseTimer(ProfilingPhase::kCastNonPlayerCooldowns);
+
   // Use Drums
   if (player.spells.drums_of_battle != nullptr && !player.auras.drums_of_battle->active &&
       player.spells.drums_of_battle->Ready()) {
@@ -182,8 +418,10 @@ void Simulation::CastNonPlayerCooldowns(const double kFightTimeRemaining) const
 }
 
 void Simulation::CastNonGcdSpells() const {
+  const auto kProfilingTimer = ProfilingPhaseTimer(ProfilingPhase::kCastNonGcdSpells);
+
   // Demonic Rune
-  if ((current_fight_time > 5 || player.stats.mp5 == 0.0) && player.spells.demonic_rune != nullptr &&
+  if ((GetCurrentFightTime() > 5 || player.stats.mp5 == 0.0) && player.spells.demonic_rune != nullptr &&
       player.stats.max_mana - player.stats.mana > player.spells.demonic_rune->max_mana_gain &&
       player.spells.demonic_rune->Ready() &&
       (!player.spells.chipped_power_core || !player.spells.chipped_power_core->Ready()) &&
@@ -192,7 +430,7 @@ void Simulation::CastNonGcdSpells() const {
   }
 
   // Super Mana Potion
-  if ((current_fight_time > 5 || player.stats.mp5 == 0.0) && player.spells.super_mana_potion != nullptr &&
+  if ((GetCurrentFightTime() > 5 || player.stats.mp5 == 0.0) && player.spells.super_mana_potion != nullptr &&
       player.stats.max_mana - player.stats.mana > player.spells.super_mana_potion->max_mana_gain &&
       player.spells.super_mana_potion->Ready()) {
     player.spells.super_mana_potion->StartCast();
@@ -200,52 +438,54 @@ void Simulation::CastNonGcdSpells() const {
 }
 
 void Simulation::CastGcdSpells(const double kFightTimeRemaining) const {
+  const auto kProfilingTimer = ProfilingPhaseTimer(ProfilingPhase::kCastGcdSpells);
+
   if (player.settings.fight_type == EmbindConstant::kSingleTarget) {
     const bool kNotEnoughTimeForFillerSpell = kFightTimeRemaining < player.filler->GetCastTime();
 
-    // Map of spells with their predicted Damage as the value. This is
-    // used by the sim to determine what the best spell to Cast is.
-    std::map<std::shared_ptr<Spell>, double> predicted_damage_of_spells;
+    // Spells with their predicted damage. This is used by the sim to
+    // determine what the best spell to Cast is.
+    SpellCandidates candidates;
 
     // If the sim is choosing the rotation for the user then predict the
     // damage of the three filler spells if they're available
     if (player.settings.rotation_option == EmbindConstant::kSimChooses) {
       if (kFightTimeRemaining >= player.spells.shadow_bolt->GetCastTime()) {
-        predicted_damage_of_spells.insert({player.spells.shadow_bolt, player.spells.shadow_bolt->PredictDamage()});
+        candidates.Add(player.spells.shadow_bolt, player.spells.shadow_bolt->PredictDamage());
       }
 
       if (kFightTimeRemaining >= player.spells.incinerate->GetCastTime()) {
-        predicted_damage_of_spells.insert({player.spells.incinerate, player.spells.incinerate->PredictDamage()});
+        candidates.Add(player.spells.incinerate, player.spells.incinerate->PredictDamage());
       }
 
       if (kFightTimeRemaining >= player.spells.searing_pain->GetCastTime()) {
-        predicted_damage_of_spells.insert({player.spells.searing_pain, player.spells.searing_pain->PredictDamage()});
+        candidates.Add(player.spells.searing_pain, player.spells.searing_pain->PredictDamage());
       }
     }
 
     // Cast Conflagrate if there's not enough time for another filler
     // and Immolate is up
     if (kNotEnoughTimeForFillerSpell && player.spells.conflagrate != nullptr && player.spells.conflagrate->CanCast()) {
-      SelectedSpellHandler(player.spells.conflagrate, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.conflagrate, candidates, kFightTimeRemaining);
     }
 
     // Cast Shadowburn if there's not enough time for another filler
-    if (player.gcd_remaining <= 0 && kNotEnoughTimeForFillerSpell && player.spells.shadowburn != nullptr &&
+    if (player.gcd_timer.Remaining() <= 0 && kNotEnoughTimeForFillerSpell && player.spells.shadowburn != nullptr &&
         player.spells.shadowburn->CanCast()) {
-      SelectedSpellHandler(player.spells.shadowburn, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.shadowburn, candidates, kFightTimeRemaining);
     }
 
     // Cast Death Coil if there's not enough time for another filler
-    if (player.gcd_remaining <= 0 && kNotEnoughTimeForFillerSpell && player.spells.death_coil != nullptr &&
+    if (player.gcd_timer.Remaining() <= 0 && kNotEnoughTimeForFillerSpell && player.spells.death_coil != nullptr &&
         player.spells.death_coil->CanCast()) {
-      SelectedSpellHandler(player.spells.death_coil, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.death_coil, candidates, kFightTimeRemaining);
     }
 
     // Cast Curse of the Elements or Curse of Recklessness if they're
     // the selected curse and they're not active
-    if (kFightTimeRemaining >= 10 && player.gcd_remaining <= 0 && player.curse_spell != nullptr &&
-        (player.curse_spell->name == SpellName::kCurseOfRecklessness ||
-         player.curse_spell->name == SpellName::kCurseOfTheElements) &&
+    if (kFightTimeRemaining >= 10 && player.gcd_timer.Remaining() <= 0 && player.curse_spell != nullptr &&
+        (player.curse_spell->id == SpellId::kCurseOfRecklessness ||
+         player.curse_spell->id == SpellId::kCurseOfTheElements) &&
         !player.curse_aura->active && player.curse_spell->CanCast()) {
       if (player.curse_spell->HasEnoughMana()) {
         player.curse_spell->StartCast();
@@ -256,109 +496,114 @@ void Simulation::CastGcdSpells(const double kFightTimeRemaining) const {
 
     // Cast Curse of Doom if it's the selected curse and there's more
     // than 60 seconds remaining
-    if (player.gcd_remaining <= 0 && kFightTimeRemaining > 60 && player.curse_spell != nullptr &&
-        player.curse_spell->name == SpellName::kCurseOfDoom && !player.auras.curse_of_doom->active &&
+    if (player.gcd_timer.Remaining() <= 0 && kFightTimeRemaining > 60 && player.curse_spell != nullptr &&
+        player.curse_spell->id == SpellId::kCurseOfDoom && !player.auras.curse_of_doom->active &&
         player.spells.curse_of_doom->CanCast()) {
-      SelectedSpellHandler(player.spells.curse_of_doom, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.curse_of_doom, candidates, kFightTimeRemaining);
     }
 
     // Cast Curse of Agony if CoA is the selected curse or if Curse of
     // Doom is the selected curse and there's less than 60 seconds
     // remaining of the fight
-    if (player.gcd_remaining <= 0 && player.auras.curse_of_agony != nullptr && !player.auras.curse_of_agony->active &&
-        player.spells.curse_of_agony->CanCast() && kFightTimeRemaining > player.auras.curse_of_agony->duration &&
-        (player.curse_spell->name == SpellName::kCurseOfDoom && !player.auras.curse_of_doom->active &&
-         (player.spells.curse_of_doom->cooldown_remaining > player.auras.curse_of_agony->duration ||
+    if (player.gcd_timer.Remaining() <= 0 && player.auras.curse_of_agony != nullptr &&
+        !player.auras.curse_of_agony->active && player.spells.curse_of_agony->CanCast() &&
+        kFightTimeRemaining > player.auras.curse_of_agony->duration &&
+        (player.curse_spell->id == SpellId::kCurseOfDoom && !player.auras.curse_of_doom->active &&
+         (player.spells.curse_of_doom->cooldown_timer.Remaining() > player.auras.curse_of_agony->duration ||
           kFightTimeRemaining < 60) ||
-         player.curse_spell->name == SpellName::kCurseOfAgony)) {
-      SelectedSpellHandler(player.spells.curse_of_agony, predicted_damage_of_spells, kFightTimeRemaining);
+         player.curse_spell->id == SpellId::kCurseOfAgony)) {
+      SelectedSpellHandler(*player.spells.curse_of_agony, candidates, kFightTimeRemaining);
     }
 
     // Cast Corruption if Corruption isn't up or if it will expire
     // before the Cast finishes (if no instant Corruption)
-    if (player.gcd_remaining <= 0 && player.spells.corruption != nullptr &&
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.corruption != nullptr &&
         (!player.auras.corruption->active ||
          player.auras.corruption->ticks_remaining == 1 &&
-         player.auras.corruption->tick_timer_remaining < player.spells.corruption->GetCastTime()) &&
+         player.auras.corruption->tick_timer.Remaining() < player.spells.corruption->GetCastTime()) &&
         player.spells.corruption->CanCast() &&
         kFightTimeRemaining - player.spells.corruption->GetCastTime() >= player.auras.corruption->duration) {
-      SelectedSpellHandler(player.spells.corruption, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.corruption, candidates, kFightTimeRemaining);
     }
 
     // Cast Shadow Bolt if Shadow Trance (Nightfall) is active and
     // Corruption is active as well to avoid potentially wasting another
     // Nightfall proc
-    if (player.gcd_remaining <= 0 && player.spells.shadow_bolt != nullptr && player.auras.shadow_trance != nullptr &&
-        player.auras.shadow_trance->active && player.auras.corruption->active && player.spells.shadow_bolt->CanCast()) {
-      SelectedSpellHandler(player.spells.shadow_bolt, predicted_damage_of_spells, kFightTimeRemaining);
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.shadow_bolt != nullptr &&
+        player.auras.shadow_trance != nullptr && player.auras.shadow_trance->active &&
+        player.auras.corruption->active && player.spells.shadow_bolt->CanCast()) {
+      SelectedSpellHandler(*player.spells.shadow_bolt, candidates, kFightTimeRemaining);
     }
 
     // Cast Unstable Affliction if it's not up or if it's about to
     // expire
-    if (player.gcd_remaining <= 0 && player.spells.unstable_affliction != nullptr &&
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.unstable_affliction != nullptr &&
         player.spells.unstable_affliction->CanCast() &&
         (!player.auras.unstable_affliction->active ||
          player.auras.unstable_affliction->ticks_remaining == 1 &&
-         player.auras.unstable_affliction->tick_timer_remaining < player.spells.unstable_affliction->GetCastTime()) &&
+         player.auras.unstable_affliction->tick_timer.Remaining() < player.spells.unstable_affliction->GetCastTime()) &&
         kFightTimeRemaining - player.spells.unstable_affliction->GetCastTime() >=
         player.auras.unstable_affliction->duration) {
-      SelectedSpellHandler(player.spells.unstable_affliction, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.unstable_affliction, candidates, kFightTimeRemaining);
     }
 
     // Cast Siphon Life if it's not up (todo: add option to only Cast it
     // while ISB is active if not using custom ISB uptime %)
-    if (player.gcd_remaining <= 0 && player.spells.siphon_life != nullptr && !player.auras.siphon_life->active &&
-        player.spells.siphon_life->CanCast() && kFightTimeRemaining >= player.auras.siphon_life->duration) {
-      SelectedSpellHandler(player.spells.siphon_life, predicted_damage_of_spells, kFightTimeRemaining);
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.siphon_life != nullptr &&
+        !player.auras.siphon_life->active && player.spells.siphon_life->CanCast() &&
+        kFightTimeRemaining >= player.auras.siphon_life->duration) {
+      SelectedSpellHandler(*player.spells.siphon_life, candidates, kFightTimeRemaining);
     }
 
     // Cast Immolate if it's not up or about to expire
-    if (player.gcd_remaining <= 0 && player.spells.immolate != nullptr && player.spells.immolate->CanCast() &&
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.immolate != nullptr && player.spells.immolate->CanCast() &&
         (!player.auras.immolate->active ||
          player.auras.immolate->ticks_remaining == 1 &&
-         player.auras.immolate->tick_timer_remaining < player.spells.immolate->GetCastTime()) &&
+         player.auras.immolate->tick_timer.Remaining() < player.spells.immolate->GetCastTime()) &&
         kFightTimeRemaining - player.spells.immolate->GetCastTime() >= player.auras.immolate->duration) {
-      SelectedSpellHandler(player.spells.immolate, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.spells.immolate, candidates, kFightTimeRemaining);
     }
 
     // Cast Shadow Bolt if Shadow Trance (Nightfall) is active
-    if (player.gcd_remaining <= 0 && player.spells.shadow_bolt != nullptr && player.auras.shadow_trance != nullptr &&
-        player.auras.shadow_trance->active && player.spells.shadow_bolt->CanCast()) {
-      SelectedSpellHandler(player.spells.shadow_bolt, predicted_damage_of_spells, kFightTimeRemaining);
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.shadow_bolt != nullptr &&
+        player.auras.shadow_trance != nullptr && player.auras.shadow_trance->active &&
+        player.spells.shadow_bolt->CanCast()) {
+      SelectedSpellHandler(*player.spells.shadow_bolt, candidates, kFightTimeRemaining);
     }
 
     // Cast Shadowfury
-    if (player.gcd_remaining <= 0 && player.spells.shadowfury != nullptr && player.spells.shadowfury->CanCast()) {
-      SelectedSpellHandler(player.spells.shadowfury, predicted_damage_of_spells, kFightTimeRemaining);
+    if (player.gcd_timer.Remaining() <= 0 && player.spells.shadowfury != nullptr &&
+        player.spells.shadowfury->CanCast()) {
+      SelectedSpellHandler(*player.spells.shadowfury, candidates, kFightTimeRemaining);
     }
 
     // Cast filler spell if sim is not choosing the rotation for the
-    // user or if the predicted_damage_of_spells map is empty
-    if (player.gcd_remaining <= 0 &&
+    // user or if there are no candidates
+    if (player.gcd_timer.Remaining() <= 0 &&
         (!kNotEnoughTimeForFillerSpell && player.settings.rotation_option == EmbindConstant::kUserChooses ||
-         predicted_damage_of_spells.empty()) &&
+         candidates.Empty()) &&
         player.filler->CanCast()) {
-      SelectedSpellHandler(player.filler, predicted_damage_of_spells, kFightTimeRemaining);
+      SelectedSpellHandler(*player.filler, candidates, kFightTimeRemaining);
     }
 
-    // If the predicted_damage_of_spells map is not empty then check now
-    // which spell would be the best to Cast
-    if (player.gcd_remaining <= 0 && player.cast_time_remaining <= 0 && !predicted_damage_of_spells.empty()) {
-      std::shared_ptr<Spell> max_damage_spell;
+    // If there are candidates then check now which spell would be the
+    // best to Cast
+    if (player.gcd_timer.Remaining() <= 0 && player.cast_timer.Remaining() <= 0 && !candidates.Empty()) {
+      Spell* max_damage_spell = nullptr;
       auto max_damage_spell_value = 0.0;
 
-      for (const auto& [kSpell, kDamage] : predicted_damage_of_spells) {
-        if (kDamage > max_damage_spell_value &&
-            (kFightTimeRemaining > player.GetGcdValue() || kSpell->HasEnoughMana())) {
-          max_damage_spell = kSpell;
-          max_damage_spell_value = kDamage;
+      for (int i = 0; i < candidates.size; i++) {
+        if (candidates.predicted_damage[i] > max_damage_spell_value &&
+            (kFightTimeRemaining > player.GetGcdValue() || candidates.spells[i]->HasEnoughMana())) {
+          max_damage_spell = candidates.spells[i];
+          max_damage_spell_value = candidates.predicted_damage[i];
         }
       }
 
       // If a max Damage spell was not found or if the max Damage spell
       // isn't Ready (no mana), then Cast Life Tap
       if (max_damage_spell != nullptr && max_damage_spell->HasEnoughMana()) {
-        CastSelectedSpell(max_damage_spell, kFightTimeRemaining, max_damage_spell_value);
+        CastSelectedSpell(*max_damage_spell, kFightTimeRemaining, max_damage_spell_value);
       } else {
         player.CastLifeTapOrDarkPact();
       }
@@ -376,6 +621,8 @@ void Simulation::CastGcdSpells(const double kFightTimeRemaining) const {
 }
 
 void Simulation::CastPetSpells() const {
+  const auto kProfilingTimer = ProfilingPhaseTimer(ProfilingPhase::kCastPetSpells);
+
   // Auto Attack
   if (player.pet->spells.melee != nullptr && player.pet->spells.melee->Ready()) {
     player.pet->spells.melee->StartCast();
@@ -407,30 +654,31 @@ void Simulation::IterationEnd(const double kFightLength, const double kDps) {
   }
 
   if (player.ShouldWriteToCombatLog()) {
-    player.CombatLog("Fight end");
+    player.CombatLog({.type = CombatLogEventType::kFightEnd});
   }
 
   player.total_fight_duration += kFightLength;
 
-  if (kDps > max_dps) {
-    max_dps = kDps;
-  }
+  dps_statistics.Add(kDps);
 
-  if (kDps < min_dps) {
-    min_dps = kDps;
+  if (keep_dps_values) {
+    dps_values.push_back(kDps);
   }
 
-  dps_vector.push_back(kDps);
+  const int kCompletedIterations = completed_iterations != nullptr ? ++*completed_iterations : iteration + 1;
+
+  // Workers can't post anything since the callbacks aren't thread-safe, their dps values are sent after they finish
+  if (is_worker) {
+    return;
+  }
 
-  // Only send the iteration's dps to the web worker if we're doing a normal
-  // simulation (this is just for the dps histogram)
-  if (kSettings.simulation_type == SimulationType::kNormal && player.custom_stat == "normal") {
+  if (ShouldPostDpsValues()) {
     DpsUpdate(kDps);
   }
 
-  if (iteration % static_cast<int>(std::floor(kSettings.iterations / 100.0)) == 0) {
-    SimulationUpdate(iteration, kSettings.iterations, Median(dps_vector), player.settings.item_id,
-                     player.custom_stat.c_str());
+  if (iteration % std::max(1, kSettings.iterations / 100) == 0) {
+    SimulationUpdate(kCompletedIterations - 1, kSettings.iterations, dps_statistics.running_median.Estimate(),
+                     player.settings.item_id, player.custom_stat.c_str());
   }
 }
 
@@ -438,6 +686,10 @@ void Simulation::SimulationEnd(const long long kSimulationDuration) const {
   // Send the contents of the combat log to the web worker
   if (player.equipped_item_simulation) {
     player.SendCombatLogEntries();
+
+    if (kSettings.chrome_trace) {
+      ChromeTraceUpdate(FormatChromeTrace(player.combat_log).c_str());
+    }
   }
 
   // Send the combat log breakdown info
@@ -449,6 +701,17 @@ void Simulation::SimulationEnd(const long long kSimulationDuration) const {
     }
   }
 
-  SendSimulationResults(Median(dps_vector), min_dps, max_dps, player.settings.item_id, kSettings.iterations,
-                        static_cast<int>(player.total_fight_duration), player.custom_stat.c_str(), kSimulationDuration);
+  if constexpr (kProfiling) {
+    SendProfilingCounters(FormatProfilingCounters(profiling, dps_statistics.count).c_str());
+  }
+
+  SendSimulationResults(dps_statistics.Median(), dps_statistics.min, dps_statistics.max, player.settings.item_id,
+                        dps_statistics.count, static_cast<int>(player.total_fight_duration), player.custom_stat.c_str(),
+                        kSimulationDuration);
+}
+
+// Only send the iterations' dps to the web worker if we're doing a normal simulation (this is just for the dps
+// histogram)
+bool Simulation::ShouldPostDpsValues() const {
+  return kSettings.simulation_type == SimulationType::kNormal && player.custom_stat == "normal";
 }
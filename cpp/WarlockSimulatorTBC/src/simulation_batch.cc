@@ -0,0 +1,188 @@
+#include "../include/simulation_batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "../include/chrome_trace.h"
+#include "../include/common.h"
+#include "../include/player.h"
+#include "../include/player_settings.h"
+#include "../include/simulation.h"
+#include "../include/simulation_settings.h"
+#include "../include/stat.h"
+#include "../include/trinket.h"
+
+namespace {
+// A variant run side by side with the others when the batch pairs its variants and stops once they've converged. It
+// has its own copy of the settings for its stats but shares the items and talents with the batch's settings.
+struct PairedVariant {
+  PlayerSettings settings;
+  Player player;
+  Simulation simulation;
+  RunningMeanVariance differences; // To the first variant's dps, iteration by iteration
+  double simulation_duration = 0;
+
+  PairedVariant(const PlayerSettings& kPlayerSettings, const SimulationSettings& kSimulationSettings)
+    : settings(kPlayerSettings),
+      player(settings),
+      simulation(player, kSimulationSettings) {
+  }
+};
+
+SimulationVariantResult GetResult(const std::string& kName, const Simulation& kSimulation,
+                                  const double kSimulationDuration, const bool kRebuiltPlayer) {
+  const auto& kStatistics = kSimulation.dps_statistics;
+  return {kName,
+          kStatistics.Median(),
+          kStatistics.min,
+          kStatistics.max,
+          kStatistics.mean,
+          kStatistics.StandardDeviation(),
+          kStatistics.count,
+          kSimulation.player.total_fight_duration,
+          kSimulationDuration,
+          kRebuiltPlayer,
+          kSimulation.dps_values,
+          kSimulation.player.equipped_item_simulation && kSimulation.kSettings.chrome_trace
+              ? FormatChromeTrace(kSimulation.player.combat_log)
+              : "",
+          kSimulation.profiling};
+}
+}
+
+SimulationBatch::SimulationBatch(PlayerSettings& player_settings, const SimulationSettings& kSimulationSettings)
+  : settings(player_settings),
+    kSettings(kSimulationSettings) {
+}
+
+void SimulationBatch::AddVariant(const SimulationVariant& kVariant) { variants.push_back(kVariant); }
+
+std::vector<SimulationVariantResult> SimulationBatch::Start() {
+  // The variants are swapped into the settings one at a time so keep what they replace to restore it afterwards
+  const Items kItems = settings.items;
+  const Talents kTalents = settings.talents;
+  const CharacterStats kStats = settings.stats;
+  const EmbindConstant kCustomStat = settings.custom_stat;
+  const int kItemId = settings.item_id;
+  const auto kRestoreSettings = [&] {
+    settings.items = kItems;
+    settings.talents = kTalents;
+    settings.stats = kStats;
+    settings.custom_stat = kCustomStat;
+    settings.item_id = kItemId;
+  };
+
+  std::vector<SimulationVariantResult> results;
+
+  try {
+    // Variants that stopped early on their own would no longer have run the same iterations so paired variants are run
+    // side by side instead
+    results = keep_dps_values && kSettings.target_standard_error > 0 ? RunPaired() : RunInOrder();
+  } catch (...) {
+    kRestoreSettings();
+    throw;
+  }
+
+  kRestoreSettings();
+  return results;
+}
+
+void SimulationBatch::ApplyVariant(const SimulationVariant& kVariant) {
+  settings.items = kVariant.items;
+  settings.talents = kVariant.talents;
+  settings.stats = kVariant.stats;
+  settings.custom_stat = kVariant.custom_stat;
+  settings.item_id = kVariant.item_id;
+}
+
+std::vector<SimulationVariantResult> SimulationBatch::RunInOrder() {
+  std::vector<SimulationVariantResult> results;
+  std::shared_ptr<Player> player;
+  std::shared_ptr<Simulation> simulation;
+
+  for (const auto& kVariant : variants) {
+    const auto kStart = std::chrono::high_resolution_clock::now();
+    const bool kRebuildPlayer =
+        player == nullptr || kVariant.items != settings.items || kVariant.talents != settings.talents;
+
+    ApplyVariant(kVariant);
+
+    if (kRebuildPlayer) {
+      simulation = nullptr;
+      player = std::make_shared<Player>(settings);
+      simulation = std::make_shared<Simulation>(*player, kSettings);
+      simulation->keep_dps_values = keep_dps_values;
+      player->Initialize(simulation.get());
+    } else {
+      player->RefreshStats();
+    }
+
+    simulation->Run();
+
+    const auto kEnd = std::chrono::high_resolution_clock::now();
+    results.push_back(GetResult(kVariant.name, *simulation, std::chrono::duration<double>(kEnd - kStart).count(),
+                                kRebuildPlayer));
+  }
+
+  return results;
+}
+
+// Runs the variants side by side in blocks of iterations until the dps difference of every variant to the first one
+// has converged, so that all of them stop after the same iterations
+std::vector<SimulationVariantResult> SimulationBatch::RunPaired() {
+  std::vector<std::shared_ptr<PairedVariant>> paired_variants;
+
+  for (const auto& kVariant : variants) {
+    if (kVariant.items != variants[0].items || kVariant.talents != variants[0].talents) {
+      throw std::invalid_argument("paired variants with a target standard error need the same items and talents");
+    }
+
+    const auto kStart = std::chrono::high_resolution_clock::now();
+    ApplyVariant(kVariant);
+    const auto kPairedVariant = std::make_shared<PairedVariant>(settings, kSettings);
+    kPairedVariant->simulation.keep_dps_values = true;
+    kPairedVariant->player.Initialize(&kPairedVariant->simulation);
+    kPairedVariant->simulation.ClearResults();
+    const auto kEnd = std::chrono::high_resolution_clock::now();
+    kPairedVariant->simulation_duration = std::chrono::duration<double>(kEnd - kStart).count();
+    paired_variants.push_back(kPairedVariant);
+  }
+
+  const auto& kFirst = paired_variants[0]->simulation;
+  auto converged = false;
+
+  for (int first = 0; first < kSettings.iterations && !converged; first += Simulation::kConvergenceCheckInterval) {
+    const int kLast = std::min(first + Simulation::kConvergenceCheckInterval, kSettings.iterations);
+
+    for (const auto& kPairedVariant : paired_variants) {
+      const auto kStart = std::chrono::high_resolution_clock::now();
+      kPairedVariant->simulation.RunIterationRange(first, kLast);
+      const auto kEnd = std::chrono::high_resolution_clock::now();
+      kPairedVariant->simulation_duration += std::chrono::duration<double>(kEnd - kStart).count();
+    }
+
+    converged = paired_variants.size() > 1 || kFirst.HasConverged();
+
+    for (size_t i = 1; i < paired_variants.size(); i++) {
+      auto& differences = paired_variants[i]->differences;
+
+      for (int j = first; j < kLast; j++) {
+        differences.Add(paired_variants[i]->simulation.dps_values[j] - kFirst.dps_values[j]);
+      }
+
+      converged = converged && differences.StandardError() < kSettings.target_standard_error;
+    }
+  }
+
+  std::vector<SimulationVariantResult> results;
+
+  for (size_t i = 0; i < paired_variants.size(); i++) {
+    const auto& kPairedVariant = paired_variants[i];
+    kPairedVariant->simulation.SimulationEnd(static_cast<long long>(kPairedVariant->simulation_duration * 1000000));
+    results.push_back(
+        GetResult(variants[i].name, kPairedVariant->simulation, kPairedVariant->simulation_duration, true));
+  }
+
+  return results;
+}
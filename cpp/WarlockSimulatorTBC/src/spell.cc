@@ -1,12 +1,9 @@
-#include <utility>
-
 #include "../include/spell.h"
 
 #include "../include/entity.h"
 #include "../include/combat_log_breakdown.h"
 #include "../include/player.h"
 #include "../include/talents.h"
-#include "../include/common.h"
 #include "../include/aura.h"
 #include "../include/player_settings.h"
 #include "../include/on_resist_proc.h"
@@ -17,11 +14,12 @@
 #include "../include/on_damage_proc.h"
 #include "../include/on_hit_proc.h"
 #include "../include/aura_selection.h"
+#include "../include/profiling.h"
 
-Spell::Spell(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
+Spell::Spell(Entity& entity_param, Aura* aura, DamageOverTime* dot)
   : entity(entity_param),
-    aura_effect(std::move(aura)),
-    dot_effect(std::move(dot)) {
+    aura_effect(aura),
+    dot_effect(dot) {
 }
 
 void Spell::Setup() {
@@ -33,20 +31,21 @@ void Spell::Setup() {
     mana_gain = (min_mana_gain + max_mana_gain) / 2.0;
   }
 
-  if (entity.recording_combat_log_breakdown && !entity.combat_log_breakdown.contains(name)) {
-    entity.combat_log_breakdown.insert({name, std::make_shared<CombatLogBreakdown>(name)});
+  if (entity.recording_combat_log_breakdown) {
+    entity.AddCombatLogBreakdown(id, name);
   }
 
   if (entity.entity_type == EntityType::kPlayer && spell_type == SpellType::kDestruction) {
     mana_cost *= 1 - 0.01 * entity.player->talents.cataclysm;
   }
 
+  cooldown_timer.Register(entity, TimerType::kSpellCooldown, static_cast<int>(entity.spell_list.size()));
   entity.spell_list.push_back(this);
 }
 
 void Spell::Reset() {
   casting = false;
-  cooldown_remaining = 0;
+  cooldown_timer.Start(0);
   amount_of_casts_this_fight = 0;
 }
 
@@ -55,9 +54,9 @@ bool Spell::Ready() { return CanCast() && HasEnoughMana(); }
 bool Spell::HasEnoughMana() const { return GetManaCost() <= entity.stats.mana; }
 
 bool Spell::CanCast() {
-  return cooldown_remaining <= 0 &&
+  return cooldown_timer.Remaining() <= 0 &&
          (is_non_warlock_ability ||
-          (!on_gcd || entity.gcd_remaining <= 0) && (is_proc || entity.cast_time_remaining <= 0)) &&
+          (!on_gcd || entity.gcd_timer.Remaining() <= 0) && (is_proc || entity.cast_timer.Remaining() <= 0)) &&
          (!limited_amount_of_casts || amount_of_casts_this_fight < amount_of_casts_per_fight);
 }
 
@@ -65,21 +64,13 @@ double Spell::GetManaCost() const { return mana_cost * entity.stats.mana_cost_mo
 
 double Spell::GetCastTime() { return cast_time / entity.GetHastePercent(); }
 
-void Spell::Tick(const double kTime) {
-  if (cooldown_remaining > 0 && cooldown_remaining - kTime <= 0) {
-    if (name == SpellName::kPowerInfusion) {
-      entity.player->power_infusions_ready++;
-    }
-
-    if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(entity.name + "'s " + name + " off cooldown");
-    }
+void Spell::OnCooldownEnd() {
+  if (id == SpellId::kPowerInfusion) {
+    entity.player->power_infusions_ready++;
   }
 
-  cooldown_remaining -= kTime;
-
-  if (casting && entity.cast_time_remaining <= 0) {
-    Cast();
+  if (entity.ShouldWriteToCombatLog()) {
+    entity.CombatLog({.type = CombatLogEventType::kSpellOffCooldown, .id = id, .name = &name});
   }
 }
 
@@ -88,41 +79,33 @@ double Spell::GetCooldown() { return cooldown; }
 void Spell::Cast() {
   const double kCurrentMana = entity.stats.mana;
   const double kManaCost = GetManaCost();
-  cooldown_remaining = GetCooldown();
+  cooldown_timer.Start(GetCooldown());
   casting = false;
   amount_of_casts_this_fight++;
 
-  for (auto& spell_name : shared_cooldown_spells) {
-    for (const auto& kPlayerSpell : entity.spell_list) {
-      if (kPlayerSpell->name == spell_name) {
-        kPlayerSpell->cooldown_remaining = cooldown;
-      }
-    }
+  for (const int kSpellIndex : shared_cooldown_spell_indices) {
+    entity.spell_list[kSpellIndex]->cooldown_timer.Start(cooldown);
   }
 
-  if (name == SpellName::kPowerInfusion) {
+  if (id == SpellId::kPowerInfusion) {
     entity.player->power_infusions_ready--;
   }
 
   if (aura_effect == nullptr && entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->casts++;
+    entity.GetCombatLogBreakdown(id).casts++;
   }
 
   if (mana_cost > 0 && !entity.infinite_mana) {
     entity.stats.mana -= kManaCost;
-    entity.five_second_rule_timer_remaining = 5;
+    entity.five_second_rule_timer.Start(5);
   }
 
   if (cast_time > 0 && entity.ShouldWriteToCombatLog()) {
-    auto msg = entity.name + " finished casting " + name;
-    msg += " - Mana: " + DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana);
-    msg += " - Mana Cost: " + DoubleToString(round(kManaCost));
-
-    if (entity.entity_type == EntityType::kPlayer) {
-      msg += " - Mana Cost Modifier: " + DoubleToString(round(entity.stats.mana_cost_modifier * 100)) + "%";
-    }
-
-    entity.CombatLog(msg);
+    entity.CombatLog({.type = CombatLogEventType::kSpellFinishedCasting,
+                      .flags = entity.entity_type == EntityType::kPlayer ? CombatLogFlag::kPlayer : uint8_t{0},
+                      .id = id,
+                      .name = &name,
+                      .values = {kCurrentMana, entity.stats.mana, kManaCost, entity.stats.mana_cost_modifier}});
   }
 
   if (gain_mana_on_cast) {
@@ -139,12 +122,8 @@ void Spell::Cast() {
 }
 
 void Spell::Damage(const bool kIsCrit, const bool kIsGlancing) {
-  const std::vector<double> kConstantDamage = GetConstantDamage();
-  const double kBaseDamage = kConstantDamage[0];
-  auto total_damage = kConstantDamage[1];
-  const double kDamageModifier = kConstantDamage[2];
-  const double kPartialResistMultiplier = kConstantDamage[3];
-  const double kSpellPower = kConstantDamage[4];
+  const DamageBreakdown kConstantDamage = GetConstantDamage();
+  auto total_damage = kConstantDamage.damage;
   auto crit_multiplier = entity.kCritDamageMultiplier;
 
   if (kIsCrit) {
@@ -165,20 +144,20 @@ void Spell::Damage(const bool kIsCrit, const bool kIsGlancing) {
   entity.player->iteration_damage += total_damage;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_damage += total_damage;
+    entity.GetCombatLogBreakdown(id).iteration_damage += total_damage;
   }
 
   if (entity.ShouldWriteToCombatLog()) {
-    CombatLogDamage(kIsCrit, kIsGlancing, total_damage, kBaseDamage, kSpellPower, crit_multiplier, kDamageModifier,
-                    kPartialResistMultiplier);
+    CombatLogDamage(kIsCrit, kIsGlancing, total_damage, kConstantDamage.base_damage, kConstantDamage.spell_power,
+                    crit_multiplier, kConstantDamage.damage_modifier, kConstantDamage.partial_resist_multiplier);
   }
 
   // T5 4pc
   if (entity.entity_type == EntityType::kPlayer && entity.player->sets.t5 >= 4) {
-    if (name == SpellName::kShadowBolt && entity.player->auras.corruption != nullptr &&
+    if (id == SpellId::kShadowBolt && entity.player->auras.corruption != nullptr &&
         entity.player->auras.corruption->active) {
       entity.player->auras.corruption->t5_bonus_modifier *= 1.1;
-    } else if (name == SpellName::kIncinerate && entity.player->auras.immolate != nullptr &&
+    } else if (id == SpellId::kIncinerate && entity.player->auras.immolate != nullptr &&
                entity.player->auras.immolate->active) {
       entity.player->auras.immolate->t5_bonus_modifier *= 1.1;
     }
@@ -187,7 +166,7 @@ void Spell::Damage(const bool kIsCrit, const bool kIsGlancing) {
 
 // Returns the non-RNG Damage of the spell (basically just the base Damage +
 // spell power + Damage modifiers, no crit/miss etc.)
-std::vector<double> Spell::GetConstantDamage() {
+DamageBreakdown Spell::GetConstantDamage() {
   auto total_damage = GetBaseDamage();
   const double kBaseDamage = total_damage;
   const double kSpellPower = entity.GetSpellPower(true, spell_school);
@@ -195,7 +174,7 @@ std::vector<double> Spell::GetConstantDamage() {
   const double kPartialResistMultiplier = entity.GetPartialResistMultiplier(spell_school);
 
   // If casting Incinerate and Immolate is up, add the bonus Damage
-  if (name == SpellName::kIncinerate && entity.player->auras.immolate != nullptr &&
+  if (id == SpellId::kIncinerate && entity.player->auras.immolate != nullptr &&
       entity.player->auras.immolate->active) {
     if (entity.player->settings.randomize_values && bonus_damage_from_immolate_min > 0 &&
         bonus_damage_from_immolate_max > 0) {
@@ -219,7 +198,7 @@ std::vector<double> Spell::GetConstantDamage() {
     total_damage *= entity.pet->enemy_damage_reduction_from_armor;
   }
 
-  return std::vector{kBaseDamage, total_damage, kDamageModifier, kPartialResistMultiplier, kSpellPower};
+  return {kBaseDamage, total_damage, kSpellPower, kDamageModifier, kPartialResistMultiplier};
 }
 
 double Spell::GetCritMultiplier(const double kEntityCritMultiplier) const {
@@ -252,8 +231,8 @@ double Spell::GetBaseDamage() {
 }
 
 double Spell::PredictDamage() {
-  const std::vector<double> kConstantDamage = GetConstantDamage();
-  const double kNormalDamage = kConstantDamage[1];
+  CountProfilingEvent(ProfilingCounter::kPredictDamageCalls);
+  const double kNormalDamage = GetConstantDamage().damage;
   auto crit_damage = 0.0;
   auto crit_chance = 0.0;
   auto chance_to_not_crit = 0.0;
@@ -285,32 +264,32 @@ double Spell::PredictDamage() {
 }
 
 void Spell::OnCritProcs() {
-  for (const auto& kProc : entity.on_crit_procs) {
-    if (kProc->Ready() && kProc->ShouldProc(this) && entity.player->RollRng(kProc->proc_chance)) {
+  for (const auto& kProc : on_crit_procs) {
+    if (kProc->Ready() && entity.player->RollProc(kProc->proc_chance)) {
       kProc->StartCast();
     }
   }
 }
 
 void Spell::OnResistProcs() {
-  for (const auto& kProc : entity.on_resist_procs) {
-    if (kProc->Ready() && kProc->ShouldProc(this) && entity.player->RollRng(kProc->proc_chance)) {
+  for (const auto& kProc : on_resist_procs) {
+    if (kProc->Ready() && entity.player->RollProc(kProc->proc_chance)) {
       kProc->StartCast();
     }
   }
 }
 
 void Spell::OnDamageProcs() {
-  for (const auto& kProc : entity.on_damage_procs) {
-    if (kProc->Ready() && kProc->ShouldProc(this) && entity.player->RollRng(kProc->proc_chance)) {
+  for (const auto& kProc : on_damage_procs) {
+    if (kProc->Ready() && entity.player->RollProc(kProc->proc_chance)) {
       kProc->StartCast();
     }
   }
 }
 
 void Spell::OnHitProcs() {
-  for (const auto& kProc : entity.on_hit_procs) {
-    if (kProc->Ready() && kProc->ShouldProc(this) && entity.player->RollRng(kProc->proc_chance)) {
+  for (const auto& kProc : on_hit_procs) {
+    if (kProc->Ready() && entity.player->RollProc(kProc->proc_chance)) {
       kProc->StartCast();
     }
   }
@@ -319,45 +298,51 @@ void Spell::OnHitProcs() {
 void Spell::StartCast(const double kPredictedDamage) {
   if (on_gcd && !is_non_warlock_ability) {
     // Error: Casting a spell while GCD is active
-    if (entity.gcd_remaining > 0) {
+    if (entity.gcd_timer.Remaining() > 0) {
       entity.player->ThrowError(entity.name + " attempting to cast " + name + " while " + entity.name +
-                                "'s GCD is at " + std::to_string(entity.gcd_remaining) + " seconds remaining");
+                                "'s GCD is at " + std::to_string(entity.gcd_timer.Remaining()) + " seconds remaining");
     }
 
-    entity.gcd_remaining = entity.GetGcdValue();
+    // Nothing new can be cast before the cast finishes, so the end of the GCD only needs to wake the simulation up if
+    // the GCD outlasts the cast
+    const double kGcdValue = entity.GetGcdValue();
+    entity.gcd_timer.Start(kGcdValue, cast_time <= 0 || kGcdValue > GetCastTime());
   }
 
   // Error: Starting to Cast a spell while casting another spell
-  if (entity.cast_time_remaining > 0 && !is_non_warlock_ability && !is_proc) {
+  if (entity.cast_timer.Remaining() > 0 && !is_non_warlock_ability && !is_proc) {
     entity.player->ThrowError(entity.name + " attempting to cast " + name + " while " + entity.name +
-                              "'s cast time remaining is at " + std::to_string(entity.cast_time_remaining) + " sec");
+                              "'s cast time remaining is at " + std::to_string(entity.cast_timer.Remaining()) + " sec");
   }
 
   // Error: Casting a spell while it's on cooldown
-  if (cooldown > 0 && cooldown_remaining > 0) {
+  if (cooldown > 0 && cooldown_timer.Remaining() > 0) {
     entity.player->ThrowError(entity.name + " attempting to cast " + name + " while it's still on cooldown (" +
-                              std::to_string(cooldown_remaining) + " seconds remaining)");
+                              std::to_string(cooldown_timer.Remaining()) + " seconds remaining)");
   }
 
-  std::string combat_log_message;
+  // The cast's line in the combat log, which is only logged after an instant spell's own lines like its damage
+  auto event = CombatLogEvent{.type = CombatLogEventType::kSpellCast, .id = id, .name = &name};
   if (cast_time > 0) {
     casting = true;
-    entity.cast_time_remaining = GetCastTime();
+    // The entity hands the cast timer back to this spell once it runs out, see Entity::HandleTimer()
+    entity.cast_timer.index = cooldown_timer.index;
+    entity.cast_timer.Start(GetCastTime());
 
     if (!is_proc && entity.ShouldWriteToCombatLog()) {
-      combat_log_message.append(entity.name + " started casting " + name +
-                                " - Cast time: " + DoubleToString(entity.cast_time_remaining, 4) + " (" +
-                                DoubleToString((entity.GetHastePercent() - 1) * 100, 4) +
-                                "% haste at a base Cast speed of " + DoubleToString(cast_time, 2) + ")");
+      event.flags |= CombatLogFlag::kStartedCasting;
+      event.values[0] = entity.cast_timer.Remaining();
+      event.values[1] = entity.GetHastePercent();
+      event.values[2] = cast_time;
     }
   } else {
     if (!is_proc && entity.ShouldWriteToCombatLog()) {
-      combat_log_message.append(entity.name + " casts " + name);
+      event.flags |= CombatLogFlag::kCast;
 
-      if (name == SpellName::kMelee) {
-        combat_log_message.append(" - Attack Speed: " + DoubleToString(GetCooldown(), 2) + " (" +
-                                  DoubleToString(round(entity.GetHastePercent() * 10000) / 100.0 - 100, 4) +
-                                  "% haste at a base attack speed of " + DoubleToString(cooldown, 2) + ")");
+      if (id == SpellId::kMelee) {
+        event.values[0] = GetCooldown();
+        event.values[1] = entity.GetHastePercent();
+        event.values[2] = cooldown;
       }
     }
 
@@ -365,15 +350,17 @@ void Spell::StartCast(const double kPredictedDamage) {
   }
 
   if (on_gcd && !is_non_warlock_ability && entity.ShouldWriteToCombatLog()) {
-    combat_log_message.append(" - Global cooldown: " + DoubleToString(entity.gcd_remaining, 4));
+    event.flags |= CombatLogFlag::kGlobalCooldown;
+    event.values[3] = entity.gcd_timer.Remaining();
   }
 
   if (kPredictedDamage > 0 && entity.ShouldWriteToCombatLog()) {
-    combat_log_message.append(" - Estimated Damage / Cast time: " + DoubleToString(round(kPredictedDamage)));
+    event.flags |= CombatLogFlag::kPredictedDamage;
+    event.values[4] = kPredictedDamage;
   }
 
-  if (combat_log_message.length() > 0) {
-    entity.CombatLog(combat_log_message);
+  if (event.flags != 0) {
+    entity.CombatLog(event);
   }
 }
 
@@ -388,17 +375,17 @@ SpellCastResult Spell::MagicSpellCast() {
       // Increment the crit counter whether the spell hits or not so that the
       // crit % on the Damage breakdown is correct. Otherwise the crit % will be
       // lower due to lost crits when the spell misses.
-      entity.combat_log_breakdown.at(name)->crits++;
+      entity.GetCombatLogBreakdown(id).crits++;
     }
   }
 
   if (kIsResist) {
     if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(name + " *resist*");
+      entity.CombatLog({.type = CombatLogEventType::kSpellResist, .id = id, .name = &name});
     }
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->misses++;
+      entity.GetCombatLogBreakdown(id).misses++;
     }
 
     OnResistProcs();
@@ -412,58 +399,59 @@ SpellCastResult Spell::PhysicalSpellCast() const {
   auto is_glancing = false;
   auto is_miss = false;
   auto is_dodge = false;
-  const auto kCritChance = can_crit ? static_cast<int>((entity.GetMeleeCritChance() * entity.kFloatNumberMultiplier)) : 0;
-  const auto kDodgeChance =
-      kCritChance + static_cast<int>(StatConstant::kBaseEnemyDodgeChance * entity.kFloatNumberMultiplier);
-  const auto kMissChance =
-      kDodgeChance + static_cast<int>((100 - entity.stats.melee_hit_chance) * entity.kFloatNumberMultiplier);
+  // Cumulative chances in percent, turned into thresholds for the 32-bit roll
+  const auto kCritChance = can_crit ? entity.GetMeleeCritChance() : 0;
+  const auto kDodgeChance = kCritChance + StatConstant::kBaseEnemyDodgeChance;
+  const auto kMissChance = kDodgeChance + (100 - entity.stats.melee_hit_chance);
   auto glancing_chance = kMissChance;
 
   // Only check for a glancing if it's a normal melee attack
-  if (name == SpellName::kMelee) {
-    glancing_chance += static_cast<int>(entity.pet->glancing_blow_chance * entity.kFloatNumberMultiplier);
+  if (id == SpellId::kMelee) {
+    glancing_chance += entity.pet->glancing_blow_chance;
   }
 
   // Check whether the roll is a crit, dodge, miss, glancing, or just a normal hit.
 
+  const auto kAttackRoll = entity.player->rng.NextUint32();
+
   // Crit
-  if (const auto kAttackRoll = entity.player->GetRand(); can_crit && kAttackRoll <= kCritChance) {
+  if (can_crit && kAttackRoll < Rng::ChanceToThreshold(kCritChance)) {
     is_crit = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->crits++;
+      entity.GetCombatLogBreakdown(id).crits++;
     }
   }
   // Dodge
-  else if (kAttackRoll <= kDodgeChance) {
+  else if (kAttackRoll < Rng::ChanceToThreshold(kDodgeChance)) {
     is_dodge = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->dodge++;
+      entity.GetCombatLogBreakdown(id).dodge++;
     }
 
     if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(entity.name + " " + name + " *dodge*");
+      entity.CombatLog({.type = CombatLogEventType::kSpellDodge, .id = id, .name = &name});
     }
   }
   // Miss
-  else if (kAttackRoll <= kMissChance) {
+  else if (kAttackRoll < Rng::ChanceToThreshold(kMissChance)) {
     is_miss = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->misses++;
+      entity.GetCombatLogBreakdown(id).misses++;
     }
 
     if (entity.ShouldWriteToCombatLog()) {
-      entity.CombatLog(entity.name + " " + name + " *miss*");
+      entity.CombatLog({.type = CombatLogEventType::kSpellMiss, .id = id, .name = &name});
     }
   }
   // Glancing Blow
-  else if (kAttackRoll <= glancing_chance && name == SpellName::kMelee) {
+  else if (kAttackRoll < Rng::ChanceToThreshold(glancing_chance) && id == SpellId::kMelee) {
     is_glancing = true;
 
     if (entity.recording_combat_log_breakdown) {
-      entity.combat_log_breakdown.at(name)->glancing_blows++;
+      entity.GetCombatLogBreakdown(id).glancing_blows++;
     }
   }
 
@@ -483,7 +471,7 @@ void Spell::OnSpellHit(const SpellCastResult& kSpellCastResult) {
     Damage(kSpellCastResult.is_crit, kSpellCastResult.is_glancing);
   }
 
-  if (!is_item && !is_proc && !is_non_warlock_ability && name != SpellName::kAmplifyCurse) {
+  if (!is_item && !is_proc && !is_non_warlock_ability && id != SpellId::kAmplifyCurse) {
     OnHitProcs();
   }
 }
@@ -491,44 +479,30 @@ void Spell::OnSpellHit(const SpellCastResult& kSpellCastResult) {
 void Spell::CombatLogDamage(const bool kIsCrit, const bool kIsGlancing, const double kTotalDamage, const double kSpellBaseDamage,
                             const double kSpellPower, const double kCritMultiplier, const double kDamageModifier,
                             const double kPartialResistMultiplier) const {
-  auto msg = name + " ";
+  auto event = CombatLogEvent{.type = CombatLogEventType::kSpellDamage,
+                              .id = id,
+                              .name = &name,
+                              .values = {kTotalDamage, kSpellBaseDamage, coefficient, kSpellPower,
+                                         kPartialResistMultiplier, kCritMultiplier, kDamageModifier}};
 
   if (kIsCrit) {
-    msg += "*";
-  }
-
-  msg += DoubleToString(round(kTotalDamage));
-
-  if (kIsCrit) {
-    msg += "*";
+    event.flags |= CombatLogFlag::kCrit;
   }
 
   if (kIsGlancing) {
-    msg += " Glancing";
+    event.flags |= CombatLogFlag::kGlancing;
   }
 
-  msg += " (" + DoubleToString(kSpellBaseDamage, 1) + " Base Damage";
-
   if (attack_type == AttackType::kMagical) {
-    msg += " - " + DoubleToString(round(coefficient * 1000) / 1000, 3) + " Coefficient";
-    msg += " - " + DoubleToString(round(kSpellPower)) + " Spell Power";
-    msg += " - " + DoubleToString(round(kPartialResistMultiplier * 1000) / 10) + "% Partial Resist Multiplier)";
+    event.flags |= CombatLogFlag::kMagical;
   } else if (attack_type == AttackType::kPhysical) {
-    if (kIsGlancing) {
-      msg += " - " + DoubleToString(entity.pet->glancing_blow_multiplier * 100, 1) + "% Glancing Blow Multiplier";
-    }
-    msg += " - " + DoubleToString(round(entity.pet->GetAttackPower())) + " Attack Power";
-    msg += " - " + DoubleToString(round(entity.pet->enemy_damage_reduction_from_armor * 10000) / 100.0, 2) +
-        "% Damage Modifier (Armor)";
-  }
-
-  if (kIsCrit) {
-    msg += " - " + DoubleToString(kCritMultiplier * 100, 3) + "% Crit Multiplier";
+    event.flags |= CombatLogFlag::kPhysical;
+    event.values[7] = entity.pet->glancing_blow_multiplier;
+    event.values[8] = entity.pet->GetAttackPower();
+    event.values[9] = entity.pet->enemy_damage_reduction_from_armor;
   }
 
-  msg += " - " + DoubleToString(round(kDamageModifier * 10000) / 100, 2) + "% Damage Modifier";
-
-  entity.CombatLog(msg);
+  entity.CombatLog(event);
 }
 
 void Spell::ManaGainOnCast() const {
@@ -538,18 +512,21 @@ void Spell::ManaGainOnCast() const {
   const double kManaGained = entity.stats.mana - kCurrentMana;
 
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_mana_gain += kManaGained;
+    entity.GetCombatLogBreakdown(id).iteration_mana_gain += kManaGained;
   }
 
   if (entity.ShouldWriteToCombatLog()) {
-    entity.CombatLog("Player gains " + DoubleToString(kManaGained) + " mana from " + name + " (" +
-                     DoubleToString(kCurrentMana) + " -> " + DoubleToString(entity.stats.mana) + ")");
+    entity.CombatLog({.type = CombatLogEventType::kManaGain,
+                      .id = id,
+                      .name = &name,
+                      .values = {kManaGained, kCurrentMana, entity.stats.mana}});
   }
 }
 
 ShadowBolt::ShadowBolt(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kShadowBolt;
+  id = SpellId::kShadowBolt;
   cast_time = CalculateCastTime();
   mana_cost = 420;
   coefficient = 3 / 3.5 + 0.04 * entity_param.player->talents.shadow_and_flame;
@@ -584,6 +561,7 @@ double ShadowBolt::CalculateCastTime() const { return 3 - 0.1 * entity.player->t
 Incinerate::Incinerate(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kIncinerate;
+  id = SpellId::kIncinerate;
   cast_time = 2.5 * (1 - 0.02 * entity_param.player->talents.emberstorm);
   mana_cost = 355;
   coefficient = 2.5 / 3.5 + 0.04 * entity_param.player->talents.shadow_and_flame;
@@ -604,6 +582,7 @@ Incinerate::Incinerate(Entity& entity_param)
 SearingPain::SearingPain(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kSearingPain;
+  id = SpellId::kSearingPain;
   cast_time = 1.5;
   mana_cost = 205;
   coefficient = 1.5 / 3.5;
@@ -622,6 +601,7 @@ SearingPain::SearingPain(Entity& entity_param)
 SoulFire::SoulFire(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kSoulFire;
+  id = SpellId::kSoulFire;
   cast_time = 6 - 0.4 * entity_param.player->talents.bane;
   mana_cost = 250;
   coefficient = 1.15;
@@ -639,6 +619,7 @@ SoulFire::SoulFire(Entity& entity_param)
 Shadowburn::Shadowburn(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kShadowburn;
+  id = SpellId::kShadowburn;
   cooldown = 15;
   mana_cost = 515;
   coefficient = 0.22;
@@ -657,6 +638,7 @@ Shadowburn::Shadowburn(Entity& entity_param)
 DeathCoil::DeathCoil(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kDeathCoil;
+  id = SpellId::kDeathCoil;
   cooldown = 120;
   mana_cost = 600;
   coefficient = 0.4286;
@@ -673,6 +655,7 @@ DeathCoil::DeathCoil(Entity& entity_param)
 Shadowfury::Shadowfury(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kShadowfury;
+  id = SpellId::kShadowfury;
   cast_time = 0.5;
   mana_cost = 710;
   min_dmg = 612;
@@ -693,6 +676,7 @@ SeedOfCorruption::SeedOfCorruption(Entity& entity_param)
   : Spell(entity_param),
     aoe_cap(13580) {
   name = SpellName::kSeedOfCorruption;
+  id = SpellId::kSeedOfCorruption;
   min_dmg = 1110;
   max_dmg = 1290;
   mana_cost = 882;
@@ -800,30 +784,27 @@ void SeedOfCorruption::Damage(bool, bool) {
   entity.player->iteration_damage += total_seed_damage;
 
   if (entity.ShouldWriteToCombatLog()) {
-    auto msg = name + " " + DoubleToString(round(total_seed_damage)) + " (" + std::to_string(kEnemyAmount) +
-               " Enemies (" + std::to_string(resist_amount) + " Resists & " + std::to_string(crit_amount) +
-               " Crits) - " + DoubleToString(kBaseDamage, 1) + " Base Damage - " + DoubleToString(coefficient, 3) +
-               " Coefficient - " + DoubleToString(kSpellPower) + " Spell Power - " +
-               DoubleToString(round(internal_modifier * external_modifier * 1000) / 10, 1) + "% Modifier - ";
-    if (crit_amount > 0) {
-      msg += DoubleToString(crit_damage_multiplier, 3) + "% Crit Multiplier";
-    }
-    msg += " - " + DoubleToString(round(kPartialResistMultiplier * 1000) / 10) + "% Partial Resist Multiplier)";
-    entity.CombatLog(msg);
+    entity.CombatLog({.type = CombatLogEventType::kSeedOfCorruptionDamage,
+                      .id = id,
+                      .name = &name,
+                      .values = {total_seed_damage, 1.0 * kEnemyAmount, 1.0 * resist_amount, 1.0 * crit_amount,
+                                 kBaseDamage, coefficient, kSpellPower, internal_modifier * external_modifier,
+                                 crit_damage_multiplier, kPartialResistMultiplier}});
   }
   if (entity.recording_combat_log_breakdown) {
-    entity.combat_log_breakdown.at(name)->iteration_damage += total_seed_damage;
-    entity.combat_log_breakdown.at(name)->crits += crit_amount;
-    entity.combat_log_breakdown.at(name)->misses += resist_amount;
+    entity.GetCombatLogBreakdown(id).iteration_damage += total_seed_damage;
+    entity.GetCombatLogBreakdown(id).crits += crit_amount;
+    entity.GetCombatLogBreakdown(id).misses += resist_amount;
     // the Cast() function already adds 1 to the amount of casts so we only need
     // to add enemiesHit - 1 to the Cast amount
-    entity.combat_log_breakdown.at(name)->casts += kEnemiesHit - 1;
+    entity.GetCombatLogBreakdown(id).casts += kEnemiesHit - 1;
   }
 }
 
-Corruption::Corruption(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
-  : Spell(entity_param, std::move(aura), std::move(dot)) {
+Corruption::Corruption(Entity& entity_param, Aura* aura, DamageOverTime* dot)
+  : Spell(entity_param, aura, dot) {
   name = SpellName::kCorruption;
+  id = SpellId::kCorruption;
   mana_cost = 370;
   cast_time = 2 - 0.4 * entity_param.player->talents.improved_corruption;
   spell_school = SpellSchool::kShadow;
@@ -833,9 +814,10 @@ Corruption::Corruption(Entity& entity_param, std::shared_ptr<Aura> aura, std::sh
   Spell::Setup();
 }
 
-UnstableAffliction::UnstableAffliction(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
-  : Spell(entity_param, std::move(aura), std::move(dot)) {
+UnstableAffliction::UnstableAffliction(Entity& entity_param, Aura* aura, DamageOverTime* dot)
+  : Spell(entity_param, aura, dot) {
   name = SpellName::kUnstableAffliction;
+  id = SpellId::kUnstableAffliction;
   mana_cost = 400;
   cast_time = 1.5;
   spell_school = SpellSchool::kShadow;
@@ -845,9 +827,10 @@ UnstableAffliction::UnstableAffliction(Entity& entity_param, std::shared_ptr<Aur
   Spell::Setup();
 }
 
-SiphonLife::SiphonLife(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
-  : Spell(entity_param, std::move(aura), std::move(dot)) {
+SiphonLife::SiphonLife(Entity& entity_param, Aura* aura, DamageOverTime* dot)
+  : Spell(entity_param, aura, dot) {
   name = SpellName::kSiphonLife;
+  id = SpellId::kSiphonLife;
   mana_cost = 410;
   spell_school = SpellSchool::kShadow;
   spell_type = SpellType::kAffliction;
@@ -856,9 +839,10 @@ SiphonLife::SiphonLife(Entity& entity_param, std::shared_ptr<Aura> aura, std::sh
   Spell::Setup();
 }
 
-Immolate::Immolate(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
-  : Spell(entity_param, std::move(aura), std::move(dot)) {
+Immolate::Immolate(Entity& entity_param, Aura* aura, DamageOverTime* dot)
+  : Spell(entity_param, aura, dot) {
   name = SpellName::kImmolate;
+  id = SpellId::kImmolate;
   mana_cost = 445;
   cast_time = 2 - 0.1 * entity_param.player->talents.bane;
   does_damage = true;
@@ -872,9 +856,10 @@ Immolate::Immolate(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared
   Spell::Setup();
 }
 
-CurseOfAgony::CurseOfAgony(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
-  : Spell(entity_param, std::move(aura), std::move(dot)) {
+CurseOfAgony::CurseOfAgony(Entity& entity_param, Aura* aura, DamageOverTime* dot)
+  : Spell(entity_param, aura, dot) {
   name = SpellName::kCurseOfAgony;
+  id = SpellId::kCurseOfAgony;
   mana_cost = 265;
   spell_school = SpellSchool::kShadow;
   spell_type = SpellType::kAffliction;
@@ -883,9 +868,10 @@ CurseOfAgony::CurseOfAgony(Entity& entity_param, std::shared_ptr<Aura> aura, std
   Spell::Setup();
 }
 
-CurseOfTheElements::CurseOfTheElements(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+CurseOfTheElements::CurseOfTheElements(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kCurseOfTheElements;
+  id = SpellId::kCurseOfTheElements;
   mana_cost = 260;
   spell_type = SpellType::kAffliction;
   spell_school = SpellSchool::kShadow;
@@ -894,9 +880,10 @@ CurseOfTheElements::CurseOfTheElements(Entity& entity_param, std::shared_ptr<Aur
   Spell::Setup();
 }
 
-CurseOfRecklessness::CurseOfRecklessness(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+CurseOfRecklessness::CurseOfRecklessness(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kCurseOfRecklessness;
+  id = SpellId::kCurseOfRecklessness;
   mana_cost = 160;
   spell_type = SpellType::kAffliction;
   spell_school = SpellSchool::kShadow;
@@ -905,9 +892,10 @@ CurseOfRecklessness::CurseOfRecklessness(Entity& entity_param, std::shared_ptr<A
   Spell::Setup();
 }
 
-CurseOfDoom::CurseOfDoom(Entity& entity_param, std::shared_ptr<Aura> aura, std::shared_ptr<DamageOverTime> dot)
-  : Spell(entity_param, std::move(aura), std::move(dot)) {
+CurseOfDoom::CurseOfDoom(Entity& entity_param, Aura* aura, DamageOverTime* dot)
+  : Spell(entity_param, aura, dot) {
   name = SpellName::kCurseOfDoom;
+  id = SpellId::kCurseOfDoom;
   mana_cost = 380;
   cooldown = 60;
   spell_school = SpellSchool::kShadow;
@@ -920,6 +908,7 @@ CurseOfDoom::CurseOfDoom(Entity& entity_param, std::shared_ptr<Aura> aura, std::
 Conflagrate::Conflagrate(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kConflagrate;
+  id = SpellId::kConflagrate;
   mana_cost = 305;
   cooldown = 10;
   min_dmg = 579;
@@ -944,38 +933,42 @@ void Conflagrate::Cast() {
   entity.player->auras.immolate->Fade();
 }
 
-DestructionPotion::DestructionPotion(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+DestructionPotion::DestructionPotion(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kDestructionPotion;
+  id = SpellId::kDestructionPotion;
   cooldown = 120;
   is_item = true;
   on_gcd = false;
   Spell::Setup();
 }
 
-FlameCap::FlameCap(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+FlameCap::FlameCap(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kFlameCap;
+  id = SpellId::kFlameCap;
   cooldown = 180;
   is_item = true;
   on_gcd = false;
-  shared_cooldown_spells.push_back(SpellName::kChippedPowerCore);
-  shared_cooldown_spells.push_back(SpellName::kCrackedPowerCore);
+  shared_cooldown_spells.push_back(SpellId::kChippedPowerCore);
+  shared_cooldown_spells.push_back(SpellId::kCrackedPowerCore);
   Spell::Setup();
 }
 
-BloodFury::BloodFury(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+BloodFury::BloodFury(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kBloodFury;
+  id = SpellId::kBloodFury;
   cooldown = 120;
   on_gcd = false;
   is_item = true;  // TODO create some other property for spells like this instead of making them items
   Spell::Setup();
 }
 
-Bloodlust::Bloodlust(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+Bloodlust::Bloodlust(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kBloodlust;
+  id = SpellId::kBloodlust;
   cooldown = 600;
   is_item = true;
   on_gcd = false;
@@ -983,9 +976,10 @@ Bloodlust::Bloodlust(Entity& entity_param, std::shared_ptr<Aura> aura)
   Spell::Setup();
 }
 
-DrumsOfBattle::DrumsOfBattle(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+DrumsOfBattle::DrumsOfBattle(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kDrumsOfBattle;
+  id = SpellId::kDrumsOfBattle;
   cooldown = 120;
   on_gcd = false;
   is_non_warlock_ability = true;
@@ -993,9 +987,10 @@ DrumsOfBattle::DrumsOfBattle(Entity& entity_param, std::shared_ptr<Aura> aura)
   Spell::Setup();
 }
 
-DrumsOfWar::DrumsOfWar(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+DrumsOfWar::DrumsOfWar(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kDrumsOfWar;
+  id = SpellId::kDrumsOfWar;
   cooldown = 120;
   on_gcd = false;
   is_non_warlock_ability = true;
@@ -1003,9 +998,10 @@ DrumsOfWar::DrumsOfWar(Entity& entity_param, std::shared_ptr<Aura> aura)
   Spell::Setup();
 }
 
-DrumsOfRestoration::DrumsOfRestoration(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+DrumsOfRestoration::DrumsOfRestoration(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kDrumsOfRestoration;
+  id = SpellId::kDrumsOfRestoration;
   cooldown = 120;
   on_gcd = false;
   is_non_warlock_ability = true;
@@ -1013,61 +1009,67 @@ DrumsOfRestoration::DrumsOfRestoration(Entity& entity_param, std::shared_ptr<Aur
   Spell::Setup();
 }
 
-AmplifyCurse::AmplifyCurse(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+AmplifyCurse::AmplifyCurse(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kAmplifyCurse;
+  id = SpellId::kAmplifyCurse;
   cooldown = 180;
   on_gcd = false;
   Spell::Setup();
 }
 
-PowerInfusion::PowerInfusion(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+PowerInfusion::PowerInfusion(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kPowerInfusion;
+  id = SpellId::kPowerInfusion;
   cooldown = 180;
   on_gcd = false;
   is_non_warlock_ability = true;
   Spell::Setup();
 }
 
-Innervate::Innervate(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+Innervate::Innervate(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kInnervate;
+  id = SpellId::kInnervate;
   cooldown = 360;
   on_gcd = false;
   is_non_warlock_ability = true;
   Spell::Setup();
 }
 
-ChippedPowerCore::ChippedPowerCore(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+ChippedPowerCore::ChippedPowerCore(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kChippedPowerCore;
+  id = SpellId::kChippedPowerCore;
   cooldown = 120;
   on_gcd = false;
   is_item = true;
   limited_amount_of_casts = true;
   amount_of_casts_per_fight = entity_param.player->settings.chipped_power_core_amount;
   shared_cooldown_spells.insert(shared_cooldown_spells.end(),
-                                {SpellName::kDemonicRune, SpellName::kFlameCap, SpellName::kCrackedPowerCore});
+                                {SpellId::kDemonicRune, SpellId::kFlameCap, SpellId::kCrackedPowerCore});
   Spell::Setup();
 }
 
-CrackedPowerCore::CrackedPowerCore(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+CrackedPowerCore::CrackedPowerCore(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kCrackedPowerCore;
+  id = SpellId::kCrackedPowerCore;
   cooldown = 120;
   on_gcd = false;
   is_item = true;
   limited_amount_of_casts = true;
   amount_of_casts_per_fight = entity_param.player->settings.cracked_power_core_amount;
   shared_cooldown_spells.insert(shared_cooldown_spells.end(),
-                                {SpellName::kDemonicRune, SpellName::kFlameCap, SpellName::kChippedPowerCore});
+                                {SpellId::kDemonicRune, SpellId::kFlameCap, SpellId::kChippedPowerCore});
   Spell::Setup();
 }
 
-ManaTideTotem::ManaTideTotem(Entity& entity_param, std::shared_ptr<Aura> aura)
-  : Spell(entity_param, std::move(aura)) {
+ManaTideTotem::ManaTideTotem(Entity& entity_param, Aura* aura)
+  : Spell(entity_param, aura) {
   name = SpellName::kManaTideTotem;
+  id = SpellId::kManaTideTotem;
   cooldown = 300;
   is_non_warlock_ability = true;
   Spell::Setup();
@@ -1076,6 +1078,7 @@ ManaTideTotem::ManaTideTotem(Entity& entity_param, std::shared_ptr<Aura> aura)
 ImpFirebolt::ImpFirebolt(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kFirebolt;
+  id = SpellId::kFirebolt;
   cast_time = 2 - 0.25 * entity_param.player->talents.improved_firebolt;
   mana_cost = 145;
   base_damage = 119.5 * (1 + 0.1 * entity_param.player->talents.improved_imp);
@@ -1091,6 +1094,7 @@ ImpFirebolt::ImpFirebolt(Entity& entity_param)
 PetMelee::PetMelee(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kMelee;
+  id = SpellId::kMelee;
   attack_type = AttackType::kPhysical;
   cooldown = 2;
   on_gcd = false;
@@ -1107,6 +1111,7 @@ double PetMelee::GetCooldown() { return cooldown / entity.GetHastePercent(); }
 FelguardCleave::FelguardCleave(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kCleave;
+  id = SpellId::kCleave;
   cooldown = 6;
   mana_cost = 417;
   attack_type = AttackType::kPhysical;
@@ -1121,6 +1126,7 @@ double FelguardCleave::GetBaseDamage() { return entity.pet->spells.melee->GetBas
 SuccubusLashOfPain::SuccubusLashOfPain(Entity& entity_param)
   : Spell(entity_param) {
   name = SpellName::kLashOfPain;
+  id = SpellId::kLashOfPain;
   cooldown = 12 - 3 * entity_param.player->talents.improved_lash_of_pain;
   mana_cost = 190;
   base_damage = 123 * (1 + 0.1 * entity_param.player->talents.improved_succubus);
@@ -1,9 +1,7 @@
-#include <utility>
-
 #include "../include/spell_proc.h"
 
-SpellProc::SpellProc(Entity& entity, std::shared_ptr<Aura> aura)
-  : Spell(entity, std::move(aura)) {
+SpellProc::SpellProc(Entity& entity, Aura* aura)
+  : Spell(entity, aura) {
   is_proc = true;
   on_gcd = false;
 }
@@ -1,125 +1,134 @@
 #include "../include/stat.h"
 
-#include "../include/common.h"
+#include <algorithm>
+#include <array>
+
 #include "../include/entity.h"
 
-Stat::Stat(Entity& entity_param, double& character_stat, const double kValue)
+namespace {
+struct StatFieldInfo {
+  double CharacterStats::*character_stat;
+  CalculationType calculation_type;
+  const std::string& name;
+  int combat_log_decimal_places;
+};
+
+// Indexed by StatField
+const std::array<StatFieldInfo, 11> kStatFields = {{
+    {&CharacterStats::spell_power, CalculationType::kAdditive, StatName::kSpellPower, 0},
+    {&CharacterStats::shadow_power, CalculationType::kAdditive, StatName::kShadowPower, 0},
+    {&CharacterStats::fire_power, CalculationType::kAdditive, StatName::kFirePower, 0},
+    {&CharacterStats::spell_haste_rating, CalculationType::kAdditive, StatName::kSpellHasteRating, 0},
+    {&CharacterStats::spell_haste_percent, CalculationType::kMultiplicative, StatName::kSpellHastePercent, 4},
+    {&CharacterStats::melee_haste_percent, CalculationType::kMultiplicative, StatName::kMeleeHastePercent, 4},
+    {&CharacterStats::mana_cost_modifier, CalculationType::kMultiplicative, StatName::kManaCostModifier, 2},
+    {&CharacterStats::spell_crit_chance, CalculationType::kAdditive, StatName::kSpellCritChance, 2},
+    {&CharacterStats::spell_crit_rating, CalculationType::kAdditive, StatName::kSpellCritRating, 0},
+    {&CharacterStats::attack_power, CalculationType::kAdditive, StatName::kAttackPower, 0},
+    {&CharacterStats::attack_power_modifier, CalculationType::kMultiplicative, StatName::kAttackPowerModifier, 0},
+}};
+}
+
+Stat::Stat(Entity& entity_param, const StatField kField, const double kValue)
   : entity(entity_param),
-    character_stat(character_stat),
-    value(kValue) {
+    value(kValue),
+    field(kField) {
 }
 
-void Stat::AddStat() const { ModifyStat("add"); }
+void Stat::AddStat() const {
+  ModifyStat(false);
+  entity.stats_version++;
+}
 
-void Stat::RemoveStat(const int kStacks) const { ModifyStat("remove", kStacks); }
+void Stat::RemoveStat(const int kStacks) const {
+  ModifyStat(true, kStacks);
+  entity.stats_version++;
+}
 
-void Stat::ModifyStat(const std::string& kAction, const int kStacks) const {
+void Stat::ModifyStat(const bool kRemoving, const int kStacks) const {
+  const auto& kField = kStatFields[static_cast<int>(field)];
+  double& character_stat = entity.stats.*kField.character_stat;
   const double kCurrentStatValue = character_stat;
-  auto new_stat_value = kCurrentStatValue;
-
-  if (calculation_type == CalculationType::kAdditive) {
-    new_stat_value += value * kStacks * (kAction == "remove" ? -1 : kAction == "add" ? 1 : 0);
-  } else if (calculation_type == CalculationType::kMultiplicative) {
-    if (kAction == "add") {
-      new_stat_value *= value * kStacks;
-    } else if (kAction == "remove") {
-      new_stat_value /= value * kStacks;
-    }
-  }
+  const double kAmount = value * kStacks;
 
-  character_stat = new_stat_value;
+  if (kField.calculation_type == CalculationType::kAdditive) {
+    character_stat = kRemoving ? kCurrentStatValue - kAmount : kCurrentStatValue + kAmount;
+  } else {
+    character_stat = kRemoving ? kCurrentStatValue / kAmount : kCurrentStatValue * kAmount;
+  }
 
   if (entity.ShouldWriteToCombatLog()) {
-    auto msg = entity.name + " " + name + " ";
-
-    if (kAction == "add") {
-      if (calculation_type == CalculationType::kAdditive) {
-        msg += "+";
-      } else {
-        msg += "*";
-      }
-    } else {
-      if (calculation_type == CalculationType::kAdditive) {
-        msg += "-";
-      } else {
-        msg += "/";
-      }
+    uint8_t flags = kRemoving ? CombatLogFlag::kRemoving : 0;
+
+    if (kField.calculation_type == CalculationType::kMultiplicative) {
+      flags |= CombatLogFlag::kMultiplicative;
     }
 
-    msg += " " + DoubleToString(value * kStacks, combat_log_decimal_places) + " (" +
-        DoubleToString(kCurrentStatValue, combat_log_decimal_places) + " -> " +
-        DoubleToString(new_stat_value, combat_log_decimal_places) + ")";
+    entity.CombatLog({.type = CombatLogEventType::kStatChanged,
+                      .flags = flags,
+                      .name = &kField.name,
+                      .values = {kAmount, kCurrentStatValue, character_stat, 1.0 * kField.combat_log_decimal_places}});
+  }
+}
+
+void Stat::ModifyStats(const std::vector<Stat>& kStats, const bool kRemoving, const int kStacks) {
+  for (const auto& kStat : kStats) {
+    kStat.ModifyStat(kRemoving, kStacks);
+  }
 
-    entity.CombatLog(msg);
+  // The whole list is one change, so every entity it modifies only gets a new version once
+  for (size_t i = 0; i < kStats.size(); i++) {
+    if (std::none_of(kStats.begin(), kStats.begin() + i,
+                     [&](const Stat& kOther) { return &kOther.entity == &kStats[i].entity; })) {
+      kStats[i].entity.stats_version++;
+    }
   }
 }
 
+void AddStats(const std::vector<Stat>& kStats) { Stat::ModifyStats(kStats, false); }
+
+void RemoveStats(const std::vector<Stat>& kStats, const int kStacks) { Stat::ModifyStats(kStats, true, kStacks); }
+
 SpellPower::SpellPower(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.spell_power, kValue) {
-  name = StatName::kSpellPower;
-  calculation_type = CalculationType::kAdditive;
+  : Stat(entity_param, StatField::kSpellPower, kValue) {
 }
 
 ShadowPower::ShadowPower(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.shadow_power, kValue) {
-  name = StatName::kShadowPower;
-  calculation_type = CalculationType::kAdditive;
+  : Stat(entity_param, StatField::kShadowPower, kValue) {
 }
 
 FirePower::FirePower(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.fire_power, kValue) {
-  name = StatName::kFirePower;
-  calculation_type = CalculationType::kAdditive;
+  : Stat(entity_param, StatField::kFirePower, kValue) {
 }
 
 SpellHasteRating::SpellHasteRating(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.spell_haste_rating, kValue) {
-  name = StatName::kSpellHasteRating;
-  calculation_type = CalculationType::kAdditive;
+  : Stat(entity_param, StatField::kSpellHasteRating, kValue) {
 }
 
 SpellHastePercent::SpellHastePercent(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.spell_haste_percent, kValue) {
-  name = StatName::kSpellHastePercent;
-  calculation_type = CalculationType::kMultiplicative;
-  combat_log_decimal_places = 4;
+  : Stat(entity_param, StatField::kSpellHastePercent, kValue) {
 }
 
 MeleeHastePercent::MeleeHastePercent(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.melee_haste_percent, kValue) {
-  name = StatName::kMeleeHastePercent;
-  calculation_type = CalculationType::kMultiplicative;
-  combat_log_decimal_places = 4;
+  : Stat(entity_param, StatField::kMeleeHastePercent, kValue) {
 }
 
 ManaCostModifier::ManaCostModifier(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.mana_cost_modifier, kValue) {
-  name = StatName::kManaCostModifier;
-  calculation_type = CalculationType::kMultiplicative;
-  combat_log_decimal_places = 2;
+  : Stat(entity_param, StatField::kManaCostModifier, kValue) {
 }
 
 SpellCritChance::SpellCritChance(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.spell_crit_chance, kValue) {
-  name = StatName::kSpellCritChance;
-  calculation_type = CalculationType::kAdditive;
-  combat_log_decimal_places = 2;
+  : Stat(entity_param, StatField::kSpellCritChance, kValue) {
 }
 
 SpellCritRating::SpellCritRating(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.spell_crit_rating, kValue) {
-  name = StatName::kSpellCritRating;
-  calculation_type = CalculationType::kAdditive;
+  : Stat(entity_param, StatField::kSpellCritRating, kValue) {
 }
 
 AttackPower::AttackPower(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.attack_power, kValue) {
-  name = StatName::kAttackPower;
-  calculation_type = CalculationType::kAdditive;
+  : Stat(entity_param, StatField::kAttackPower, kValue) {
 }
 
 AttackPowerModifier::AttackPowerModifier(Entity& entity_param, const double kValue)
-  : Stat(entity_param, entity_param.stats.attack_power_modifier, kValue) {
-  name = StatName::kAttackPowerModifier;
-  calculation_type = CalculationType::kMultiplicative;
-}
\ No newline at end of file
+  : Stat(entity_param, StatField::kAttackPowerModifier, kValue) {
+}
@@ -0,0 +1,91 @@
+#include "../include/stat_weights.h"
+
+#include <cmath>
+#include <string>
+
+#include "../include/character_stats.h"
+#include "../include/dps_statistics.h"
+#include "../include/enums.h"
+#include "../include/player.h"
+#include "../include/player_settings.h"
+#include "../include/simulation_batch.h"
+#include "../include/simulation_settings.h"
+#include "../include/stat.h"
+#include "../include/trinket.h"
+
+namespace {
+// Two-sided 95% quantile of the normal distribution
+constexpr double kConfidenceIntervalZScore = 1.96;
+
+struct WeightedStat {
+  EmbindConstant stat;
+  std::string name;
+  double CharacterStats::* field;
+};
+
+const std::vector<WeightedStat> kWeightedStats = {
+    {EmbindConstant::kStamina, "stamina", &CharacterStats::stamina},
+    {EmbindConstant::kIntellect, "intellect", &CharacterStats::intellect},
+    {EmbindConstant::kSpirit, "spirit", &CharacterStats::spirit},
+    {EmbindConstant::kSpellPower, "spellPower", &CharacterStats::spell_power},
+    {EmbindConstant::kShadowPower, "shadowPower", &CharacterStats::shadow_power},
+    {EmbindConstant::kFirePower, "firePower", &CharacterStats::fire_power},
+    {EmbindConstant::kHitRating, "hitRating", &CharacterStats::spell_hit_rating},
+    {EmbindConstant::kCritRating, "critRating", &CharacterStats::spell_crit_rating},
+    {EmbindConstant::kHasteRating, "hasteRating", &CharacterStats::spell_haste_rating},
+    {EmbindConstant::kMp5, "mp5", &CharacterStats::mp5}
+};
+}
+
+std::vector<StatWeight> CalculateStatWeights(PlayerSettings& settings, const SimulationSettings& kSimulationSettings,
+                                             const double kAmount) {
+  auto base_variant = SimulationVariant();
+  base_variant.name = "normal";
+  base_variant.items = settings.items;
+  base_variant.talents = settings.talents;
+  base_variant.stats = settings.stats;
+  base_variant.item_id = settings.item_id;
+
+  // If the player isn't hit capped but the extra hit rating would put them over the cap then remove hit rating instead
+  // so that none of it is wasted (same as the web version). 15.99 is used instead of 16 so that e.g. 15.995% hit, which
+  // is shown as 16%, isn't treated as not being hit capped.
+  const double kHitPercent = Player(settings).stats.extra_spell_hit_chance;
+  const bool kRemoveHitRating = kHitPercent <= 15.99 &&
+                                kHitPercent + kAmount / StatConstant::kHitRatingPerPercent > StatConstant::kHitPercentCap;
+
+  auto batch = SimulationBatch(settings, kSimulationSettings);
+  batch.keep_dps_values = true;
+  std::vector<double> amounts;
+  batch.AddVariant(base_variant);
+
+  for (const auto& kWeightedStat : kWeightedStats) {
+    const double kStatAmount =
+        kWeightedStat.stat == EmbindConstant::kHitRating && kRemoveHitRating ? -kAmount : kAmount;
+    auto variant = base_variant;
+    variant.name = kWeightedStat.name;
+    variant.custom_stat = kWeightedStat.stat;
+    variant.stats.*kWeightedStat.field += kStatAmount;
+    batch.AddVariant(variant);
+    amounts.push_back(kStatAmount);
+  }
+
+  const auto kResults = batch.Start();
+  const auto& kBaseDps = kResults[0].dps_values;
+  std::vector<StatWeight> weights;
+
+  for (size_t i = 0; i < kWeightedStats.size(); i++) {
+    const auto& kStatDps = kResults[i + 1].dps_values;
+    // Mean and variance of the paired per-iteration differences
+    auto differences = RunningMeanVariance();
+    for (size_t j = 0; j < kBaseDps.size(); j++) {
+      differences.Add(kStatDps[j] - kBaseDps[j]);
+    }
+
+    weights.push_back({kWeightedStats[i].stat, kWeightedStats[i].name, amounts[i], differences.mean,
+                       differences.mean / amounts[i],
+                       kConfidenceIntervalZScore * differences.StandardError() / std::abs(amounts[i]),
+                       differences.count});
+  }
+
+  return weights;
+}
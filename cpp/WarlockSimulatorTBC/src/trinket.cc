@@ -11,66 +11,63 @@ Trinket::Trinket(Player& player)
   : player(player) {
 }
 
-bool Trinket::Ready() const { return cooldown_remaining <= 0; }
+bool Trinket::Ready() const { return cooldown_timer.Remaining() <= 0; }
 
-void Trinket::Reset() { cooldown_remaining = 0; }
+void Trinket::Reset() { cooldown_timer.Start(0); }
 
+// The trinket is added to the player's trinkets right after it's constructed
 void Trinket::Setup() {
-  if (player.recording_combat_log_breakdown && !player.combat_log_breakdown.contains(name)) {
-    player.combat_log_breakdown.insert({name, std::make_shared<CombatLogBreakdown>(name)});
+  duration_timer.Register(player, TimerType::kTrinketDuration, static_cast<int>(player.trinkets.size()));
+  cooldown_timer.Register(player, TimerType::kTrinketCooldown, static_cast<int>(player.trinkets.size()));
+
+  if (player.recording_combat_log_breakdown) {
+    player.AddCombatLogBreakdown(id, name);
   }
 }
 
 void Trinket::Use() {
   if (player.ShouldWriteToCombatLog()) {
-    player.CombatLog(name + " used");
+    player.CombatLog({.type = CombatLogEventType::kTrinketUsed, .name = &name});
   }
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->applied_at = player.simulation->current_fight_time;
-    player.combat_log_breakdown.at(name)->count++;
+    player.GetCombatLogBreakdown(id).applied_at = player.simulation->GetCurrentFightTime();
+    player.GetCombatLogBreakdown(id).count++;
   }
 
-  for (auto& stat : stats) {
-    stat.AddStat();
-  }
+  AddStats(stats);
 
   active = true;
-  duration_remaining = duration;
-  cooldown_remaining = cooldown;
+  duration_timer.Start(duration);
+  cooldown_timer.Start(cooldown);
 }
 
 void Trinket::Fade() {
   if (player.ShouldWriteToCombatLog()) {
-    player.CombatLog(name + " faded");
+    player.CombatLog({.type = CombatLogEventType::kTrinketFaded, .name = &name});
   }
 
   if (player.recording_combat_log_breakdown) {
-    player.combat_log_breakdown.at(name)->uptime +=
-        player.simulation->current_fight_time - player.combat_log_breakdown.at(name)->applied_at;
+    player.GetCombatLogBreakdown(id).uptime +=
+        player.simulation->GetCurrentFightTime() - player.GetCombatLogBreakdown(id).applied_at;
   }
 
-  for (auto& stat : stats) {
-    stat.RemoveStat();
-  }
+  RemoveStats(stats);
 
+  duration_timer.Stop();
   active = false;
 }
 
-void Trinket::Tick(const double kTime) {
-  if (player.ShouldWriteToCombatLog() && cooldown_remaining > 0 && cooldown_remaining - kTime <= 0) {
-    player.CombatLog(name + " off cooldown");
-  }
-  cooldown_remaining -= kTime;
-  duration_remaining -= kTime;
-  if (active && duration_remaining <= 0) {
-    Fade();
+void Trinket::OnCooldownEnd() const {
+  if (player.ShouldWriteToCombatLog()) {
+    player.CombatLog({.type = CombatLogEventType::kTrinketOffCooldown, .name = &name});
   }
 }
 
 RestrainedEssenceOfSapphiron::RestrainedEssenceOfSapphiron(Player& player)
   : Trinket(player) {
-  name = "The Restrained Essence of Sapphiron";
+  name = SpellName::kRestrainedEssenceOfSapphiron;
+  id = SpellId::kRestrainedEssenceOfSapphiron;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellPower(player, 130));
@@ -79,7 +76,8 @@ RestrainedEssenceOfSapphiron::RestrainedEssenceOfSapphiron(Player& player)
 
 ShiftingNaaruSliver::ShiftingNaaruSliver(Player& player)
   : Trinket(player) {
-  name = "Shifting Naaru Sliver";
+  name = SpellName::kShiftingNaaruSliver;
+  id = SpellId::kShiftingNaaruSliver;
   cooldown = 90;
   duration = 15;
   stats.push_back(SpellPower(player, 320));
@@ -88,7 +86,8 @@ ShiftingNaaruSliver::ShiftingNaaruSliver(Player& player)
 
 SkullOfGuldan::SkullOfGuldan(Player& player)
   : Trinket(player) {
-  name = "The Skull of Gul'dan";
+  name = SpellName::kSkullOfGuldan;
+  id = SpellId::kSkullOfGuldan;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellHasteRating(player, 175));
@@ -97,7 +96,8 @@ SkullOfGuldan::SkullOfGuldan(Player& player)
 
 HexShrunkenHead::HexShrunkenHead(Player& player)
   : Trinket(player) {
-  name = "Hex Shrunken Head";
+  name = SpellName::kHexShrunkenHead;
+  id = SpellId::kHexShrunkenHead;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellPower(player, 211));
@@ -106,7 +106,8 @@ HexShrunkenHead::HexShrunkenHead(Player& player)
 
 IconOfTheSilverCrescent::IconOfTheSilverCrescent(Player& player)
   : Trinket(player) {
-  name = "Icon of the Silver Crescent";
+  name = SpellName::kIconOfTheSilverCrescent;
+  id = SpellId::kIconOfTheSilverCrescent;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellPower(player, 155));
@@ -115,7 +116,8 @@ IconOfTheSilverCrescent::IconOfTheSilverCrescent(Player& player)
 
 ScryersBloodgem::ScryersBloodgem(Player& player)
   : Trinket(player) {
-  name = "Scryer's Bloodgem";
+  name = SpellName::kScryersBloodgem;
+  id = SpellId::kScryersBloodgem;
   cooldown = 90;
   duration = 15;
   stats.push_back(SpellPower(player, 150));
@@ -124,7 +126,8 @@ ScryersBloodgem::ScryersBloodgem(Player& player)
 
 AncientCrystalTalisman::AncientCrystalTalisman(Player& player)
   : Trinket(player) {
-  name = "Ancient Crystal Talisman";
+  name = SpellName::kAncientCrystalTalisman;
+  id = SpellId::kAncientCrystalTalisman;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellPower(player, 104));
@@ -133,7 +136,8 @@ AncientCrystalTalisman::AncientCrystalTalisman(Player& player)
 
 ArcanistsStone::ArcanistsStone(Player& player)
   : Trinket(player) {
-  name = "Arcanist's Stone";
+  name = SpellName::kArcanistsStone;
+  id = SpellId::kArcanistsStone;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellPower(player, 167));
@@ -142,7 +146,8 @@ ArcanistsStone::ArcanistsStone(Player& player)
 
 TerokkarTabletOfVim::TerokkarTabletOfVim(Player& player)
   : Trinket(player) {
-  name = "Terokkar Table of Vim";
+  name = SpellName::kTerokkarTabletOfVim;
+  id = SpellId::kTerokkarTabletOfVim;
   cooldown = 90;
   duration = 15;
   stats.push_back(SpellPower(player, 84));
@@ -151,7 +156,8 @@ TerokkarTabletOfVim::TerokkarTabletOfVim(Player& player)
 
 XirisGift::XirisGift(Player& player)
   : Trinket(player) {
-  name = "Xi'ri's Gift";
+  name = SpellName::kXirisGift;
+  id = SpellId::kXirisGift;
   cooldown = 90;
   duration = 15;
   stats.push_back(SpellPower(player, 150));
@@ -160,7 +166,8 @@ XirisGift::XirisGift(Player& player)
 
 VengeanceOfTheIllidari::VengeanceOfTheIllidari(Player& player)
   : Trinket(player) {
-  name = "Vengeance of the Illidari";
+  name = SpellName::kVengeanceOfTheIllidari;
+  id = SpellId::kVengeanceOfTheIllidari;
   cooldown = 90;
   duration = 15;
   stats.push_back(SpellPower(player, 120));
@@ -169,7 +176,8 @@ VengeanceOfTheIllidari::VengeanceOfTheIllidari(Player& player)
 
 FigurineLivingRubySerpent::FigurineLivingRubySerpent(Player& player)
   : Trinket(player) {
-  name = "Figurine: Living Ruby Serpent";
+  name = SpellName::kFigurineLivingRubySerpent;
+  id = SpellId::kFigurineLivingRubySerpent;
   cooldown = 300;
   duration = 20;
   stats.push_back(SpellPower(player, 150));
@@ -178,7 +186,8 @@ FigurineLivingRubySerpent::FigurineLivingRubySerpent(Player& player)
 
 EssenceOfTheMartyr::EssenceOfTheMartyr(Player& player)
   : Trinket(player) {
-  name = "Essence of the Martyr";
+  name = SpellName::kEssenceOfTheMartyr;
+  id = SpellId::kEssenceOfTheMartyr;
   cooldown = 120;
   duration = 20;
   shares_cooldown = false;
@@ -188,7 +197,8 @@ EssenceOfTheMartyr::EssenceOfTheMartyr(Player& player)
 
 StarkillersBauble::StarkillersBauble(Player& player)
   : Trinket(player) {
-  name = "Starkiller's Bauble";
+  name = SpellName::kStarkillersBauble;
+  id = SpellId::kStarkillersBauble;
   cooldown = 90;
   duration = 15;
   stats.push_back(SpellPower(player, 125));
@@ -197,7 +207,8 @@ StarkillersBauble::StarkillersBauble(Player& player)
 
 DarkIronSmokingPipe::DarkIronSmokingPipe(Player& player)
   : Trinket(player) {
-  name = "Dark Iron Smoking Pipe";
+  name = SpellName::kDarkIronSmokingPipe;
+  id = SpellId::kDarkIronSmokingPipe;
   cooldown = 120;
   duration = 20;
   stats.push_back(SpellPower(player, 155));
@@ -206,7 +217,8 @@ DarkIronSmokingPipe::DarkIronSmokingPipe(Player& player)
 
 HazzarahsCharmOfDestruction::HazzarahsCharmOfDestruction(Player& player)
   : Trinket(player) {
-  name = "Hazza'rah's Charm of Destruction";
+  name = SpellName::kHazzarahsCharmOfDestruction;
+  id = SpellId::kHazzarahsCharmOfDestruction;
   cooldown = 180;
   duration = 20;
   stats.push_back(SpellCritRating(player, 140));
@@ -1,142 +1,213 @@
-#include "../include/aura_selection.h"
-#include "../include/bindings.h"
-#include "../include/character_stats.h"
-#include "../include/items.h"
-#include "../include/player.h"
-#include "../include/player_settings.h"
-#include "../include/sets.h"
-#include "../include/simulation.h"
+// warlock_sim: runs the simulation natively from a plain-text profile (see profile.h) and prints the results as JSON,
+// one line for the base profile followed by one line per variant in the profile.
+//
+// Usage: warlock_sim [--iterations N] [--threads N] [--seed N] [--rng ENGINE] [--target-error X] [--stat-weights]
+//                    [--trace FILE] [profile]
+//
+// The profile is read from stdin if no path (or "-") is given. The command line options override the values from the
+// profile's [simulation] section. With --stat-weights (or "simulationType = statWeights") one line per stat is printed
+// instead, see stat_weights.h. --rng picks the random number engine (xoshiro256PlusPlus by default, mersenneTwister,
+// pcg32 or philox), the same as "rngEngine" in the profile. --target-error stops the simulation once the standard error
+// of the mean dps (of the stats' mean dps differences with --stat-weights) is below X, with --iterations as the most
+// that are run, the same as "targetStandardError" in the profile. --trace writes the iterations in the combat log (see
+// "combatLogFirstIteration", "combatLogIterations" and "combatLogIterationInterval") to FILE as a Chrome trace, see
+// chrome_trace.h. Everything except the results (e.g. the combat log) is written to stderr. When built with profiling
+// (make native PROFILING=1) every result also has a "profiling" object with the counters from profiling.h.
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../include/common.h"
+#include "../include/profile.h"
+#include "../include/profiling.h"
+#include "../include/simulation_batch.h"
 #include "../include/simulation_settings.h"
-#include "../include/talents.h"
-#include "../include/trinket.h"
-#include "../include/stat.h"
-
-int main() {
-  auto auras = AuraSelection();
-  auras.fel_armor = true;
-  auras.mana_spring_totem = true;
-  auras.wrath_of_air_totem = true;
-  auras.totem_of_wrath = true;
-  auras.mark_of_the_wild = true;
-  auras.prayer_of_spirit = true;
-  auras.inspiring_presence = true;
-  auras.moonkin_aura = true;
-  auras.eye_of_the_night = true;
-  auras.chain_of_the_twilight_owl = true;
-  auras.drums_of_battle = true;
-  auras.bloodlust = true;
-  auras.curse_of_the_elements = true;
-  auras.shadow_weaving = true;
-  auras.misery = true;
-  auras.judgement_of_wisdom = true;
-  auras.judgement_of_the_crusader = true;
-  auras.super_mana_potion = true;
-  auras.demonic_rune = true;
-
-  auto talents = Talents();
-  talents.demonic_embrace = 5;
-  talents.fel_intellect = 3;
-  talents.fel_stamina = 3;
-  talents.demonic_aegis = 3;
-  talents.demonic_sacrifice = 1;
-  talents.improved_shadow_bolt = 5;
-  talents.bane = 5;
-  talents.devastation = 5;
-  talents.improved_immolate = 5;
-  talents.ruin = 1;
-  talents.emberstorm = 5;
-  talents.backlash = 3;
-  talents.shadow_and_flame = 5;
-
-  auto sets = Sets();
-  sets.t6 = 4;
-
-  auto stats = CharacterStats();
-  stats.health = 3310;
-  stats.mana = 2335;
-  stats.stamina = 786;
-  stats.intellect = 516;
-  stats.spirit = 247;
-  stats.spell_power = 1451;
-  stats.shadow_power = 134;
-  stats.fire_power = 80;
-  stats.spell_haste_rating = 227;
-  stats.spell_hit_rating = 163;
-  stats.spell_crit_rating = 316;
-  stats.spell_crit_chance = 0;
-  stats.mp5 = 50;
-  stats.mana_cost_modifier = 1;
-  stats.spell_penetration = 88;
-  stats.fire_modifier = 1.2075;
-  stats.shadow_modifier = 1.155;
-  stats.stamina_modifier = 1.1;
-  stats.intellect_modifier = 1.155;
-  stats.spirit_modifier = 1.1;
-
-  auto items = Items();
-  items.head = 31051;
-  items.neck = 32349;
-  items.shoulders = 31054;
-  items.back = 32331;
-  items.chest = 30107;
-  items.bracers = 32586;
-  items.gloves = 31050;
-  items.belt = 32256;
-  items.legs = 31053;
-  items.boots = 32239;
-  items.ring_1 = 32527;
-  items.ring_2 = 32527;
-  items.trinket_1 = 32483;
-  items.trinket_2 = 27683;
-  items.two_hand = 32374;
-  items.wand = 29982;
-
-  auto iterations = 1000;
-  auto player_settings = PlayerSettings(auras, talents, sets, stats, items);
-  player_settings.equipped_item_simulation = true;
-  player_settings.random_seeds = AllocRandomSeeds(iterations);
-  player_settings.shattrath_faction = EmbindConstant::kAldor;
-  player_settings.selected_pet = EmbindConstant::kFelhunter;
-  player_settings.fight_type = EmbindConstant::kSingleTarget;
-  player_settings.enemy_amount = 15;
-  player_settings.race = EmbindConstant::kGnome;
-  player_settings.rotation_option = EmbindConstant::kSimChooses;
-  player_settings.meta_gem_id = 34220;
-  player_settings.recording_combat_log_breakdown = true;
-  player_settings.enemy_level = 73;
-  player_settings.totem_of_wrath_amount = 1;
-  player_settings.sacrificing_pet = true;
-  player_settings.improved_curse_of_the_elements = 3;
-  player_settings.using_custom_isb_uptime = true;
-  player_settings.custom_isb_uptime_value = 70;
-  player_settings.improved_divine_spirit = 2;
-  player_settings.bloodlust_amount = 1;
-  player_settings.infinite_player_mana = false;
-  player_settings.exalted_with_shattrath_faction = true;
-  player_settings.has_curse_of_doom = true;
-  player_settings.prepop_black_book = false;
-  player_settings.pet_mode = EmbindConstant::kAggressive;
-  player_settings.lash_of_pain_usage = EmbindConstant::kOnCooldown;
-  player_settings.enemy_armor = 7700;
-  player_settings.power_infusion_amount = 1;
-  player_settings.innervate_amount = 1;
-  player_settings.mage_atiesh_amount = 1;
-  player_settings.warlock_atiesh_amount = 1;
-  player_settings.ferocious_inspiration_amount = 1;
-  player_settings.shadow_priest_dps = 1000;
-  player_settings.battle_squawk_amount = 1;
-  player_settings.improved_faerie_fire = true;
-  player_settings.improved_expose_armor = 2;
-  player_settings.survival_hunter_agility = 800;
-  player_settings.expose_weakness_uptime = 70;
-
-  auto player = Player(player_settings);
-  auto simulation_settings = SimulationSettings();
-  simulation_settings.iterations = iterations;
-  simulation_settings.min_time = 150;
-  simulation_settings.max_time = 210;
-  simulation_settings.simulation_type = SimulationType::kNormal;
-
-  auto simulation = Simulation(player, simulation_settings);
-  simulation.Start();
-}
\ No newline at end of file
+#include "../include/stat_weights.h"
+
+namespace {
+std::string EscapeJson(const std::string& kString) {
+  std::string escaped;
+
+  for (const char kCharacter : kString) {
+    if (kCharacter == '"' || kCharacter == '\\') {
+      escaped += '\\';
+    }
+
+    escaped += kCharacter;
+  }
+
+  return escaped;
+}
+
+void PrintUsage() {
+  std::cerr << "Usage: warlock_sim [--iterations N] [--threads N] [--seed N] [--rng ENGINE] [--target-error X]"
+      << " [--stat-weights] [--trace FILE] [profile]" << std::endl
+      << "Reads the profile from stdin if no path (or '-') is given and prints one JSON line per variant." << std::endl;
+}
+}
+
+int main(const int argc, char* argv[]) {
+  try {
+    auto profile = Profile();
+    std::string profile_path = "-";
+    int iterations = 0;
+    int threads = 0;
+    std::string seed;
+    std::string rng_engine;
+    std::string target_error;
+    std::string trace_path;
+    bool stat_weights = false;
+
+    for (int i = 1; i < argc; i++) {
+      const std::string kArgument = argv[i];
+
+      if (kArgument == "-h" || kArgument == "--help") {
+        PrintUsage();
+        return 0;
+      }
+
+      if (kArgument == "--stat-weights") {
+        stat_weights = true;
+      } else if (kArgument == "--iterations" || kArgument == "--threads" || kArgument == "--seed" ||
+                 kArgument == "--rng" || kArgument == "--target-error" || kArgument == "--trace") {
+        if (i + 1 >= argc) {
+          throw std::invalid_argument(kArgument + " needs a value");
+        }
+
+        const std::string kValue = argv[++i];
+
+        if (kArgument == "--iterations") {
+          iterations = std::stoi(kValue);
+        } else if (kArgument == "--threads") {
+          threads = std::stoi(kValue);
+        } else if (kArgument == "--seed") {
+          seed = kValue;
+        } else if (kArgument == "--rng") {
+          rng_engine = kValue;
+        } else if (kArgument == "--trace") {
+          trace_path = kValue;
+        } else {
+          target_error = kValue;
+        }
+      } else if (kArgument.starts_with("--")) {
+        throw std::invalid_argument("unknown option " + kArgument);
+      } else {
+        profile_path = kArgument;
+      }
+    }
+
+    if (profile_path == "-") {
+      profile.Read(std::cin);
+    } else {
+      auto file = std::ifstream(profile_path);
+
+      if (!file) {
+        throw std::runtime_error("couldn't open " + profile_path);
+      }
+
+      profile.Read(file);
+    }
+
+    if (iterations > 0) {
+      profile.simulation_settings.iterations = iterations;
+    }
+
+    if (threads > 0) {
+      profile.simulation_settings.threads = threads;
+    }
+
+    if (!seed.empty()) {
+      profile.Set("simulation", "seed", seed);
+    }
+
+    if (!rng_engine.empty()) {
+      profile.Set("simulation", "rngEngine", rng_engine);
+    }
+
+    if (!target_error.empty()) {
+      profile.Set("simulation", "targetStandardError", target_error);
+    }
+
+    if (stat_weights) {
+      profile.simulation_settings.simulation_type = SimulationType::kStatWeights;
+    }
+
+    // The combat log that the trace is made from is only written when simulating the equipped items
+    if (!trace_path.empty()) {
+      if (!profile.variants.empty() || profile.simulation_settings.simulation_type == SimulationType::kStatWeights) {
+        throw std::invalid_argument("--trace can't be combined with variants or stat weights");
+      }
+
+      profile.player_settings.equipped_item_simulation = true;
+      profile.simulation_settings.chrome_trace = true;
+    }
+
+    if (profile.simulation_settings.iterations <= 0) {
+      throw std::invalid_argument("the amount of iterations needs to be above 0");
+    }
+
+    if (profile.simulation_settings.simulation_type == SimulationType::kStatWeights) {
+      if (!profile.variants.empty()) {
+        throw std::invalid_argument("stat weights can't be combined with variants");
+      }
+
+      // One line per stat
+      for (const auto& kWeight : CalculateStatWeights(profile.player_settings, profile.simulation_settings)) {
+        std::cout << "{\"stat\":\"" << kWeight.name << "\""
+            << ",\"amount\":" << DoubleToString(kWeight.amount)
+            << ",\"dpsDifference\":" << DoubleToString(kWeight.dps_difference, 4)
+            << ",\"weight\":" << DoubleToString(kWeight.weight, 4)
+            << ",\"confidenceInterval\":" << DoubleToString(kWeight.confidence_interval, 4)
+            << ",\"iterations\":" << kWeight.iterations
+            << ",\"seed\":" << profile.simulation_settings.seed << "}" << std::endl;
+      }
+
+      return 0;
+    }
+
+    auto batch = SimulationBatch(profile.player_settings, profile.simulation_settings);
+    batch.AddVariant(profile.GetBaseVariant());
+
+    for (const auto& kVariant : profile.variants) {
+      batch.AddVariant(kVariant);
+    }
+
+    // One line per variant, starting with the base profile
+    for (const auto& kResult : batch.Start()) {
+      std::cout << "{\"name\":\"" << EscapeJson(kResult.name) << "\""
+          << ",\"medianDps\":" << DoubleToString(kResult.median_dps, 4)
+          << ",\"minDps\":" << DoubleToString(kResult.min_dps, 4)
+          << ",\"maxDps\":" << DoubleToString(kResult.max_dps, 4)
+          << ",\"meanDps\":" << DoubleToString(kResult.mean_dps, 4)
+          << ",\"dpsStandardDeviation\":" << DoubleToString(kResult.dps_standard_deviation, 4)
+          << ",\"iterations\":" << kResult.iterations
+          << ",\"totalDuration\":" << DoubleToString(kResult.total_fight_duration)
+          << ",\"seed\":" << profile.simulation_settings.seed
+          << ",\"simulationDuration\":" << DoubleToString(kResult.simulation_duration, 3)
+          << ",\"rebuiltPlayer\":" << (kResult.rebuilt_player ? "true" : "false");
+
+      if constexpr (kProfiling) {
+        std::cout << ",\"profiling\":" << FormatProfilingCounters(kResult.profiling, kResult.iterations);
+      }
+
+      std::cout << "}" << std::endl;
+
+      if (!trace_path.empty()) {
+        auto trace_file = std::ofstream(trace_path);
+
+        if (!trace_file) {
+          throw std::runtime_error("couldn't write " + trace_path);
+        }
+
+        trace_file << kResult.chrome_trace;
+      }
+    }
+  } catch (const std::exception& kError) {
+    std::cerr << "warlock_sim: " << kError.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}